@@ -0,0 +1,331 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_BVH_2D_H
+#define KELO_GEOMETRY_COMMON_BVH_2D_H
+
+#include <cstdint>
+#include <vector>
+
+#include <geometry_common/Box2D.h>
+#include <geometry_common/LineSegment2D.h>
+#include <geometry_common/Polygon2D.h>
+#include <geometry_common/Polyline2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Node of a flattened bounding volume hierarchy. Nodes are stored in
+ * depth first order such that the left child of an internal node directly
+ * follows its parent. \n
+ * The struct is plain old data so that a hierarchy can be written to and read
+ * from a binary file as is.
+ *
+ */
+struct BVHNode2D
+{
+    float min_x, min_y, max_x, max_y;
+
+    /// index of first item for leaves, index of right child for internal nodes
+    uint32_t first;
+
+    /// number of items for leaves, 0 for internal nodes
+    uint32_t count;
+
+    inline bool isLeaf() const
+    {
+        return ( count > 0 );
+    }
+
+    inline bool containsPoint(const Point2D& point) const
+    {
+        return ( point.x >= min_x && point.x <= max_x &&
+                 point.y >= min_y && point.y <= max_y );
+    }
+
+    inline bool intersects(const Box2D& box) const
+    {
+        return ( box.min_x <= max_x && box.max_x >= min_x &&
+                 box.min_y <= max_y && box.max_y >= min_y );
+    }
+
+    inline float squaredDistTo(const Point2D& point) const
+    {
+        float dx = ( point.x < min_x ) ? min_x - point.x
+                 : ( point.x > max_x ) ? point.x - max_x : 0.0f;
+        float dy = ( point.y < min_y ) ? min_y - point.y
+                 : ( point.y > max_y ) ? point.y - max_y : 0.0f;
+        return dx * dx + dy * dy;
+    }
+
+    /**
+     * @brief Visit all the items of the leaves whose bounds pass a test.
+     *
+     * @param nodes flattened hierarchy (root at index 0)
+     * @param is_node_relevant callable `bool(const BVHNode2D&)` deciding if
+     * the subtree of a node needs to be visited
+     * @param visit callable `bool(size_t item)` called for the items of
+     * relevant leaves. Traversal stops as soon as it returns false.
+     * @return bool false if the traversal was stopped by visit, true otherwise
+     */
+    template <typename NodeTest, typename ItemVisitor>
+    static bool traverse(const BVHNode2D* nodes, size_t num_of_nodes,
+                         NodeTest is_node_relevant, ItemVisitor visit)
+    {
+        if ( num_of_nodes == 0 )
+        {
+            return true;
+        }
+
+        uint32_t stack[64];
+        size_t stack_size = 0;
+        stack[stack_size++] = 0;
+        while ( stack_size > 0 )
+        {
+            const BVHNode2D& node = nodes[stack[--stack_size]];
+            if ( !is_node_relevant(node) )
+            {
+                continue;
+            }
+
+            if ( node.isLeaf() )
+            {
+                for ( uint32_t i = node.first; i < node.first + node.count; i++ )
+                {
+                    if ( !visit(i) )
+                    {
+                        return false;
+                    }
+                }
+            }
+            else
+            {
+                stack[stack_size++] = node.first;
+                stack[stack_size++] = (&node - nodes) + 1;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Tolerance (in meters) used by BVH2D for point containment and
+ * bounding boxes of polylines and line segments
+ */
+const float BVH_CONTAINMENT_TOLERANCE = 1e-3f;
+
+/**
+ * @brief Static bounding volume hierarchy over axis aligned bounding boxes
+ * (Box2D) of 2D shapes. Supported shapes are Polygon2D, Polyline2D and
+ * LineSegment2D. \n \n
+ * The hierarchy is built in O(n log n) by recursively splitting the shapes at
+ * the median of their box centers along the longest axis. Nodes as well as
+ * shapes are stored in flat arrays in traversal order. Queries take
+ * O(log n + k) for k reported shapes. \n \n
+ * All queries report indices into the vector the hierarchy was built from.
+ *
+ * @tparam T type of shapes
+ */
+template <typename T>
+class BVH2D
+{
+    public:
+        using Ptr = std::shared_ptr<BVH2D<T>>;
+        using ConstPtr = std::shared_ptr<const BVH2D<T>>;
+
+        /**
+         * @brief Construct a BVH2D object from a collection of shapes
+         *
+         * @param shapes shapes to be indexed
+         * @param max_leaf_size maximum number of shapes in one leaf
+         */
+        BVH2D(const std::vector<T>& shapes = std::vector<T>(),
+              size_t max_leaf_size = 4);
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~BVH2D() {}
+
+        /**
+         * @brief (Re)build the hierarchy from a collection of shapes
+         *
+         * @param shapes shapes to be indexed
+         * @param max_leaf_size maximum number of shapes in one leaf
+         */
+        void build(const std::vector<T>& shapes, size_t max_leaf_size = 4);
+
+        /**
+         * @brief Check if any shape contains the point. For polygons this
+         * means that the point lies inside the polygon. For polylines and
+         * line segments the point needs to lie within 1 mm of the shape.
+         *
+         * @param point point to be checked
+         * @return bool True if at least one shape contains the point
+         */
+        bool containsPoint(const Point2D& point) const;
+
+        /**
+         * @brief Find all shapes containing a point (see containsPoint)
+         *
+         * @param point point to be checked
+         * @param indices indices of shapes containing the point. The vector is
+         * cleared first.
+         */
+        void calcIndicesContaining(
+                const Point2D& point,
+                std::vector<size_t>& indices) const;
+
+        /**
+         * @brief Check if any shape intersects a line segment. Semantics of
+         * the intersects method of the shapes is used i.e. for polygons only
+         * their boundary is considered.
+         *
+         * @param line_segment line segment to be checked
+         * @return bool True if at least one shape intersects the line segment
+         */
+        bool intersects(const LineSegment2D& line_segment) const;
+
+        /**
+         * @brief Find all shapes intersecting a line segment (see intersects)
+         *
+         * @param line_segment line segment to be checked
+         * @param indices indices of intersecting shapes. The vector is
+         * cleared first.
+         */
+        void calcIndicesIntersecting(
+                const LineSegment2D& line_segment,
+                std::vector<size_t>& indices) const;
+
+        /**
+         * @brief Find all shapes whose bounding box overlaps with a box
+         *
+         * @param box query box
+         * @param indices indices of shapes with overlapping bounding box. The
+         * vector is cleared first.
+         */
+        void calcIndicesOverlapping(
+                const Box2D& box,
+                std::vector<size_t>& indices) const;
+
+        /**
+         * @brief Find the shape closest to a point. Points inside a polygon
+         * are at distance 0 from it.
+         *
+         * @param point query point
+         * @param index index of the closest shape
+         * @param dist distance between point and the closest shape
+         * @return bool False if the hierarchy is empty or all shapes are
+         * empty (index and dist are not modified), true otherwise
+         */
+        bool calcNearest(
+                const Point2D& point,
+                size_t& index,
+                float& dist) const;
+
+        /**
+         * @brief Get the number of indexed shapes
+         *
+         * @return size_t number of shapes
+         */
+        inline size_t size() const
+        {
+            return shapes_.size();
+        }
+
+        /**
+         * @brief Get the shape that was at the given index while building
+         *
+         * @param index index of the shape in the input vector
+         * @return const T& the shape
+         */
+        const T& operator [] (size_t index) const;
+
+        /**
+         * @brief Get the flattened hierarchy
+         *
+         * @return const std::vector<BVHNode2D>& nodes in depth first order
+         */
+        inline const std::vector<BVHNode2D>& nodes() const
+        {
+            return nodes_;
+        }
+
+        /**
+         * @brief Get the input indices of the shapes in the order they are
+         * referred to by the leaves
+         *
+         * @return const std::vector<uint32_t>& input index of each leaf item
+         */
+        inline const std::vector<uint32_t>& itemIndices() const
+        {
+            return item_indices_;
+        }
+
+        /**
+         * @brief Calculate the bounding box of a shape as used by the
+         * hierarchy. Boxes of polylines and line segments are inflated by
+         * the 1 mm tolerance of containsPoint.
+         *
+         * @param shape shape whose bounding box is computed
+         * @return Box2D bounding box
+         */
+        static Box2D calcBoundingBox(const T& shape);
+
+    protected:
+        std::vector<BVHNode2D> nodes_;
+
+        /// shapes in the order they are referred to by the leaves
+        std::vector<T> shapes_;
+
+        /// input index of each shape in shapes_
+        std::vector<uint32_t> item_indices_;
+
+        /// position of each input shape in shapes_
+        std::vector<uint32_t> item_positions_;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_BVH_2D_H
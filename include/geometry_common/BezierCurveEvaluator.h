@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_BEZIER_CURVE_EVALUATOR_H
+#define KELO_GEOMETRY_COMMON_BEZIER_CURVE_EVALUATOR_H
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <geometry_common/Point2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Evaluates bezier spline curves at equally spaced interpolation
+ * factors using precomputed Bernstein basis matrices. \n \n
+ * The basis matrix for a given (order, number of points) pair is computed
+ * once with the numerically stable de Casteljau recurrence (no pow() calls
+ * and no binomial coefficients, hence no overflow for high orders) and then
+ * reused for every curve with the same pair. Evaluating a curve then is a
+ * plain matrix-vector product.
+ *
+ * @note Basis matrices are cached lazily from const member functions, so a
+ * single object must not be used concurrently from multiple threads.
+ *
+ */
+class BezierCurveEvaluator
+{
+    public:
+        using Ptr = std::shared_ptr<BezierCurveEvaluator>;
+        using ConstPtr = std::shared_ptr<const BezierCurveEvaluator>;
+
+        /**
+         * @brief default c-tor
+         */
+        BezierCurveEvaluator() {}
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~BezierCurveEvaluator() {}
+
+        /**
+         * @brief Calculate an entire bezier spline curve for given control
+         * points. Equivalent to Utils::calcSplineCurvePoints().
+         *
+         * @param control_points control points to generate spline curve from
+         * @param num_of_points number of points to populate the spline curve
+         * with
+         * @param curve_points spline curve (empty if less than 2 control
+         * points or less than 2 curve points are requested)
+         */
+        void calcCurvePoints(
+                const PointVec2D& control_points,
+                size_t num_of_points,
+                PointVec2D& curve_points) const;
+
+        /**
+         * @brief Calculate bezier spline curves for many sets of control
+         * points in one call. Sets of control points may have different
+         * orders.
+         *
+         * @param control_points_list sets of control points
+         * @param num_of_points number of points to populate each spline curve
+         * with
+         * @param curves spline curve for each set of control points
+         */
+        void calcCurvePoints(
+                const std::vector<PointVec2D>& control_points_list,
+                size_t num_of_points,
+                std::vector<PointVec2D>& curves) const;
+
+        /**
+         * @brief Get the Bernstein basis matrix for a given order and number
+         * of curve points. Row `j` holds the weights of all `order + 1`
+         * control points for the j-th curve point.
+         *
+         * @param order order of the curve (number of control points - 1)
+         * @param num_of_points number of curve points (at least 2)
+         * @return const std::vector<float>& row major basis matrix of size
+         * num_of_points * (order + 1)
+         */
+        const std::vector<float>& basis(size_t order, size_t num_of_points) const;
+
+        /**
+         * @brief Remove all cached basis matrices
+         *
+         */
+        void clearCache();
+
+    protected:
+        mutable std::map<std::pair<size_t, size_t>, std::vector<float>> basis_cache_;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_BEZIER_CURVE_EVALUATOR_H
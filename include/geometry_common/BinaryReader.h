@@ -0,0 +1,200 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_BINARY_READER_H
+#define KELO_GEOMETRY_COMMON_BINARY_READER_H
+
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+#include <geometry_common/BinaryWriter.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Decoder for data written by BinaryWriter. Reads from any
+ * std::istream or from a memory buffer.
+ * \n \n
+ * Each read overload returns false if the data is truncated or malformed, in
+ * which case the reader stops consuming input and good() returns false.
+ * Reading into an existing container reuses its capacity.
+ */
+class BinaryReader
+{
+    public:
+        using Ptr = std::shared_ptr<BinaryReader>;
+        using ConstPtr = std::shared_ptr<const BinaryReader>;
+
+        /**
+         * @brief Read from a stream (e.g. std::ifstream opened in binary mode)
+         *
+         * @param stream input stream which must outlive the reader
+         */
+        explicit BinaryReader(std::istream& stream);
+
+        /**
+         * @brief Read from a memory buffer
+         *
+         * @param data pointer to first byte; must outlive the reader
+         * @param size number of bytes in buffer
+         */
+        BinaryReader(const uint8_t* data, size_t size);
+
+        /**
+         * @brief Read from a memory buffer
+         *
+         * @param buffer buffer which must outlive the reader
+         */
+        explicit BinaryReader(const std::vector<uint8_t>& buffer);
+
+        virtual ~BinaryReader() = default;
+
+        /**
+         * @brief Read and validate magic bytes and format version written by
+         * BinaryWriter::writeHeader()
+         *
+         * @return bool true if header is valid and its version is supported;
+         * false otherwise
+         */
+        bool readHeader();
+
+        bool read(uint32_t& value);
+
+        bool read(float& value);
+
+        bool read(Point2D& point);
+
+        bool read(Point3D& point);
+
+        bool read(XYTheta& x_y_theta);
+
+        bool read(Pose2D& pose);
+
+        bool read(Circle& circle);
+
+        bool read(LineSegment2D& line_segment);
+
+        bool read(Box2D& box);
+
+        bool read(Box3D& box);
+
+        bool read(Polyline2D& polyline);
+
+        bool read(Polygon2D& polygon);
+
+        bool read(PolygonWithHoles2D& polygon_with_holes);
+
+        bool read(TransformMatrix2D& tf_mat);
+
+        bool read(TransformMatrix3D& tf_mat);
+
+        /**
+         * @brief Read a PointCloud2D in any CloudEncoding
+         *
+         * @param cloud output cloud (overwritten)
+         * @return bool true if successful; false otherwise
+         */
+        bool read(PointCloud2D& cloud);
+
+        /**
+         * @brief Read a PointCloud3D in any CloudEncoding
+         *
+         * @param cloud output cloud (overwritten)
+         * @return bool true if successful; false otherwise
+         */
+        bool read(PointCloud3D& cloud);
+
+        /**
+         * @brief Read a collection written by BinaryWriter::write(const std::vector<T>&)
+         *
+         * @tparam T Pose2D, XYTheta, Circle, LineSegment2D, Box2D, Box3D,
+         * Polyline2D, Polygon2D or PolygonWithHoles2D
+         * @param values output collection (overwritten)
+         * @return bool true if successful; false otherwise
+         */
+        template <typename T>
+        bool read(std::vector<T>& values);
+
+        /**
+         * @brief
+         *
+         * @return bool false if any read failed
+         */
+        bool good() const;
+
+        /**
+         * @brief
+         *
+         * @return uint16_t format version read by readHeader(); 0 if no header
+         * was read
+         */
+        uint16_t version() const;
+
+        /**
+         * @brief
+         *
+         * @return size_t number of bytes read since construction
+         */
+        size_t bytesRead() const;
+
+    protected:
+        std::istream* stream_{nullptr};
+        const uint8_t* data_{nullptr};
+        size_t size_{0};
+        size_t bytes_read_{0};
+        uint16_t version_{0};
+        bool is_good_{true};
+
+        bool readBytes(uint8_t* bytes, size_t size);
+
+        bool canRead(size_t size) const;
+
+        template <typename T>
+        bool readCloud(std::vector<T>& cloud);
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_BINARY_READER_H
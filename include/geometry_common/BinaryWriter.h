@@ -0,0 +1,230 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_BINARY_WRITER_H
+#define KELO_GEOMETRY_COMMON_BINARY_WRITER_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include <geometry_common/Enums.h>
+#include <geometry_common/Point3D.h>
+#include <geometry_common/Pose2D.h>
+#include <geometry_common/Circle.h>
+#include <geometry_common/Box2D.h>
+#include <geometry_common/Box3D.h>
+#include <geometry_common/LineSegment2D.h>
+#include <geometry_common/Polygon2D.h>
+#include <geometry_common/PolygonWithHoles2D.h>
+#include <geometry_common/TransformMatrix2D.h>
+#include <geometry_common/TransformMatrix3D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Compact, versioned binary encoding of geometry_common types. The
+ * counterpart for decoding is BinaryReader.
+ * \n \n
+ * All values are stored little-endian regardless of the host. Floats are
+ * stored as IEEE 754 float32, counts as uint32. Composite types are stored as
+ * the concatenation of their members (e.g. LineSegment2D is start followed by
+ * end) and containers as a count followed by their elements. Point clouds
+ * (and thus Polyline2D/Polygon2D vertices) additionally start with a
+ * CloudEncoding byte and may be compressed to float16 or to 16 bit
+ * coordinates quantised to a fixed resolution.
+ * \n \n
+ * Data can be written to any std::ostream or appended to a memory buffer.
+ * Point clouds are packed through a fixed size stack buffer so no
+ * intermediate allocations are made.
+ */
+class BinaryWriter
+{
+    public:
+        using Ptr = std::shared_ptr<BinaryWriter>;
+        using ConstPtr = std::shared_ptr<const BinaryWriter>;
+
+        /**
+         * @brief Format version written by writeHeader()
+         */
+        static const uint16_t VERSION = 1;
+
+        /**
+         * @brief Magic bytes written by writeHeader()
+         */
+        static const uint8_t MAGIC[4];
+
+        /**
+         * @brief Write to a stream (e.g. std::ofstream opened in binary mode)
+         *
+         * @param stream output stream which must outlive the writer
+         */
+        explicit BinaryWriter(std::ostream& stream);
+
+        /**
+         * @brief Append to a memory buffer
+         *
+         * @param buffer output buffer which must outlive the writer
+         */
+        explicit BinaryWriter(std::vector<uint8_t>& buffer);
+
+        virtual ~BinaryWriter() = default;
+
+        /**
+         * @brief Write magic bytes and format version. Should be written once
+         * at the start of a file so that BinaryReader::readHeader can
+         * validate it.
+         *
+         * @return bool true if successful; false otherwise
+         */
+        bool writeHeader();
+
+        bool write(uint32_t value);
+
+        bool write(float value);
+
+        bool write(const Point2D& point);
+
+        bool write(const Point3D& point);
+
+        bool write(const XYTheta& x_y_theta);
+
+        bool write(const Pose2D& pose);
+
+        bool write(const Circle& circle);
+
+        bool write(const LineSegment2D& line_segment);
+
+        bool write(const Box2D& box);
+
+        bool write(const Box3D& box);
+
+        bool write(const Polyline2D& polyline);
+
+        bool write(const Polygon2D& polygon);
+
+        bool write(const PolygonWithHoles2D& polygon_with_holes);
+
+        /**
+         * @brief Write a transformation matrix as x, y and theta
+         */
+        bool write(const TransformMatrix2D& tf_mat);
+
+        /**
+         * @brief Write a transformation matrix as x, y, z, qx, qy, qz and qw
+         */
+        bool write(const TransformMatrix3D& tf_mat);
+
+        /**
+         * @brief Write a PointCloud2D (or PointVec2D)
+         *
+         * @param cloud points to be written
+         * @param encoding encoding of coordinates. FLOAT16 keeps 11
+         * significant bits. QUANTISED_INT16 stores coordinates relative to
+         * the minimum of the cloud in multiples of resolution; if the cloud
+         * does not fit in 65536 steps (or contains non finite values) FLOAT32
+         * is used instead.
+         * @param resolution step size for QUANTISED_INT16 encoding
+         * @return bool true if successful; false otherwise
+         */
+        bool write(
+                const PointCloud2D& cloud,
+                CloudEncoding encoding = CloudEncoding::FLOAT32,
+                float resolution = 0.001f);
+
+        /**
+         * @brief Write a PointCloud3D (or PointVec3D)
+         *
+         * @see write(const PointCloud2D&, CloudEncoding, float)
+         */
+        bool write(
+                const PointCloud3D& cloud,
+                CloudEncoding encoding = CloudEncoding::FLOAT32,
+                float resolution = 0.001f);
+
+        /**
+         * @brief Write a collection as a count followed by its elements
+         *
+         * @tparam T Pose2D, XYTheta, Circle, LineSegment2D, Box2D, Box3D,
+         * Polyline2D, Polygon2D or PolygonWithHoles2D
+         * @param values collection to be written
+         * @return bool true if successful; false otherwise
+         */
+        template <typename T>
+        bool write(const std::vector<T>& values);
+
+        /**
+         * @brief
+         *
+         * @return bool false if any write to the underlying stream failed
+         */
+        bool good() const;
+
+        /**
+         * @brief
+         *
+         * @return size_t number of bytes written since construction
+         */
+        size_t bytesWritten() const;
+
+    protected:
+        std::ostream* stream_{nullptr};
+        std::vector<uint8_t>* buffer_{nullptr};
+        size_t bytes_written_{0};
+        bool is_good_{true};
+
+        void writeBytes(const uint8_t* bytes, size_t size);
+
+        void reserve(size_t size);
+
+        template <typename T>
+        bool writeCloud(
+                const std::vector<T>& cloud,
+                CloudEncoding encoding,
+                float resolution);
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_BINARY_WRITER_H
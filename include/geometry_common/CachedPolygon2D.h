@@ -0,0 +1,271 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_CACHED_POLYGON_2D_H
+#define KELO_GEOMETRY_COMMON_CACHED_POLYGON_2D_H
+
+#include <geometry_common/Enums.h>
+#include <geometry_common/Box2D.h>
+#include <geometry_common/Polygon2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Polygon2D wrapper that lazily computes and memoises derived
+ * quantities (bounding box, signed area, centroid, mean point, winding order
+ * and convexity). Useful for polygons which are queried repeatedly but
+ * rarely modified, e.g. static zones of a map. \n \n
+ * The vertices can only be modified through updatePolygon() and
+ * setVertex(), which invalidate all cached values.
+ *
+ * @note The lazy evaluation modifies internal state from const member
+ * functions, so a single object must not be queried concurrently from
+ * multiple threads.
+ *
+ */
+class CachedPolygon2D
+{
+    public:
+        using Ptr = std::shared_ptr<CachedPolygon2D>;
+        using ConstPtr = std::shared_ptr<const CachedPolygon2D>;
+
+        /**
+         * @brief Construct a new empty CachedPolygon2D object
+         *
+         */
+        CachedPolygon2D() = default;
+
+        /**
+         * @brief Construct a new CachedPolygon2D object
+         *
+         * @param polygon polygon to be wrapped
+         */
+        CachedPolygon2D(const Polygon2D& polygon):
+            polygon_(polygon) {}
+
+        /**
+         * @brief Construct a new CachedPolygon2D object from a vector of 2D
+         * points
+         *
+         * @param vertices An ordered vector of 2D points representing the
+         * vertices of the polygon
+         */
+        CachedPolygon2D(const PointVec2D& vertices):
+            polygon_(vertices) {}
+
+        /**
+         * @brief Destroy the CachedPolygon2D object
+         *
+         */
+        virtual ~CachedPolygon2D() {}
+
+        /**
+         * @brief Get the wrapped polygon
+         *
+         * @return const Polygon2D& wrapped polygon
+         */
+        inline const Polygon2D& polygon() const
+        {
+            return polygon_;
+        }
+
+        /**
+         * @brief Replace the wrapped polygon and invalidate all cached values
+         *
+         * @param polygon new polygon
+         */
+        void updatePolygon(const Polygon2D& polygon);
+
+        /**
+         * @brief Get the vertices of the polygon
+         *
+         * @return const PointVec2D& vertices of the polygon
+         */
+        inline const PointVec2D& vertices() const
+        {
+            return polygon_.vertices;
+        }
+
+        /**
+         * @brief Get the number of vertices of the polygon
+         *
+         * @return size_t number of vertices
+         */
+        inline size_t size() const
+        {
+            return polygon_.size();
+        }
+
+        /**
+         * @brief Get a vertex of the polygon
+         *
+         * @param index index of the vertex
+         * @return const Point2D& vertex at index
+         */
+        inline const Point2D& operator [] (unsigned int index) const
+        {
+            return polygon_[index];
+        }
+
+        /**
+         * @brief Replace a vertex of the polygon and invalidate all cached
+         * values
+         *
+         * @param index index of the vertex
+         * @param vertex new vertex
+         */
+        void setVertex(unsigned int index, const Point2D& vertex);
+
+        /**
+         * @brief Get the axis aligned bounding box of the polygon
+         *
+         * @return const Box2D& bounding box
+         */
+        const Box2D& boundingBox() const;
+
+        /**
+         * @brief Get the signed area of the polygon (see Polygon2D::area())
+         *
+         * @return float signed area
+         */
+        float area() const;
+
+        /**
+         * @brief Get the centroid of the polygon (see Polygon2D::centroid())
+         *
+         * @return const Point2D& centroid
+         */
+        const Point2D& centroid() const;
+
+        /**
+         * @brief Get the mean of all the polygon vertices
+         *
+         * @return const Point2D& mean point
+         */
+        const Point2D& meanPoint() const;
+
+        /**
+         * @brief Get the winding order of the polygon derived from the sign
+         * of its area
+         *
+         * @return WindingOrder COUNTER_CLOCKWISE for positive area, CLOCKWISE
+         * for negative area and COLLINEAR for zero area
+         */
+        WindingOrder windingOrder() const;
+
+        /**
+         * @brief Check if the polygon is convex (see Polygon2D::isConvex())
+         *
+         * @return bool True if polygon is convex, false otherwise
+         */
+        bool isConvex() const;
+
+        /**
+         * @brief Check if a 2D point lies within the polygon. Points outside
+         * of the bounding box are rejected without walking the edges.
+         *
+         * @param point The 2D point to be checked
+         * @return bool True if the point lies inside the polygon, false otherwise
+         */
+        bool containsPoint(const Point2D& point) const;
+
+        /**
+         * @brief Check if atleast one of the input points lies within the
+         * polygon
+         *
+         * @param points A vector of points to be checked
+         * @return bool True if even one of the points lies inside the polygon,
+         * false otherwise
+         */
+        bool containsAnyPoint(const PointVec2D& points) const;
+
+        /**
+         * @brief Checks if the polygon boundary and a 2D line segment
+         * intersect. Line segments whose bounding box does not overlap with
+         * the bounding box of the polygon are rejected without walking the
+         * edges.
+         *
+         * @param line_segment The 2D line segment to be checked for intersection
+         * @return bool True if they intersect at atleast one point, false
+         * otherwise
+         */
+        bool intersects(const LineSegment2D& line_segment) const;
+
+        /**
+         * @brief Append the polygon information as string to the input stream object
+         *
+         * @param out The stream object to which the information should be appended
+         * @param polygon The polygon whose data should be appended to the stream object
+         * @return std::ostream& The stream object representing the concatenation
+         * of the input stream and the polygon information
+         */
+        friend std::ostream& operator << (
+                std::ostream& out,
+                const CachedPolygon2D& polygon);
+
+    protected:
+        Polygon2D polygon_;
+
+        /**
+         * @brief Invalidate all cached values
+         *
+         */
+        void invalidateCache();
+
+        mutable Box2D bounding_box_;
+        mutable float area_{0.0f};
+        mutable Point2D centroid_;
+        mutable Point2D mean_point_;
+        mutable bool is_convex_{false};
+
+        mutable bool is_bounding_box_valid_{false};
+        mutable bool is_area_valid_{false};
+        mutable bool is_centroid_valid_{false};
+        mutable bool is_mean_point_valid_{false};
+        mutable bool is_convexity_valid_{false};
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_CACHED_POLYGON_2D_H
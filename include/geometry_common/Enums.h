@@ -91,6 +91,92 @@ inline WindingOrder asWindingOrder(const std::string& winding_order_string)
     return winding_order;
 };
 
+/**
+ * @brief Boolean set operation performed between a subject and a clipping
+ * polygon
+ *
+ */
+enum class BooleanOperation
+{
+    INVALID = 0,
+    INTERSECTION,
+    UNION,
+    DIFFERENCE,
+    XOR
+};
+
+const std::vector<std::string> boolean_operation_strings = {
+    "INVALID",
+    "INTERSECTION",
+    "UNION",
+    "DIFFERENCE",
+    "XOR",
+};
+
+inline std::string asString(const BooleanOperation& boolean_operation)
+{
+    size_t boolean_operation_int = static_cast<size_t>(boolean_operation);
+    return ( boolean_operation_int >= boolean_operation_strings.size() )
+           ? boolean_operation_strings[0]
+           : boolean_operation_strings[boolean_operation_int];
+};
+
+inline BooleanOperation asBooleanOperation(const std::string& boolean_operation_string)
+{
+    BooleanOperation boolean_operation = BooleanOperation::INVALID;
+    for ( size_t i = 0; i < boolean_operation_strings.size(); i++ )
+    {
+        if ( boolean_operation_strings[i] == boolean_operation_string )
+        {
+            boolean_operation = static_cast<BooleanOperation>(i);
+            break;
+        }
+    }
+    return boolean_operation;
+};
+
+/**
+ * @brief Encoding of point coordinates used when serialising point clouds
+ * with BinaryWriter
+ *
+ */
+enum class CloudEncoding
+{
+    INVALID = 0,
+    FLOAT32,
+    FLOAT16,
+    QUANTISED_INT16
+};
+
+const std::vector<std::string> cloud_encoding_strings = {
+    "INVALID",
+    "FLOAT32",
+    "FLOAT16",
+    "QUANTISED_INT16",
+};
+
+inline std::string asString(const CloudEncoding& cloud_encoding)
+{
+    size_t cloud_encoding_int = static_cast<size_t>(cloud_encoding);
+    return ( cloud_encoding_int >= cloud_encoding_strings.size() )
+           ? cloud_encoding_strings[0]
+           : cloud_encoding_strings[cloud_encoding_int];
+};
+
+inline CloudEncoding asCloudEncoding(const std::string& cloud_encoding_string)
+{
+    CloudEncoding cloud_encoding = CloudEncoding::INVALID;
+    for ( size_t i = 0; i < cloud_encoding_strings.size(); i++ )
+    {
+        if ( cloud_encoding_strings[i] == cloud_encoding_string )
+        {
+            cloud_encoding = static_cast<CloudEncoding>(i);
+            break;
+        }
+    }
+    return cloud_encoding;
+};
+
 } // namespace geometry_common
 } // namespace kelo
 #endif // KELO_GEOMETRY_COMMON_ENUMS_H
@@ -0,0 +1,233 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_INSTRUMENTATION_H
+#define KELO_GEOMETRY_COMMON_INSTRUMENTATION_H
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Accumulated measurements of one probe over all threads
+ *
+ */
+struct ProbeSnapshot
+{
+    std::string name;
+    uint64_t num_of_calls{0};
+    uint64_t num_of_elements{0};
+    uint64_t total_latency_ns{0};
+    uint64_t max_latency_ns{0};
+
+    /// number of calls per latency bucket (see Instrumentation::calcBucketIndex)
+    std::vector<uint64_t> latency_histogram;
+
+    /**
+     * @brief
+     *
+     * @return float mean latency in nanoseconds; 0 if there were no calls
+     */
+    float calcMeanLatency() const;
+
+    /**
+     * @brief Estimate a latency percentile from the histogram. The result
+     * overestimates the true value by at most one bucket width (12.5%).
+     *
+     * @param percentile percentile in [0, 100]
+     * @return uint64_t latency in nanoseconds; 0 if there were no calls
+     */
+    uint64_t calcPercentileLatency(float percentile) const;
+
+    friend std::ostream& operator << (
+            std::ostream& out,
+            const ProbeSnapshot& snapshot);
+};
+
+/**
+ * @brief Registry of latency probes of the heavy entry points of this
+ * library. \n \n
+ * Each thread records into its own buffers without locks; takeSnapshot()
+ * merges the buffers of all threads. The buffers of a thread are folded into
+ * a shared one when it exits. Latencies are kept in a log-linear
+ * (HDR style) histogram with 8 buckets per power of two. \n \n
+ * The probes inside the library are only compiled in when it is built with
+ * the CMake option `GEOMETRY_COMMON_ENABLE_INSTRUMENTATION`; otherwise
+ * GEOMETRY_COMMON_PROFILE_SCOPE expands to nothing and snapshots stay empty.
+ */
+class Instrumentation
+{
+    public:
+        static const size_t MAX_NUM_OF_PROBES;
+        static const size_t NUM_OF_BUCKETS;
+
+        /**
+         * @brief
+         *
+         * @return bool true if the library was built with instrumentation;
+         * false otherwise
+         */
+        static bool isEnabled();
+
+        /**
+         * @brief Get the id of a probe, registering it if needed. Called once
+         * per call site by GEOMETRY_COMMON_PROFILE_SCOPE.
+         *
+         * @param name name of the probe
+         * @return size_t id of the probe; MAX_NUM_OF_PROBES if no more probes
+         * can be registered (recording for it is ignored)
+         */
+        static size_t registerProbe(const std::string& name);
+
+        /**
+         * @brief Record one call of a probe for the calling thread
+         *
+         * @param probe_id id returned by registerProbe
+         * @param latency_ns latency of the call in nanoseconds
+         * @param num_of_elements number of elements processed by the call
+         */
+        static void record(
+                size_t probe_id,
+                uint64_t latency_ns,
+                size_t num_of_elements);
+
+        /**
+         * @brief Merge the measurements of all threads. Counters are
+         * cumulative since start up; compare two snapshots to get rates.
+         *
+         * @return std::vector<ProbeSnapshot> one entry per probe that was
+         * called at least once
+         */
+        static std::vector<ProbeSnapshot> takeSnapshot();
+
+        /**
+         * @brief Convert snapshots to key value pairs, e.g. to fill the
+         * `values` of a `diagnostic_msgs::DiagnosticStatus`
+         *
+         * @param snapshots snapshots to be converted
+         * @return std::vector<std::pair<std::string, std::string>> pairs of
+         * "<probe name>/<quantity>" and value
+         */
+        static std::vector<std::pair<std::string, std::string>> convertToKeyValues(
+                const std::vector<ProbeSnapshot>& snapshots);
+
+        /**
+         * @brief
+         *
+         * @param latency_ns latency in nanoseconds
+         * @return size_t index of histogram bucket containing latency_ns
+         */
+        static size_t calcBucketIndex(uint64_t latency_ns);
+
+        /**
+         * @brief
+         *
+         * @param bucket_index index of histogram bucket
+         * @return uint64_t largest latency in nanoseconds of the bucket
+         */
+        static uint64_t calcBucketUpperBound(size_t bucket_index);
+
+};
+
+/**
+ * @brief Measures the time until it goes out of scope and records it for a
+ * probe
+ *
+ */
+class ProfileScope
+{
+    public:
+        ProfileScope(size_t probe_id, size_t num_of_elements = 0):
+            probe_id_(probe_id),
+            num_of_elements_(num_of_elements),
+            start_time_(std::chrono::steady_clock::now()) {}
+
+        ProfileScope(const ProfileScope&) = delete;
+
+        ProfileScope& operator = (const ProfileScope&) = delete;
+
+        ~ProfileScope()
+        {
+            const std::chrono::steady_clock::duration latency =
+                std::chrono::steady_clock::now() - start_time_;
+            Instrumentation::record(
+                    probe_id_,
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count(),
+                    num_of_elements_);
+        }
+
+    protected:
+        size_t probe_id_;
+        size_t num_of_elements_;
+        std::chrono::steady_clock::time_point start_time_;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+
+#define GEOMETRY_COMMON_CONCAT_IMPL(a, b) a##b
+#define GEOMETRY_COMMON_CONCAT(a, b) GEOMETRY_COMMON_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Record latency and element count of the enclosing scope under the
+ * given probe name. Compiled out unless
+ * GEOMETRY_COMMON_ENABLE_INSTRUMENTATION is defined.
+ */
+#ifdef GEOMETRY_COMMON_ENABLE_INSTRUMENTATION
+#define GEOMETRY_COMMON_PROFILE_SCOPE(name, num_of_elements) \
+    static const size_t GEOMETRY_COMMON_CONCAT(geometry_common_probe_id_, __LINE__) = \
+        ::kelo::geometry_common::Instrumentation::registerProbe(name); \
+    ::kelo::geometry_common::ProfileScope GEOMETRY_COMMON_CONCAT(geometry_common_profile_scope_, __LINE__)( \
+            GEOMETRY_COMMON_CONCAT(geometry_common_probe_id_, __LINE__), num_of_elements)
+#else
+#define GEOMETRY_COMMON_PROFILE_SCOPE(name, num_of_elements) \
+    do {} while ( false )
+#endif
+
+#endif // KELO_GEOMETRY_COMMON_INSTRUMENTATION_H
@@ -0,0 +1,228 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_KD_TREE_H
+#define KELO_GEOMETRY_COMMON_KD_TREE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <geometry_common/Point2D.h>
+#include <geometry_common/Point3D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Node of a flattened KD-tree. Nodes are stored in depth first order
+ * such that the left child of an internal node directly follows its parent.
+ *
+ */
+struct KDTreeNode
+{
+    /// coordinate of the splitting plane (internal nodes only)
+    float split;
+
+    /// axis of the splitting plane (internal nodes only)
+    uint32_t axis;
+
+    /// index of first point for leaves, index of right child for internal nodes
+    uint32_t first;
+
+    /// number of points for leaves, 0 for internal nodes
+    uint32_t count;
+
+    inline bool isLeaf() const
+    {
+        return ( count > 0 );
+    }
+};
+
+/**
+ * @brief Static KD-tree over 2D or 3D points for nearest neighbour, k nearest
+ * neighbours and radius queries. \n \n
+ * The tree is built in O(n log n) by recursively splitting the points at the
+ * median along the axis with the largest spread. Nodes as well as points are
+ * stored in flat arrays in traversal order so that the points of a leaf are
+ * contiguous in memory. A nearest neighbour query takes O(log n) on average
+ * compared to the O(n) of Utils::calcClosestPoint. \n \n
+ * All queries report indices into the vector the tree was built from and
+ * squared distances.
+ *
+ * @tparam T Point2D or Point3D
+ */
+template <typename T>
+class KDTree
+{
+    public:
+        using Ptr = std::shared_ptr<KDTree<T>>;
+        using ConstPtr = std::shared_ptr<const KDTree<T>>;
+
+        /**
+         * @brief Construct a KDTree object from a collection of points
+         *
+         * @param points points to be indexed
+         * @param max_leaf_size maximum number of points in one leaf
+         */
+        KDTree(const std::vector<T>& points = std::vector<T>(),
+               size_t max_leaf_size = 8);
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~KDTree() {}
+
+        /**
+         * @brief (Re)build the tree from a collection of points
+         *
+         * @param points points to be indexed
+         * @param max_leaf_size maximum number of points in one leaf
+         */
+        void build(const std::vector<T>& points, size_t max_leaf_size = 8);
+
+        /**
+         * @brief Find the point closest to a query point
+         *
+         * @param point query point
+         * @param index index of the closest point
+         * @param squared_dist squared distance to the closest point
+         * @return bool False if the tree is empty, true otherwise
+         */
+        bool calcNearestNeighbour(
+                const T& point,
+                size_t& index,
+                float& squared_dist) const;
+
+        /**
+         * @brief Find the closest point for each of the query points. Queries
+         * which are close to each other (e.g. consecutive points of a scan)
+         * are faster since each search starts with the result of the previous
+         * query as an upper bound.
+         *
+         * @param points query points
+         * @param indices index of the closest point for each query point
+         * @param squared_dists squared distance to the closest point for each
+         * query point
+         * @return bool False if the tree is empty, true otherwise
+         */
+        bool calcNearestNeighbours(
+                const std::vector<T>& points,
+                std::vector<size_t>& indices,
+                std::vector<float>& squared_dists) const;
+
+        /**
+         * @brief Find the k points closest to a query point
+         *
+         * @param point query point
+         * @param k number of points to find
+         * @param indices indices of at most k closest points sorted by
+         * increasing distance. The vector is cleared first.
+         * @param squared_dists squared distances corresponding to indices
+         */
+        void calcKNearestNeighbours(
+                const T& point,
+                size_t k,
+                std::vector<size_t>& indices,
+                std::vector<float>& squared_dists) const;
+
+        /**
+         * @brief Find all points within a radius around a query point
+         *
+         * @param point query point
+         * @param radius maximum distance (inclusive)
+         * @param indices indices of the points within radius in no particular
+         * order. The vector is cleared first.
+         */
+        void calcNeighboursWithinRadius(
+                const T& point,
+                float radius,
+                std::vector<size_t>& indices) const;
+
+        /**
+         * @brief Get the number of indexed points
+         *
+         * @return size_t number of points
+         */
+        inline size_t size() const
+        {
+            return points_.size();
+        }
+
+        /**
+         * @brief Get the point that was at the given index while building
+         *
+         * @param index index of the point in the input vector
+         * @return const T& the point
+         */
+        const T& operator [] (size_t index) const;
+
+        /**
+         * @brief Get the flattened tree
+         *
+         * @return const std::vector<KDTreeNode>& nodes in depth first order
+         */
+        inline const std::vector<KDTreeNode>& nodes() const
+        {
+            return nodes_;
+        }
+
+    protected:
+        std::vector<KDTreeNode> nodes_;
+
+        /// points in the order they are referred to by the leaves
+        std::vector<T> points_;
+
+        /// input index of each point in points_
+        std::vector<uint32_t> item_indices_;
+
+        /// position of each input point in points_
+        std::vector<uint32_t> item_positions_;
+
+};
+
+using KDTree2D = KDTree<Point2D>;
+using KDTree3D = KDTree<Point3D>;
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_KD_TREE_H
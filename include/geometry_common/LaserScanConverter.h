@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_LASER_SCAN_CONVERTER_H
+#define KELO_GEOMETRY_COMMON_LASER_SCAN_CONVERTER_H
+
+#include <memory>
+#include <vector>
+
+#include <sensor_msgs/LaserScan.h>
+
+#include <geometry_common/Point2D.h>
+#include <geometry_common/Point3D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Converts sensor_msgs::LaserScan messages of a sensor to point
+ * clouds. \n \n
+ * Equivalent to Utils::convertToPointCloud but meant to be kept alive
+ * for a sensor:
+ *  - cosine and sine of the beam angles are cached and only recomputed when
+ *    angle_min, angle_increment or the number of beams change,
+ *  - beams are projected in a loop without branches (vectorised by the
+ *    compiler) and invalid ranges are filtered afterwards without branching,
+ *  - output containers are overwritten, so their memory is reused when the
+ *    same containers are passed for every scan.
+ *
+ * @note A single object must not be used concurrently from multiple threads.
+ *
+ */
+class LaserScanConverter
+{
+    public:
+        using Ptr = std::shared_ptr<LaserScanConverter>;
+        using ConstPtr = std::shared_ptr<const LaserScanConverter>;
+
+        /**
+         * @brief default c-tor
+         */
+        LaserScanConverter() {}
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~LaserScanConverter() {}
+
+        /**
+         * @brief Convert a scan to a 2D point cloud. Beams with NaN or
+         * infinite ranges or ranges outside of (range_min, range_max) are
+         * skipped.
+         *
+         * @param scan laser scan message
+         * @param cloud converted points (overwritten)
+         */
+        void convert(const sensor_msgs::LaserScan& scan, PointCloud2D& cloud);
+
+        /**
+         * @brief Convert a scan to a 3D point cloud with z = 0
+         *
+         * @param scan laser scan message
+         * @param cloud converted points (overwritten)
+         */
+        void convert(const sensor_msgs::LaserScan& scan, PointCloud3D& cloud);
+
+        /**
+         * @brief Convert a scan to separate arrays of coordinates
+         *
+         * @param scan laser scan message
+         * @param xs X coordinates of the converted points (overwritten)
+         * @param ys Y coordinates of the converted points (overwritten)
+         * @param beam_indices index of the beam of each point (overwritten)
+         */
+        void convert(
+                const sensor_msgs::LaserScan& scan,
+                std::vector<float>& xs,
+                std::vector<float>& ys,
+                std::vector<size_t>& beam_indices);
+
+    protected:
+        float cached_angle_min_{0.0f};
+        float cached_angle_increment_{0.0f};
+        std::vector<float> cos_table_;
+        std::vector<float> sin_table_;
+
+        /// coordinates of all beams (including invalid ones) of the last scan
+        std::vector<float> beam_xs_;
+        std::vector<float> beam_ys_;
+
+        void updateDirectionTable(
+                float angle_min,
+                float angle_increment,
+                size_t num_of_beams);
+
+        /**
+         * @brief Project all beams of the scan into beam_xs_ and beam_ys_
+         *
+         * @param scan laser scan message
+         */
+        void projectBeams(const sensor_msgs::LaserScan& scan);
+
+        static inline bool isRangeValid(
+                float range,
+                const sensor_msgs::LaserScan& scan)
+        {
+            // false for NaN; infinity is excluded by the comparison with the
+            // (finite) range_max
+            return ( range > scan.range_min && range < scan.range_max );
+        }
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_LASER_SCAN_CONVERTER_H
@@ -0,0 +1,179 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_LINE_SEGMENT_MERGER_H
+#define KELO_GEOMETRY_COMMON_LINE_SEGMENT_MERGER_H
+
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <geometry_common/LineSegment2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Merges line segments whose endpoints are close to each other and
+ * whose orientation is similar. Produces the same result as the quadratic
+ * implementations in Utils (mergeCloseLinesBF and mergeCoLinearLines) but
+ * only tests pairs of segments whose endpoints lie in neighbouring cells of a
+ * hash grid. Merged segments are marked as removed instead of being erased
+ * from the middle of the vector. \n \n
+ * An object can be reused for multiple calls to avoid reallocating its
+ * internal buffers.
+ *
+ */
+class LineSegmentMerger
+{
+    public:
+        using Ptr = std::shared_ptr<LineSegmentMerger>;
+        using ConstPtr = std::shared_ptr<const LineSegmentMerger>;
+
+        /**
+         * @brief Construct a new LineSegmentMerger object
+         *
+         * @param distance_threshold threshold for distance between end of one
+         * line segment and start of the other
+         * @param angle_threshold threshold for relative angle between two line
+         * segments
+         * @param perp_dist_threshold threshold for perpendicular distance
+         * between two line segments (only used by mergeCoLinearLines)
+         */
+        LineSegmentMerger(float distance_threshold = 0.2f,
+                          float angle_threshold = 0.2f,
+                          float perp_dist_threshold = 0.1f):
+            distance_threshold_(distance_threshold),
+            angle_threshold_(angle_threshold),
+            perp_dist_threshold_(perp_dist_threshold) {}
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~LineSegmentMerger() {}
+
+        /**
+         * @brief Merge line segments with similar angle where the end of one
+         * is close to the start of the other, irrespective of their position
+         * in the vector. Same result as Utils::mergeCloseLinesBF.
+         *
+         * @param line_segments line segments to be merged in place
+         */
+        void mergeCloseLines(std::vector<LineSegment2D>& line_segments);
+
+        /**
+         * @brief Merge co-linear line segments. Same result as
+         * Utils::mergeCoLinearLines.
+         *
+         * @param line_segments line segments to be merged in place
+         */
+        void mergeCoLinearLines(std::vector<LineSegment2D>& line_segments);
+
+    protected:
+        using CellMap = std::unordered_map<uint64_t, std::vector<uint32_t>>;
+        using PairSet = std::set<std::pair<uint32_t, uint32_t>>;
+
+        float distance_threshold_;
+        float angle_threshold_;
+        float perp_dist_threshold_;
+
+        float cell_size_;
+        std::vector<LineSegment2D> segments_;
+        std::vector<float> angles_;
+        std::vector<bool> is_alive_;
+
+        /// hash grids of segment start and end points
+        CellMap start_cells_;
+        CellMap end_cells_;
+
+        /// pairs of segment ids which can currently be merged
+        PairSet pairs_;
+
+        /// ids of segments with which a segment is part of a pair in pairs_
+        std::vector<std::vector<uint32_t>> partners_;
+
+        /// fenwick tree over is_alive_ to convert between ids and ranks
+        std::vector<uint32_t> rank_tree_;
+
+        void initialise(const std::vector<LineSegment2D>& line_segments);
+
+        void finalise(std::vector<LineSegment2D>& line_segments) const;
+
+        uint64_t calcCellKey(const Point2D& point, int offset_x = 0,
+                             int offset_y = 0) const;
+
+        void addToCell(CellMap& cells, const Point2D& point, uint32_t id);
+
+        void removeFromCell(CellMap& cells, const Point2D& point, uint32_t id);
+
+        /**
+         * @brief Collect ids of segments whose point (in cells) could be
+         * closer than distance threshold to point
+         */
+        void calcNeighbours(const CellMap& cells, const Point2D& point,
+                            std::vector<uint32_t>& ids) const;
+
+        void addPair(uint32_t id_a, uint32_t id_b);
+
+        void removePairs(uint32_t id);
+
+        void removeSegment(uint32_t id);
+
+        bool canMergeClose(uint32_t id_a, uint32_t id_b) const;
+
+        bool canMergeCoLinear(uint32_t id_a, uint32_t id_b) const;
+
+        void updateCloseLinePairs(uint32_t id);
+
+        void updateCoLinearPairs(uint32_t id);
+
+        uint32_t calcRank(uint32_t id) const;
+
+        uint32_t calcIdAtRank(uint32_t rank) const;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_LINE_SEGMENT_MERGER_H
@@ -0,0 +1,235 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_MAPPED_GEOMETRY_2D_H
+#define KELO_GEOMETRY_COMMON_MAPPED_GEOMETRY_2D_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <geometry_common/BVH2D.h>
+#include <geometry_common/Box2D.h>
+#include <geometry_common/LineSegment2D.h>
+#include <geometry_common/PointArrayView2D.h>
+#include <geometry_common/Polygon2D.h>
+#include <geometry_common/Polyline2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Read-only collection of polygons, polylines and line segments (e.g.
+ * zones and walls of a map) that is memory mapped from a flat file and
+ * queried in place. \n \n
+ * The file contains, for each kind of shape, the vertices as PackedPoint2D,
+ * a (first vertex, number of vertices) record per shape and a prebuilt
+ * bounding volume hierarchy (BVHNode2D) over the shapes. All positions are
+ * byte offsets from the start of the file, so the file is relocatable.
+ * Opening a file only validates its header and bounds; there is no parsing
+ * and no per-shape allocation. Values are stored in host byte order, so a
+ * file can only be opened on machines with the same endianness as the one
+ * that wrote it. \n \n
+ * Shapes are accessed as PointArrayView2D which stay valid as long as the
+ * object is open, and indices always refer to the order of the collections
+ * passed to write().
+ */
+class MappedGeometry2D
+{
+    public:
+        using Ptr = std::shared_ptr<MappedGeometry2D>;
+        using ConstPtr = std::shared_ptr<const MappedGeometry2D>;
+
+        using VertexView = PointArrayView2D<PackedPoint2D>;
+
+        /**
+         * @brief Format version written by write()
+         */
+        static const uint32_t VERSION = 1;
+
+        MappedGeometry2D() = default;
+
+        MappedGeometry2D(const MappedGeometry2D&) = delete;
+
+        MappedGeometry2D& operator = (const MappedGeometry2D&) = delete;
+
+        /**
+         * @brief Unmaps the file if it is open
+         */
+        virtual ~MappedGeometry2D();
+
+        /**
+         * @brief Build spatial indices and write shapes to a file. The file
+         * is first written under a temporary name and then renamed, so that
+         * readers never see a partially written file.
+         *
+         * @param file_path path of output file
+         * @param polygons polygons to be written
+         * @param polylines polylines to be written
+         * @param line_segments line segments to be written
+         * @param max_leaf_size maximum number of shapes in one BVH leaf
+         * @return bool true if successful; false otherwise (e.g. if a polygon
+         * or polyline has no vertices)
+         */
+        static bool write(
+                const std::string& file_path,
+                const std::vector<Polygon2D>& polygons,
+                const std::vector<Polyline2D>& polylines = {},
+                const std::vector<LineSegment2D>& line_segments = {},
+                size_t max_leaf_size = 4);
+
+        /**
+         * @brief Memory map a file written by write(). A previously opened
+         * file is closed first.
+         *
+         * @param file_path path of the file
+         * @return bool true if the file was mapped and is valid; false
+         * otherwise (in which case the object is empty)
+         */
+        bool open(const std::string& file_path);
+
+        /**
+         * @brief Unmap the file. All views obtained so far become invalid.
+         */
+        void close();
+
+        /**
+         * @brief
+         *
+         * @return bool true if a file is mapped; false otherwise
+         */
+        bool isOpen() const;
+
+        size_t numOfPolygons() const;
+
+        size_t numOfPolylines() const;
+
+        size_t numOfLineSegments() const;
+
+        /**
+         * @brief Get vertices of a polygon without copying them
+         *
+         * @param index index of polygon
+         * @return VertexView view of vertices into the mapped file
+         */
+        VertexView polygon(size_t index) const;
+
+        /**
+         * @brief Get vertices of a polyline without copying them
+         *
+         * @param index index of polyline
+         * @return VertexView view of vertices into the mapped file
+         */
+        VertexView polyline(size_t index) const;
+
+        /**
+         * @brief
+         *
+         * @param index index of line segment
+         * @return LineSegment2D
+         */
+        LineSegment2D lineSegment(size_t index) const;
+
+        /**
+         * @brief Find all polygons containing a point
+         *
+         * @param point point to be checked
+         * @param indices indices of polygons containing the point. The vector
+         * is cleared first.
+         */
+        void calcPolygonsContaining(
+                const Point2D& point,
+                std::vector<size_t>& indices) const;
+
+        /**
+         * @brief Check if a line segment intersects any polygon boundary,
+         * polyline or line segment (e.g. for line of sight checks against
+         * walls)
+         *
+         * @param line_segment line segment to be checked
+         * @return bool true if any shape is intersected; false otherwise
+         */
+        bool intersects(const LineSegment2D& line_segment) const;
+
+        /**
+         * @brief Find all shapes whose bounding box overlaps with a box
+         *
+         * @param box query box
+         * @param polygon_indices indices of overlapping polygons
+         * @param polyline_indices indices of overlapping polylines
+         * @param line_segment_indices indices of overlapping line segments
+         * \n All vectors are cleared first.
+         */
+        void calcIndicesOverlapping(
+                const Box2D& box,
+                std::vector<size_t>& polygon_indices,
+                std::vector<size_t>& polyline_indices,
+                std::vector<size_t>& line_segment_indices) const;
+
+    protected:
+        /**
+         * @brief Pointers into the mapped file for one kind of shape
+         */
+        struct Section
+        {
+            /// (first vertex, number of vertices) per shape
+            const uint32_t* shapes{nullptr};
+            const PackedPoint2D* points{nullptr};
+            const BVHNode2D* nodes{nullptr};
+            /// shape index of each leaf item
+            const uint32_t* items{nullptr};
+            uint32_t num_of_shapes{0};
+            uint32_t num_of_nodes{0};
+
+            VertexView vertices(size_t index) const;
+        };
+
+        Section polygons_, polylines_, line_segments_;
+
+        void* data_{nullptr};
+        size_t size_{0};
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_MAPPED_GEOMETRY_2D_H
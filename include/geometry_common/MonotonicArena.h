@@ -0,0 +1,239 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_MONOTONIC_ARENA_H
+#define KELO_GEOMETRY_COMMON_MONOTONIC_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Bump allocator for short lived scratch memory. \n \n
+ * Allocations are carved out of large blocks and are never freed
+ * individually; reset() makes all memory available again at once. After the
+ * first few cycles the arena holds enough memory for a whole cycle and
+ * allocating from it does not call malloc anymore. \n \n
+ * An arena is not thread safe. Use one arena per thread, e.g. a thread_local
+ * arena activated with ArenaScope and reset once per control cycle.
+ */
+class MonotonicArena
+{
+    public:
+        using Ptr = std::shared_ptr<MonotonicArena>;
+        using ConstPtr = std::shared_ptr<const MonotonicArena>;
+
+        /**
+         * @brief
+         *
+         * @param initial_block_size size of the first block in bytes. It is
+         * allocated lazily on the first allocation.
+         */
+        explicit MonotonicArena(size_t initial_block_size = 64 * 1024);
+
+        MonotonicArena(const MonotonicArena&) = delete;
+
+        MonotonicArena& operator = (const MonotonicArena&) = delete;
+
+        virtual ~MonotonicArena() = default;
+
+        /**
+         * @brief Allocate uninitialised memory. A new block (doubling in size)
+         * is added when the current one is exhausted.
+         *
+         * @param num_of_bytes size of memory
+         * @param alignment alignment of memory; must be a power of two
+         * @return void* pointer to memory valid until the next reset() or
+         * release()
+         */
+        void* allocate(size_t num_of_bytes,
+                       size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Make all memory available again. Everything allocated so far
+         * becomes invalid. If more than one block was used, the blocks are
+         * replaced by a single block large enough for all of them, so the
+         * next cycle of the same size needs no further block.
+         */
+        void reset();
+
+        /**
+         * @brief Free all blocks
+         */
+        void release();
+
+        /**
+         * @brief
+         *
+         * @return size_t number of bytes allocated since the last reset
+         * (including alignment padding)
+         */
+        size_t bytesUsed() const;
+
+        /**
+         * @brief
+         *
+         * @return size_t total size of all blocks
+         */
+        size_t bytesReserved() const;
+
+        /**
+         * @brief
+         *
+         * @return MonotonicArena* arena activated for the calling thread by
+         * the innermost ArenaScope; nullptr if there is none
+         */
+        static MonotonicArena* current();
+
+    protected:
+        struct Block
+        {
+            std::unique_ptr<char[]> data;
+            size_t size;
+        };
+
+        std::vector<Block> blocks_;
+        size_t initial_block_size_;
+        size_t offset_{0};
+        size_t bytes_used_{0};
+
+        void addBlock(size_t min_size);
+
+};
+
+/**
+ * @brief Scope guard activating an arena for the calling thread. Algorithms
+ * that support arenas (e.g. Utils::clusterPointIndices,
+ * Utils::applyPiecewiseRegression) take their temporaries from the active
+ * arena. Scopes may be nested; the previous arena is restored on destruction.
+ */
+class ArenaScope
+{
+    public:
+        explicit ArenaScope(MonotonicArena& arena);
+
+        ArenaScope(const ArenaScope&) = delete;
+
+        ArenaScope& operator = (const ArenaScope&) = delete;
+
+        ~ArenaScope();
+
+    protected:
+        MonotonicArena* previous_arena_;
+
+};
+
+/**
+ * @brief Standard allocator drawing from a MonotonicArena. Deallocation is a
+ * no-op; the memory is reclaimed by MonotonicArena::reset(). Without an arena
+ * it behaves like std::allocator. \n \n
+ * The default constructor binds to MonotonicArena::current(), so a container
+ * created inside an ArenaScope uses that arena for its whole lifetime. Such a
+ * container must not outlive the next reset() of the arena.
+ *
+ * @tparam T value type
+ */
+template <typename T>
+class ArenaAllocator
+{
+    public:
+        using value_type = T;
+
+        ArenaAllocator():
+            ArenaAllocator(MonotonicArena::current()) {}
+
+        ArenaAllocator(MonotonicArena* arena):
+            arena_(arena) {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other):
+            arena_(other.arena()) {}
+
+        T* allocate(size_t n)
+        {
+            if ( arena_ == nullptr )
+            {
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            }
+            return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, size_t /*n*/)
+        {
+            if ( arena_ == nullptr )
+            {
+                ::operator delete(p);
+            }
+        }
+
+        MonotonicArena* arena() const
+        {
+            return arena_;
+        }
+
+        template <typename U>
+        bool operator == (const ArenaAllocator<U>& other) const
+        {
+            return ( arena_ == other.arena() );
+        }
+
+        template <typename U>
+        bool operator != (const ArenaAllocator<U>& other) const
+        {
+            return !((*this) == other);
+        }
+
+    protected:
+        MonotonicArena* arena_;
+
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_MONOTONIC_ARENA_H
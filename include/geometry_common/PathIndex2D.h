@@ -0,0 +1,252 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_PATH_INDEX_2D_H
+#define KELO_GEOMETRY_COMMON_PATH_INDEX_2D_H
+
+#include <memory>
+#include <vector>
+
+#include <geometry_common/BVH2D.h>
+#include <geometry_common/Point2D.h>
+#include <geometry_common/Pose2D.h>
+#include <geometry_common/Polyline2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Result of projecting a point onto a path
+ *
+ */
+struct PathProjection2D
+{
+    /// index of the path segment (between vertex i and i+1) of the projection
+    size_t segment_index{0};
+
+    /// arc length from the start of the path to the projected point
+    float arc_length{0.0f};
+
+    /// distance between the query point and the projected point
+    float dist{0.0f};
+
+    /// closest point on the path
+    Point2D point;
+};
+
+/**
+ * @brief Arc length parameterisation of a path (Path or Polyline2D) for path
+ * tracking queries. \n \n
+ * Cumulative arc lengths of all vertices and a bounding volume hierarchy over
+ * the segments are computed once, after which
+ *  - points and poses at an arc length are found in O(log n),
+ *  - a global projection onto the path takes O(log n) on average,
+ *  - a local projection around a previous projection takes O(k) for the k
+ *    segments within the search window, i.e. amortised O(1) when called at
+ *    controller rate,
+ *  - resampling at fixed spacing takes O(n + m) for m output poses,
+ * none of which allocate intermediate line segments.
+ *
+ */
+class PathIndex2D
+{
+    public:
+        using Ptr = std::shared_ptr<PathIndex2D>;
+        using ConstPtr = std::shared_ptr<const PathIndex2D>;
+
+        /**
+         * @brief Construct a new PathIndex2D object from a path of poses
+         *
+         * @param path path to be indexed
+         */
+        PathIndex2D(const Path& path = Path());
+
+        /**
+         * @brief Construct a new PathIndex2D object from a polyline. Poses
+         * along the polyline are oriented along its segments.
+         *
+         * @param polyline polyline to be indexed
+         */
+        PathIndex2D(const Polyline2D& polyline);
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~PathIndex2D() {}
+
+        /**
+         * @brief (Re)build the index from a path of poses
+         *
+         * @param path path to be indexed
+         */
+        void build(const Path& path);
+
+        /**
+         * @brief (Re)build the index from a polyline
+         *
+         * @param polyline polyline to be indexed
+         */
+        void build(const Polyline2D& polyline);
+
+        /**
+         * @brief Calculate the point at a given arc length. Arc lengths
+         * outside of [0, length()] are clipped.
+         *
+         * @param arc_length arc length from the start of the path
+         * @param point point at the arc length
+         * @return bool false if path is empty; true otherwise
+         */
+        bool calcPointAt(float arc_length, Point2D& point) const;
+
+        /**
+         * @brief Calculate the pose at a given arc length. Arc lengths
+         * outside of [0, length()] are clipped. For paths of poses the
+         * orientation is interpolated between the neighbouring poses; for
+         * polylines it is the orientation of the segment.
+         *
+         * @param arc_length arc length from the start of the path
+         * @param pose pose at the arc length
+         * @return bool false if path is empty; true otherwise
+         */
+        bool calcPoseAt(float arc_length, Pose2D& pose) const;
+
+        /**
+         * @brief Project a point onto the closest point of the entire path
+         *
+         * @param point query point
+         * @param projection projection of the point onto the path
+         * @return bool false if path is empty; true otherwise
+         */
+        bool calcProjection(
+                const Point2D& point,
+                PathProjection2D& projection) const;
+
+        /**
+         * @brief Project a point onto the closest point of the part of the
+         * path around a previous projection (e.g. from the previous control
+         * cycle). Only segments overlapping the arc length interval
+         * [hint.arc_length - max_arc_length_behind,
+         *  hint.arc_length + max_arc_length_ahead] are considered.
+         *
+         * @param point query point
+         * @param hint previous projection
+         * @param max_arc_length_ahead search window ahead of the hint
+         * @param max_arc_length_behind search window behind the hint
+         * @param projection projection of the point onto the path
+         * @return bool false if path is empty; true otherwise
+         */
+        bool calcProjection(
+                const Point2D& point,
+                const PathProjection2D& hint,
+                float max_arc_length_ahead,
+                float max_arc_length_behind,
+                PathProjection2D& projection) const;
+
+        /**
+         * @brief Resample the path at a fixed arc length spacing. The first
+         * and last poses of the path are always included.
+         *
+         * @param spacing arc length between consecutive poses
+         * @param resampled_path resampled poses (cleared first)
+         */
+        void resample(float spacing, Path& resampled_path) const;
+
+        /**
+         * @brief Get total arc length of the path
+         *
+         * @return float arc length of the path
+         */
+        inline float length() const
+        {
+            return ( arc_lengths_.empty() ) ? 0.0f : arc_lengths_.back();
+        }
+
+        /**
+         * @brief Get arc length from the start of the path to a vertex
+         *
+         * @param index index of vertex
+         * @return float arc length to the vertex
+         */
+        inline float arcLength(size_t index) const
+        {
+            return arc_lengths_[index];
+        }
+
+        /**
+         * @brief Get the number of vertices of the path
+         *
+         * @return size_t number of vertices
+         */
+        inline size_t size() const
+        {
+            return points_.size();
+        }
+
+    protected:
+        PointVec2D points_;
+
+        /// orientation at each vertex
+        std::vector<float> thetas_;
+
+        /// cumulative arc length at each vertex
+        std::vector<float> arc_lengths_;
+
+        bool interpolate_theta_{true};
+
+        BVH2D<LineSegment2D> bvh_;
+
+        void buildIndex();
+
+        size_t findSegment(float arc_length) const;
+
+        void projectOnSegment(
+                const Point2D& point,
+                size_t segment_index,
+                PathProjection2D& projection) const;
+
+        float calcThetaAt(size_t segment_index, float t) const;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_PATH_INDEX_2D_H
@@ -0,0 +1,233 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_POINT_ARRAY_VIEW_2D_H
+#define KELO_GEOMETRY_COMMON_POINT_ARRAY_VIEW_2D_H
+
+#include <vector>
+#include <cstddef>
+
+#include <geometry_msgs/Pose.h>
+#include <geometry_msgs/PoseStamped.h>
+
+#include <geometry_common/Point2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Plain pair of coordinates without virtual functions, used for flat
+ * arrays of points that are stored in files or shared memory.
+ */
+struct PackedPoint2D
+{
+    float x, y;
+};
+
+/**
+ * @brief Accessor used by PointArrayView2D to read the planar coordinates of
+ * an element. The default implementation reads the `x` and `y` members
+ * directly, which covers Point2D, Point3D, Pose2D, PackedPoint2D,
+ * geometry_msgs::Point and geometry_msgs::Point32. \n \n
+ * The algorithms taking a PointArrayView2D (Utils::clusterPointIndices,
+ * Utils::isPointInPolygon, Utils::calcIndicesInPolygon) are compiled into the
+ * library for exactly these element types plus geometry_msgs::Pose and
+ * geometry_msgs::PoseStamped; other element types do not link.
+ *
+ * @tparam T element type
+ */
+template <typename T>
+struct PointAccessor2D
+{
+    static inline float x(const T& element)
+    {
+        return element.x;
+    }
+
+    static inline float y(const T& element)
+    {
+        return element.y;
+    }
+};
+
+/**
+ * @brief Accessor for geometry_msgs::Pose (e.g. geometry_msgs::PoseArray)
+ */
+template <>
+struct PointAccessor2D<geometry_msgs::Pose>
+{
+    static inline float x(const geometry_msgs::Pose& element)
+    {
+        return element.position.x;
+    }
+
+    static inline float y(const geometry_msgs::Pose& element)
+    {
+        return element.position.y;
+    }
+};
+
+/**
+ * @brief Accessor for geometry_msgs::PoseStamped (e.g. nav_msgs::Path)
+ */
+template <>
+struct PointAccessor2D<geometry_msgs::PoseStamped>
+{
+    static inline float x(const geometry_msgs::PoseStamped& element)
+    {
+        return element.pose.position.x;
+    }
+
+    static inline float y(const geometry_msgs::PoseStamped& element)
+    {
+        return element.pose.position.y;
+    }
+};
+
+/**
+ * @brief Non-owning, read-only view of a contiguous array of elements which
+ * are treated as two dimensional points. Allows algorithms to run directly on
+ * arrays owned by ROS messages (e.g. `sensor_msgs::PointCloud::points`,
+ * `geometry_msgs::Polygon::points`, `nav_msgs::Path::poses`) without first
+ * copying them into Point2D objects.
+ * \n \n
+ * The viewed array must outlive the view and must not be resized while the
+ * view is in use.
+ *
+ * @tparam T element type readable through PointAccessor2D
+ */
+template <typename T>
+class PointArrayView2D
+{
+    public:
+        using Accessor = PointAccessor2D<T>;
+
+        /**
+         * @brief
+         *
+         * @param data pointer to first element
+         * @param size number of elements
+         */
+        PointArrayView2D(const T* data = nullptr, size_t size = 0):
+            data_(data),
+            size_(size) {}
+
+        /**
+         * @brief
+         *
+         * @param elements vector to be viewed
+         */
+        PointArrayView2D(const std::vector<T>& elements):
+            PointArrayView2D(elements.data(), elements.size()) {}
+
+        /**
+         * @brief
+         *
+         * @return size_t number of elements in view
+         */
+        inline size_t size() const
+        {
+            return size_;
+        }
+
+        /**
+         * @brief
+         *
+         * @return bool true if view contains no elements; false otherwise
+         */
+        inline bool empty() const
+        {
+            return ( size_ == 0 );
+        }
+
+        /**
+         * @brief
+         *
+         * @param i index of element
+         * @return float x coordinate of i-th element
+         */
+        inline float x(size_t i) const
+        {
+            return Accessor::x(data_[i]);
+        }
+
+        /**
+         * @brief
+         *
+         * @param i index of element
+         * @return float y coordinate of i-th element
+         */
+        inline float y(size_t i) const
+        {
+            return Accessor::y(data_[i]);
+        }
+
+        /**
+         * @brief
+         *
+         * @param i index of element
+         * @return Point2D i-th element as a point
+         */
+        inline Point2D operator [] (size_t i) const
+        {
+            return Point2D(x(i), y(i));
+        }
+
+        /**
+         * @brief
+         *
+         * @return const T* pointer to underlying array
+         */
+        inline const T* data() const
+        {
+            return data_;
+        }
+
+    protected:
+        const T* data_;
+        size_t size_;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_POINT_ARRAY_VIEW_2D_H
@@ -48,6 +48,7 @@
 #include <geometry_common/Point2D.h>
 #include <geometry_common/Point3D.h>
 #include <geometry_common/TransformMatrix3D.h>
+#include <geometry_common/ThreadPool.h>
 
 namespace kelo
 {
@@ -233,6 +234,19 @@ class PointCloudProjector
         void setPassthroughMaxZ(
                 float passthrough_max_z);
 
+        /**
+         * @brief Set how the `projectTo...` functions split their work. The
+         * default policy is sequential.
+         *
+         * @note With a parallel policy the validity function (see
+         * setValidityFunction) is called from several threads concurrently
+         * and must be thread safe.
+         *
+         * @param policy execution policy
+         */
+        void setExecutionPolicy(
+                const geometry_common::ExecutionPolicy& policy);
+
         /**
          * @brief set transformation matrix from camera to target frame
          * @param tf_mat
@@ -270,6 +284,8 @@ class PointCloudProjector
 
         ValidityFunction external_validity_func_{nullptr};
 
+        geometry_common::ExecutionPolicy execution_policy_;
+
         /**
          * @brief 
          * 
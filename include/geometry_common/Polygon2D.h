@@ -44,6 +44,7 @@
 #include <geometry_msgs/PolygonStamped.h>
 #include <visualization_msgs/Marker.h>
 
+#include <geometry_common/Enums.h>
 #include <geometry_common/Polyline2D.h>
 
 namespace kelo
@@ -165,6 +166,16 @@ class Polygon2D : public Polyline2D
                 Pose2D& intersection_pose,
                 unsigned int& segment_id) const;
 
+        /**
+         * @brief Remove redundant vertices in place using the
+         * Ramer-Douglas-Peucker algorithm, taking the edge between the last
+         * and the first vertex into account
+         *
+         * @param tolerance maximum distance of a removed vertex to the
+         * simplified polygon
+         */
+        void simplify(float tolerance) override;
+
         /**
          * @brief Check if a 2D point lies within the polygon.
          * 
@@ -190,6 +201,17 @@ class Polygon2D : public Polyline2D
          */
         Point2D meanPoint() const;
 
+        /**
+         * @brief Get the centroid (center of mass) of the area enclosed by the
+         * polygon. Unlike meanPoint(), the result does not depend on how
+         * densely the edges are sampled with vertices.
+         *
+         * @note Falls back to meanPoint() for polygons with zero area
+         *
+         * @return Point2D The centroid of the polygon
+         */
+        Point2D centroid() const;
+
         /**
          * @brief Get the area of the polygon
          * 
@@ -201,7 +223,9 @@ class Polygon2D : public Polyline2D
         float area() const;
 
         /**
-         * @brief Check if the polygon is convex
+         * @brief Check if the polygon is convex. Collinear consecutive
+         * vertices are allowed but repeated consecutive points are not
+         * (except for the first vertex repeated at the end).
          * 
          * @return bool True if polygon is convex, false otherwise
          */
@@ -218,6 +242,29 @@ class Polygon2D : public Polyline2D
          */
         bool isApproximatelyConvex(float tolerance = 0.017453293) const;
 
+        /**
+         * @brief Classify the convexity and the winding order of the polygon
+         * in a single pass over its vertices. \n \n
+         * The polygon is convex if the polygon turns in the same direction at
+         * every vertex and the turns add up to a single revolution (which
+         * rules out self intersecting polygons like a pentagram).
+         *
+         * @param winding_order COUNTER_CLOCKWISE or CLOCKWISE direction in
+         * which the polygon turns. COLLINEAR if none of the turns exceeds
+         * the tolerance. Only valid if the polygon is convex.
+         * @param tolerance The tolerance in radians (at most pi/2) below
+         * which a turn is ignored. Turns within the tolerance of a complete
+         * reversal always make the polygon non convex.
+         * @param ignore_repeated_points if true, repeated consecutive points
+         * are skipped; otherwise they make the polygon non convex. A first
+         * vertex repeated at the end (closed ring) is always skipped.
+         * @return bool True if polygon is convex, false otherwise
+         */
+        bool calcConvexity(
+                WindingOrder& winding_order,
+                float tolerance = 0.0f,
+                bool ignore_repeated_points = false) const;
+
         /**
          * @brief Find convex hull from the union of 2 polygons.
          * 
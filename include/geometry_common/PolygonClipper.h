@@ -0,0 +1,153 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_POLYGON_CLIPPER_H
+#define KELO_GEOMETRY_COMMON_POLYGON_CLIPPER_H
+
+#include <vector>
+
+#include <geometry_common/Enums.h>
+#include <geometry_common/Polygon2D.h>
+#include <geometry_common/PolygonWithHoles2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Boolean operations (intersection, union, difference and xor) on
+ * simple polygons with holes. \n \n
+ * The implementation is a plane sweep following "A new algorithm for
+ * computing Boolean operations on polygons" by Martinez, Rueda and Feito
+ * (2009). All the edges of both operands are split at their mutual
+ * intersections while sweeping, hence the complexity is O((n+k) log n) where
+ * n is the total number of edges and k is the number of intersections. \n \n
+ * Input polygons may be specified in any winding order. The rings of an
+ * operand are interpreted with the even-odd rule. The result contains
+ * boundaries in counter clockwise winding order and holes in clockwise
+ * winding order.
+ *
+ */
+class PolygonClipper
+{
+    public:
+        /**
+         * @brief Perform a boolean operation between two sets of polygons
+         *
+         * @param subject polygons forming the subject operand
+         * @param clipping polygons forming the clipping operand
+         * @param operation boolean operation to perform
+         * @return std::vector<PolygonWithHoles2D> disjoint regions of the result
+         */
+        static std::vector<PolygonWithHoles2D> calcBooleanOperation(
+                const std::vector<PolygonWithHoles2D>& subject,
+                const std::vector<PolygonWithHoles2D>& clipping,
+                const BooleanOperation& operation);
+
+        /**
+         * @brief Calculate the region common to both polygons
+         *
+         * @param subject first polygon
+         * @param clipping second polygon
+         * @return std::vector<PolygonWithHoles2D> disjoint regions of the result
+         */
+        static std::vector<PolygonWithHoles2D> calcIntersection(
+                const Polygon2D& subject,
+                const Polygon2D& clipping);
+
+        /**
+         * @brief Calculate the region covered by at least one of the polygons
+         *
+         * @param subject first polygon
+         * @param clipping second polygon
+         * @return std::vector<PolygonWithHoles2D> disjoint regions of the result
+         */
+        static std::vector<PolygonWithHoles2D> calcUnion(
+                const Polygon2D& subject,
+                const Polygon2D& clipping);
+
+        /**
+         * @brief Calculate the region covered by subject but not by clipping
+         *
+         * @param subject polygon from which the region is removed
+         * @param clipping polygon that is removed from subject
+         * @return std::vector<PolygonWithHoles2D> disjoint regions of the result
+         */
+        static std::vector<PolygonWithHoles2D> calcDifference(
+                const Polygon2D& subject,
+                const Polygon2D& clipping);
+
+        /**
+         * @brief Calculate the region covered by exactly one of the polygons
+         *
+         * @param subject first polygon
+         * @param clipping second polygon
+         * @return std::vector<PolygonWithHoles2D> disjoint regions of the result
+         */
+        static std::vector<PolygonWithHoles2D> calcXor(
+                const Polygon2D& subject,
+                const Polygon2D& clipping);
+
+        /**
+         * @brief Calculate the union of many (possibly overlapping) polygons.
+         * Polygons are merged pairwise in a balanced manner so that every
+         * edge takes part in O(log m) sweeps for m polygons.
+         *
+         * @param polygons polygons to be merged
+         * @return std::vector<PolygonWithHoles2D> disjoint regions of the result
+         */
+        static std::vector<PolygonWithHoles2D> calcUnion(
+                const std::vector<Polygon2D>& polygons);
+
+        /**
+         * @brief Calculate the union of many (possibly overlapping) regions.
+         *
+         * @param polygons regions to be merged
+         * @return std::vector<PolygonWithHoles2D> disjoint regions of the result
+         */
+        static std::vector<PolygonWithHoles2D> calcUnion(
+                const std::vector<PolygonWithHoles2D>& polygons);
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_POLYGON_CLIPPER_H
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_POLYGON_WITH_HOLES_2D_H
+#define KELO_GEOMETRY_COMMON_POLYGON_WITH_HOLES_2D_H
+
+#include <geometry_common/Polygon2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Represents a region of the plane bounded by an outer boundary
+ * polygon, from which zero or more hole polygons are removed. \n \n
+ * The boundary is expected to be specified in counter clockwise winding order
+ * and the holes in clockwise winding order. This is the convention followed by
+ * the results of PolygonClipper.
+ *
+ */
+class PolygonWithHoles2D
+{
+    public:
+        /// outer boundary of the region
+        Polygon2D boundary;
+
+        /// polygons removed from the region enclosed by boundary
+        std::vector<Polygon2D> holes;
+
+        using Ptr = std::shared_ptr<PolygonWithHoles2D>;
+        using ConstPtr = std::shared_ptr<const PolygonWithHoles2D>;
+
+        /**
+         * @brief Construct a new empty PolygonWithHoles2D object
+         *
+         */
+        PolygonWithHoles2D() = default;
+
+        /**
+         * @brief Construct a new PolygonWithHoles2D object
+         *
+         * @param _boundary outer boundary of the region
+         * @param _holes polygons removed from the region
+         */
+        PolygonWithHoles2D(const Polygon2D& _boundary,
+                           const std::vector<Polygon2D>& _holes = {}):
+            boundary(_boundary), holes(_holes) {}
+
+        /**
+         * @brief Destroy the PolygonWithHoles2D object
+         *
+         */
+        virtual ~PolygonWithHoles2D() {}
+
+        /**
+         * @brief Check if a 2D point lies within the region i.e. inside the
+         * boundary and outside of all the holes
+         *
+         * @param point The 2D point to be checked
+         * @return bool True if the point lies inside the region, false otherwise
+         */
+        bool containsPoint(const Point2D& point) const;
+
+        /**
+         * @brief Get the area of the region i.e. area enclosed by the boundary
+         * minus the area of all holes. The value is always non negative
+         * irrespective of the winding order of the polygons.
+         *
+         * @return float The area of the region
+         */
+        float area() const;
+
+        /**
+         * @brief Get the total number of vertices in boundary and holes
+         *
+         * @return size_t number of vertices
+         */
+        size_t numOfVertices() const;
+
+        /**
+         * @brief Append the region information as string to the input stream object
+         *
+         * @param out The stream object to which the information should be appended
+         * @param polygon The region whose data should be appended to the stream object
+         * @return std::ostream& The stream object representing the concatenation
+         * of the input stream and the region information
+         */
+        friend std::ostream& operator << (
+                std::ostream& out,
+                const PolygonWithHoles2D& polygon);
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_POLYGON_WITH_HOLES_2D_H
@@ -171,6 +171,15 @@ class Polyline2D
          */
         void reverse();
 
+        /**
+         * @brief Remove redundant vertices in place using the
+         * Ramer-Douglas-Peucker algorithm (see Utils::simplifyDouglasPeucker)
+         *
+         * @param tolerance maximum distance of a removed vertex to the
+         * simplified polyline
+         */
+        virtual void simplify(float tolerance);
+
         /**
          * @brief Get an RViz visualization marker for the polyline object
          * 
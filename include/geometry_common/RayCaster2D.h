@@ -0,0 +1,162 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_RAY_CASTER_2D_H
+#define KELO_GEOMETRY_COMMON_RAY_CASTER_2D_H
+
+#include <vector>
+
+#include <geometry_common/BVH2D.h>
+#include <geometry_common/LineSegment2D.h>
+#include <geometry_common/Polygon2D.h>
+#include <geometry_common/Pose2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Casts rays from a 2D sensor pose against a static set of obstacle
+ * edges, e.g. to simulate laser scans or to compute the expected scan at a
+ * pose for localisation. \n \n
+ * Obstacle edges are indexed with a BVH2D so that only edges within the
+ * range of the sensor are considered. Instead of intersecting every beam with
+ * every edge, each edge is only intersected with the beams inside the angular
+ * interval it covers as seen from the sensor. \n \n
+ * Beams without a hit within the maximum range report +Inf (REP 117).
+ *
+ * @note The direction table of the beams is cached between calls with the
+ * same angular parameters, so a single object must not be queried
+ * concurrently from multiple threads.
+ *
+ */
+class RayCaster2D
+{
+    public:
+        using Ptr = std::shared_ptr<RayCaster2D>;
+        using ConstPtr = std::shared_ptr<const RayCaster2D>;
+
+        /**
+         * @brief Construct a new RayCaster2D object
+         *
+         * @param segments line segment obstacles
+         * @param polygons polygon obstacles (only their edges block rays)
+         */
+        RayCaster2D(const std::vector<LineSegment2D>& segments = std::vector<LineSegment2D>(),
+                    const std::vector<Polygon2D>& polygons = std::vector<Polygon2D>());
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~RayCaster2D() {}
+
+        /**
+         * @brief Replace the obstacles and rebuild the spatial index
+         *
+         * @param segments line segment obstacles
+         * @param polygons polygon obstacles (only their edges block rays)
+         */
+        void updateObstacles(
+                const std::vector<LineSegment2D>& segments,
+                const std::vector<Polygon2D>& polygons = std::vector<Polygon2D>());
+
+        /**
+         * @brief Calculate the ranges of all beams of a scan. Beam i points
+         * in the direction angle_min + i * angle_increment relative to the
+         * sensor orientation, like in sensor_msgs::LaserScan.
+         *
+         * @param sensor_pose pose of the sensor in the frame of the obstacles
+         * @param angle_min angle of the first beam
+         * @param angle_max angle of the last beam
+         * @param angle_increment angular distance between consecutive beams
+         * @param range_max maximum range of the sensor
+         * @param ranges range of each beam (+Inf for beams without a hit)
+         */
+        void calcRanges(
+                const Pose2D& sensor_pose,
+                float angle_min,
+                float angle_max,
+                float angle_increment,
+                float range_max,
+                std::vector<float>& ranges) const;
+
+        /**
+         * @brief Calculate the range of a single beam
+         *
+         * @param sensor_pose pose of the sensor in the frame of the obstacles
+         * @param angle angle of the beam relative to the sensor orientation
+         * @param range_max maximum range of the sensor
+         * @return float range of the beam (+Inf if there is no hit)
+         */
+        float calcRange(
+                const Pose2D& sensor_pose,
+                float angle,
+                float range_max) const;
+
+        /**
+         * @brief Get the number of obstacle edges
+         *
+         * @return size_t number of edges
+         */
+        inline size_t size() const
+        {
+            return bvh_.size();
+        }
+
+    protected:
+        BVH2D<LineSegment2D> bvh_;
+
+        /// beam parameters and unit direction of each beam in sensor frame
+        mutable float cached_angle_min_{0.0f};
+        mutable float cached_angle_increment_{0.0f};
+        mutable std::vector<float> cos_table_;
+        mutable std::vector<float> sin_table_;
+
+        void updateDirectionTable(
+                float angle_min,
+                float angle_increment,
+                size_t num_of_beams) const;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_RAY_CASTER_2D_H
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_SIN_COS_TABLE_H
+#define KELO_GEOMETRY_COMMON_SIN_COS_TABLE_H
+
+#include <vector>
+#include <memory>
+
+#include <geometry_common/TransformMatrix2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Lookup table for sine and cosine over a full revolution with linear
+ * interpolation between samples. \n \n
+ * The absolute error is bounded by the interpolation error
+ * (2*pi/resolution)^2 / 8 plus float rounding of (2*pi + 4) * 2^-24, e.g.
+ * ~9e-7 for the default resolution of 4096 samples. maxError() returns the
+ * bound for the actual resolution.
+ *
+ */
+class SinCosTable
+{
+    public:
+        using Ptr = std::shared_ptr<SinCosTable>;
+        using ConstPtr = std::shared_ptr<const SinCosTable>;
+
+        /**
+         * @brief Construct a new SinCosTable object
+         *
+         * @param resolution number of samples in [0, 2*pi)
+         */
+        SinCosTable(size_t resolution = 4096);
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~SinCosTable() {}
+
+        /**
+         * @brief Calculate sine and cosine of an angle
+         *
+         * @param angle angular value in radians (not limited to [-pi, pi]).
+         * Non finite angles give NaN for both values.
+         * @param sin_value sine of angle
+         * @param cos_value cosine of angle
+         */
+        void calcSinCos(float angle, float& sin_value, float& cos_value) const;
+
+        /**
+         * @brief Create transformation matrix using the lookup table for its
+         * rotation
+         *
+         * @param x Translation in X axis
+         * @param y Translation in Y axis
+         * @param theta Rotation on Z axis
+         * @return TransformMatrix2D transformation matrix
+         */
+        TransformMatrix2D calcTransformMatrix(float x, float y, float theta) const;
+
+        /**
+         * @brief Get the upper bound of the absolute interpolation error
+         *
+         * @return float maximum absolute error of sine and cosine values
+         */
+        float maxError() const;
+
+        /**
+         * @brief Get the number of samples in [0, 2*pi)
+         *
+         * @return size_t number of samples
+         */
+        inline size_t resolution() const
+        {
+            return resolution_;
+        }
+
+    protected:
+        size_t resolution_;
+
+        /**
+         * sine and cosine values interleaved (sin_0, cos_0, sin_1, cos_1, ...)
+         * with one extra sample at 2*pi so that interpolation never wraps
+         */
+        std::vector<float> table_;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_SIN_COS_TABLE_H
@@ -0,0 +1,235 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_THREAD_POOL_H
+#define KELO_GEOMETRY_COMMON_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Small work stealing task scheduler. \n \n
+ * Every worker owns a task queue. Workers take tasks from the back of their
+ * own queue and, when it is empty, steal from the front of the queues of
+ * other workers. A thread waiting for its tasks to finish (see parallelFor)
+ * executes pending tasks itself, so nested parallel calls do not deadlock and
+ * a pool without workers simply runs everything inline on the caller thread.
+ */
+class ThreadPool
+{
+    public:
+        using Ptr = std::shared_ptr<ThreadPool>;
+        using ConstPtr = std::shared_ptr<const ThreadPool>;
+
+        using Task = std::function<void ()>;
+
+        /**
+         * @brief Start worker threads
+         *
+         * @param num_of_threads number of worker threads. The thread calling
+         * parallelFor participates as well, so the default leaves one
+         * hardware thread to the caller. 0 runs all tasks inline.
+         * @param pin_threads if true, worker i is pinned to core
+         * (first_core + i) modulo the number of cores (Linux only; ignored
+         * elsewhere). On NUMA machines whose cores are numbered per node,
+         * this keeps a small pool on one node.
+         * @param first_core core of the first pinned worker
+         */
+        explicit ThreadPool(
+                size_t num_of_threads = ThreadPool::defaultNumOfThreads(),
+                bool pin_threads = false,
+                size_t first_core = 0);
+
+        ThreadPool(const ThreadPool&) = delete;
+
+        ThreadPool& operator = (const ThreadPool&) = delete;
+
+        /**
+         * @brief Finish all queued tasks and join worker threads
+         */
+        virtual ~ThreadPool();
+
+        /**
+         * @brief
+         *
+         * @return size_t number of hardware threads minus one (0 if unknown)
+         */
+        static size_t defaultNumOfThreads();
+
+        /**
+         * @brief
+         *
+         * @return size_t number of worker threads
+         */
+        size_t numOfThreads() const;
+
+        /**
+         * @brief Queue a task for asynchronous execution. Tasks submitted from
+         * a worker thread go to that worker's own queue. With no workers the
+         * task is executed immediately.
+         *
+         * @param task task to be executed. It must not throw.
+         */
+        void submit(const Task& task);
+
+        /**
+         * @brief Split [begin, end) into chunks of at least grain_size indices
+         * and call func(chunk_begin, chunk_end) for each chunk in parallel.
+         * Returns when all chunks are done; the calling thread executes
+         * chunks too. An exception thrown by func is rethrown here after all
+         * chunks have finished.
+         *
+         * @param begin first index
+         * @param end one past last index
+         * @param grain_size minimum number of indices per chunk
+         * @param func callable processing one chunk
+         */
+        void parallelFor(
+                size_t begin,
+                size_t end,
+                size_t grain_size,
+                const std::function<void (size_t, size_t)>& func);
+
+    protected:
+        struct WorkerQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::thread> threads_;
+        std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+        std::mutex wake_mutex_;
+        std::condition_variable wake_cv_;
+        std::atomic<size_t> num_of_queued_tasks_{0};
+        std::atomic<size_t> next_queue_{0};
+        bool is_stopping_{false};
+
+        void runWorker(size_t worker_index);
+
+        /**
+         * @brief Take one task, preferring the queue of preferred_queue
+         * (own queue: back) before stealing (other queues: front)
+         *
+         * @param preferred_queue index of own queue; any value >= number of
+         * queues for threads without an own queue
+         * @param task taken task
+         * @return bool true if a task was taken; false otherwise
+         */
+        bool takeTask(size_t preferred_queue, Task& task);
+
+        /**
+         * @brief
+         *
+         * @return size_t index of the queue of the calling worker thread of
+         * this pool; number of queues for other threads
+         */
+        size_t ownQueueIndex() const;
+
+};
+
+/**
+ * @brief Opt-in argument of batch operations deciding whether and how they
+ * run in parallel. The default constructed policy is sequential, so existing
+ * behaviour is unchanged unless a ThreadPool is passed.
+ */
+class ExecutionPolicy
+{
+    public:
+        /**
+         * @brief
+         *
+         * @param thread_pool pool used for parallel execution; nullptr for
+         * sequential execution. The pool must outlive the policy.
+         * @param grain_size minimum number of elements per task. Ranges not
+         * larger than this are processed inline.
+         */
+        ExecutionPolicy(ThreadPool* thread_pool = nullptr,
+                        size_t grain_size = 4096):
+            thread_pool_(thread_pool),
+            grain_size_(( grain_size == 0 ) ? 1 : grain_size) {}
+
+        /**
+         * @brief Call func(chunk_begin, chunk_end) for chunks covering
+         * [begin, end), in parallel if the policy has a thread pool and the
+         * range is larger than the grain size; otherwise as a single inline
+         * call func(begin, end).
+         *
+         * @param begin first index
+         * @param end one past last index
+         * @param func callable processing one chunk
+         */
+        void parallelFor(
+                size_t begin,
+                size_t end,
+                const std::function<void (size_t, size_t)>& func) const;
+
+        /**
+         * @brief
+         *
+         * @return bool true if work may be split across threads
+         */
+        bool isParallel() const;
+
+        ThreadPool* threadPool() const;
+
+        size_t grainSize() const;
+
+    protected:
+        ThreadPool* thread_pool_;
+        size_t grain_size_;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_THREAD_POOL_H
@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_TRANSFORM_BUFFER_2D_H
+#define KELO_GEOMETRY_COMMON_TRANSFORM_BUFFER_2D_H
+
+#include <deque>
+#include <vector>
+
+#include <geometry_common/TransformMatrix2D.h>
+#include <geometry_common/Point2D.h>
+#include <geometry_common/Pose2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Buffer of time stamped two dimensional poses (e.g. odom_T_sensor)
+ * which can be interpolated at arbitrary times within the buffered interval.
+ * \n \n
+ * Positions are interpolated linearly and orientations along the shortest
+ * angle. Poses older than `max_duration` seconds w.r.t. the newest pose are
+ * discarded automatically.
+ *
+ */
+class TransformBuffer2D
+{
+    public:
+        using Ptr = std::shared_ptr<TransformBuffer2D>;
+        using ConstPtr = std::shared_ptr<const TransformBuffer2D>;
+
+        /**
+         * @brief Construct a new TransformBuffer2D object
+         *
+         * @param max_duration duration (in seconds) for which poses are kept
+         * in the buffer
+         */
+        TransformBuffer2D(double max_duration = 10.0):
+            max_duration_(max_duration) {}
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~TransformBuffer2D() {}
+
+        /**
+         * @brief Add a time stamped pose to the buffer. Poses may be added out
+         * of order; a pose with an already existing stamp replaces the old
+         * one.
+         *
+         * @param stamp time (in seconds) of the pose
+         * @param pose pose at the given time
+         */
+        void addPose(double stamp, const Pose2D& pose);
+
+        /**
+         * @brief Calculate the interpolated pose at the given time. No
+         * extrapolation is performed.
+         *
+         * @param stamp time (in seconds) at which pose is required
+         * @param pose interpolated pose
+         * @return bool true if stamp lies within the buffered interval; false
+         * otherwise
+         */
+        bool calcPose(double stamp, Pose2D& pose) const;
+
+        /**
+         * @brief Calculate the interpolated transformation at the given time.
+         *
+         * @param stamp time (in seconds) at which transformation is required
+         * @param tf_mat interpolated transformation
+         * @return bool true if stamp lies within the buffered interval; false
+         * otherwise
+         */
+        bool calcTransform(double stamp, TransformMatrix2D& tf_mat) const;
+
+        /**
+         * @brief Motion compensate a cloud whose points were measured at
+         * different times. Each point is transformed from the frame at its
+         * own measurement time into the frame at `target_stamp`. \n \n
+         * The time span of the cloud is split into `num_of_bins` equally long
+         * bins and a single transformation is precomputed for the center of
+         * each bin, so that no trigonometric function is evaluated per
+         * point.
+         *
+         * @param cloud cloud to be compensated in place
+         * @param point_time_offsets time offset (in seconds) of every point
+         * w.r.t. `scan_stamp`
+         * @param scan_stamp reference time (in seconds) of the cloud
+         * @param target_stamp time (in seconds) into whose frame the cloud is
+         * transformed
+         * @param num_of_bins number of piecewise constant transformations
+         * @return bool true if the buffer covers all required times; false
+         * otherwise (in which case the cloud is not modified)
+         */
+        bool deskew(
+                PointCloud2D& cloud,
+                const std::vector<float>& point_time_offsets,
+                double scan_stamp,
+                double target_stamp,
+                size_t num_of_bins = 32) const;
+
+        /**
+         * @brief Remove all poses from the buffer
+         *
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of buffered poses
+         *
+         * @return size_t number of buffered poses
+         */
+        inline size_t size() const
+        {
+            return buffer_.size();
+        }
+
+        /**
+         * @brief Get the stamp of the oldest buffered pose
+         *
+         * @return double stamp of the oldest pose; 0.0 if buffer is empty
+         */
+        double oldestStamp() const;
+
+        /**
+         * @brief Get the stamp of the newest buffered pose
+         *
+         * @return double stamp of the newest pose; 0.0 if buffer is empty
+         */
+        double newestStamp() const;
+
+    protected:
+        struct StampedPose
+        {
+            double stamp;
+            Pose2D pose;
+        };
+
+        std::deque<StampedPose> buffer_;
+        double max_duration_;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_TRANSFORM_BUFFER_2D_H
@@ -0,0 +1,191 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_TRANSFORM_BUFFER_3D_H
+#define KELO_GEOMETRY_COMMON_TRANSFORM_BUFFER_3D_H
+
+#include <deque>
+#include <vector>
+
+#include <geometry_common/TransformMatrix3D.h>
+#include <geometry_common/Point3D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Buffer of time stamped three dimensional transformations (e.g.
+ * odom_T_sensor) which can be interpolated at arbitrary times within the
+ * buffered interval. \n \n
+ * Translations are interpolated linearly and rotations with spherical linear
+ * interpolation (slerp) of quaternions. Transformations older than
+ * `max_duration` seconds w.r.t. the newest one are discarded automatically.
+ *
+ */
+class TransformBuffer3D
+{
+    public:
+        using Ptr = std::shared_ptr<TransformBuffer3D>;
+        using ConstPtr = std::shared_ptr<const TransformBuffer3D>;
+
+        /**
+         * @brief Construct a new TransformBuffer3D object
+         *
+         * @param max_duration duration (in seconds) for which transformations
+         * are kept in the buffer
+         */
+        TransformBuffer3D(double max_duration = 10.0):
+            max_duration_(max_duration) {}
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~TransformBuffer3D() {}
+
+        /**
+         * @brief Add a time stamped transformation to the buffer.
+         * Transformations may be added out of order; a transformation with an
+         * already existing stamp replaces the old one.
+         *
+         * @param stamp time (in seconds) of the transformation
+         * @param tf_mat transformation at the given time
+         */
+        void addTransform(double stamp, const TransformMatrix3D& tf_mat);
+
+        /**
+         * @brief Add a time stamped transformation to the buffer.
+         *
+         * @param stamp time (in seconds) of the transformation
+         * @param x translation along X axis
+         * @param y translation along Y axis
+         * @param z translation along Z axis
+         * @param qx X component of rotation quaternion
+         * @param qy Y component of rotation quaternion
+         * @param qz Z component of rotation quaternion
+         * @param qw W component of rotation quaternion
+         */
+        void addTransform(double stamp, float x, float y, float z,
+                          float qx, float qy, float qz, float qw);
+
+        /**
+         * @brief Calculate the interpolated transformation at the given time.
+         * No extrapolation is performed.
+         *
+         * @param stamp time (in seconds) at which transformation is required
+         * @param tf_mat interpolated transformation
+         * @return bool true if stamp lies within the buffered interval; false
+         * otherwise
+         */
+        bool calcTransform(double stamp, TransformMatrix3D& tf_mat) const;
+
+        /**
+         * @brief Motion compensate a cloud whose points were measured at
+         * different times. Each point is transformed from the frame at its
+         * own measurement time into the frame at `target_stamp`, using one
+         * precomputed transformation per time bin (see
+         * TransformBuffer2D::deskew).
+         *
+         * @param cloud cloud to be compensated in place
+         * @param point_time_offsets time offset (in seconds) of every point
+         * w.r.t. `scan_stamp`
+         * @param scan_stamp reference time (in seconds) of the cloud
+         * @param target_stamp time (in seconds) into whose frame the cloud is
+         * transformed
+         * @param num_of_bins number of piecewise constant transformations
+         * @return bool true if the buffer covers all required times; false
+         * otherwise (in which case the cloud is not modified)
+         */
+        bool deskew(
+                PointCloud3D& cloud,
+                const std::vector<float>& point_time_offsets,
+                double scan_stamp,
+                double target_stamp,
+                size_t num_of_bins = 32) const;
+
+        /**
+         * @brief Remove all transformations from the buffer
+         *
+         */
+        void clear();
+
+        /**
+         * @brief Get the number of buffered transformations
+         *
+         * @return size_t number of buffered transformations
+         */
+        inline size_t size() const
+        {
+            return buffer_.size();
+        }
+
+        /**
+         * @brief Get the stamp of the oldest buffered transformation
+         *
+         * @return double stamp of the oldest transformation; 0.0 if buffer
+         * is empty
+         */
+        double oldestStamp() const;
+
+        /**
+         * @brief Get the stamp of the newest buffered transformation
+         *
+         * @return double stamp of the newest transformation; 0.0 if buffer
+         * is empty
+         */
+        double newestStamp() const;
+
+    protected:
+        struct StampedTransform
+        {
+            double stamp;
+            std::array<float, 3> translation;
+            std::array<float, 4> quaternion; // qx, qy, qz, qw
+        };
+
+        std::deque<StampedTransform> buffer_;
+        double max_duration_;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_TRANSFORM_BUFFER_3D_H
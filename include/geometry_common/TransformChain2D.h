@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_TRANSFORM_CHAIN_2D_H
+#define KELO_GEOMETRY_COMMON_TRANSFORM_CHAIN_2D_H
+
+#include <vector>
+
+#include <geometry_common/TransformMatrix2D.h>
+#include <geometry_common/Point2D.h>
+#include <geometry_common/Pose2D.h>
+#include <geometry_common/LineSegment2D.h>
+#include <geometry_common/Polygon2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+/**
+ * @brief Chain of two dimensional transformations (e.g. map_T_odom,
+ * odom_T_base, base_T_sensor) which is applied as a single composed
+ * transformation. \n \n
+ * The composed matrix is only recomputed when a link of the chain changed
+ * since the last use. Geometric objects are transformed in place in a single
+ * pass, without creating intermediate copies.
+ *
+ * @note The composed matrix is computed lazily from const member functions,
+ * so a single object must not be used concurrently from multiple threads
+ * while its links are being modified.
+ *
+ */
+class TransformChain2D
+{
+    public:
+        using Ptr = std::shared_ptr<TransformChain2D>;
+        using ConstPtr = std::shared_ptr<const TransformChain2D>;
+
+        /**
+         * @brief Construct a new TransformChain2D object
+         *
+         * @param links transformations ordered from the outermost frame to
+         * the innermost frame, i.e. the composed transformation is
+         * links[0] * links[1] * ... * links[n-1]
+         */
+        TransformChain2D(const std::vector<TransformMatrix2D>& links =
+                         std::vector<TransformMatrix2D>()):
+            links_(links) {}
+
+        /**
+         * @brief default d-tor
+         */
+        virtual ~TransformChain2D() {}
+
+        /**
+         * @brief Append a transformation at the inner end of the chain
+         *
+         * @param tf_mat transformation to be appended
+         * @return size_t index of the new link
+         */
+        size_t append(const TransformMatrix2D& tf_mat);
+
+        /**
+         * @brief Update a link of the chain. The composed transformation is
+         * only invalidated if the matrix actually changed.
+         *
+         * @param index index of the link
+         * @param tf_mat new transformation of the link
+         */
+        void updateLink(size_t index, const TransformMatrix2D& tf_mat);
+
+        /**
+         * @brief Remove all links
+         *
+         */
+        void clear();
+
+        /**
+         * @brief Get a link of the chain
+         *
+         * @param index index of the link
+         * @return const TransformMatrix2D& transformation of the link
+         */
+        inline const TransformMatrix2D& link(size_t index) const
+        {
+            return links_[index];
+        }
+
+        /**
+         * @brief Get the number of links
+         *
+         * @return size_t number of links
+         */
+        inline size_t size() const
+        {
+            return links_.size();
+        }
+
+        /**
+         * @brief Get the composed transformation of all links. Identity for
+         * an empty chain.
+         *
+         * @return const TransformMatrix2D& composed transformation
+         */
+        const TransformMatrix2D& composed() const;
+
+        void transform(Point2D& point) const;
+
+        void transform(Pose2D& pose) const;
+
+        void transform(LineSegment2D& line_segment) const;
+
+        void transform(Polyline2D& polyline) const;
+
+        void transform(PointCloud2D& cloud) const;
+
+        void transform(Path& pose_path) const;
+
+        /**
+         * @brief Transform a cloud into a separate output cloud. The memory
+         * of the output cloud is reused if it has enough capacity.
+         *
+         * @param cloud input cloud
+         * @param transformed_cloud output cloud
+         */
+        void transform(const PointCloud2D& cloud, PointCloud2D& transformed_cloud) const;
+
+    protected:
+        std::vector<TransformMatrix2D> links_;
+
+        mutable TransformMatrix2D composed_;
+        mutable float composed_theta_{0.0f};
+        mutable bool is_composed_valid_{false};
+
+        void transformPoints(const Point2D* input, Point2D* output, size_t size) const;
+
+};
+
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_TRANSFORM_CHAIN_2D_H
@@ -58,6 +58,7 @@ class LineSegment2D;
 class Polyline2D;
 class Polygon2D;
 class XYTheta;
+class ExecutionPolicy;
 using PointCloud2D = std::vector<Point2D>;
 using Vector2D = Point2D;
 using Velocity2D = XYTheta;
@@ -74,8 +75,11 @@ class TransformMatrix2D
         using Ptr = std::shared_ptr<TransformMatrix2D>;
         using ConstPtr = std::shared_ptr<const TransformMatrix2D>;
 
+        /**
+         * @brief Construct identity transformation matrix
+         */
         TransformMatrix2D():
-            TransformMatrix2D(0.0f, 0.0f, 0.0f) {}
+            mat_{{1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f}} {}
 
         /**
          * @brief Construct transformation matrix with euler angle values
@@ -106,6 +110,33 @@ class TransformMatrix2D
 
         TransformMatrix2D(const TransformMatrix2D& tf_mat);
 
+        /**
+         * @brief Create transformation matrix from an already computed
+         * rotation (e.g. from a lookup table or a unit complex number) without
+         * evaluating any trigonometric function
+         *
+         * @param x Translation in X axis
+         * @param y Translation in Y axis
+         * @param cos_theta cosine of rotation on Z axis
+         * @param sin_theta sine of rotation on Z axis
+         * @return newly created TransformMatrix2D object
+         */
+        static TransformMatrix2D initFromCosSin(
+                float x, float y, float cos_theta, float sin_theta);
+
+        /**
+         * @brief Calculate transformation matrices for a collection of poses
+         * in a single batch. Sine and cosine of all headings are computed
+         * with Utils::calcSinCos.
+         *
+         * @param poses poses for which transformation matrices are needed
+         * @param tf_mats transformation matrices corresponding to each pose
+         * (resized to poses.size())
+         */
+        static void calcTransformMatrices(
+                const Path& poses,
+                std::vector<TransformMatrix2D>& tf_mats);
+
         /**
          * @brief
          * 
@@ -130,6 +161,14 @@ class TransformMatrix2D
 
         void updateTheta(float theta);
 
+        /**
+         * @brief Update rotation from precomputed cosine and sine values
+         *
+         * @param cos_theta cosine of rotation on Z axis
+         * @param sin_theta sine of rotation on Z axis
+         */
+        void updateRotation(float cos_theta, float sin_theta);
+
         void updateQuaternion(float qx, float qy, float qz, float qw);
 
         TransformMatrix2D calcInverse() const;
@@ -175,6 +214,22 @@ class TransformMatrix2D
 
         void transform(Path& pose_path) const;
 
+        /**
+         * @brief transform point cloud in place, possibly in parallel
+         *
+         * @param cloud points that need to be transformed in place
+         * @param policy execution policy deciding how the work is split
+         */
+        void transform(PointCloud2D& cloud, const ExecutionPolicy& policy) const;
+
+        /**
+         * @brief transform path in place, possibly in parallel
+         *
+         * @param pose_path poses that need to be transformed in place
+         * @param policy execution policy deciding how the work is split
+         */
+        void transform(Path& pose_path, const ExecutionPolicy& policy) const;
+
         /**
          * @brief 
          * 
@@ -54,6 +54,7 @@ namespace geometry_common
 class Point3D;
 using PointCloud3D = std::vector<Point3D>;
 using Vector3D = Point3D;
+class ExecutionPolicy;
 
 /**
  * @brief Transformation matrix for three dimensional space
@@ -133,6 +134,14 @@ class TransformMatrix3D
 
         void transform(PointCloud3D& cloud) const;
 
+        /**
+         * @brief transform point cloud in place, possibly in parallel
+         *
+         * @param cloud points that need to be transformed in place
+         * @param policy execution policy deciding how the work is split
+         */
+        void transform(PointCloud3D& cloud, const ExecutionPolicy& policy) const;
+
         /**
          * @brief 
          * 
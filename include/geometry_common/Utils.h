@@ -43,6 +43,8 @@
 
 #include <vector>
 #include <string>
+#include <utility>
+#include <cstdint>
 
 #include <geometry_msgs/Point32.h>
 #include <nav_msgs/Path.h>
@@ -55,6 +57,8 @@
 #include <geometry_common/Circle.h>
 #include <geometry_common/LineSegment2D.h>
 #include <geometry_common/Enums.h>
+#include <geometry_common/PointArrayView2D.h>
+#include <geometry_common/ThreadPool.h>
 
 namespace kelo
 {
@@ -131,6 +135,9 @@ class Utils
          * calculated
          * @param pt specified point from which the closest point calculation are made
          * @return T closest point from the specified point in the collection
+         *
+         * @note Linear in the number of points. Use KDTree for repeated
+         * queries on the same collection.
          */
         template <typename T>
         static T calcClosestPoint(
@@ -153,6 +160,28 @@ class Utils
                 float cluster_distance_threshold = 0.1f,
                 size_t min_cluster_size = 3);
 
+        /**
+         * @brief cluster 2D points based on distance without copying them.
+         * Produces the same clusters as `Utils::clusterPoints` but as indices
+         * into the viewed array, so that it can run directly on message data
+         * (e.g. `PointArrayView2D<geometry_msgs::Point32>(cloud_msg.points)`).
+         *
+         * @tparam T element type of the view; one of the types listed in
+         * PointAccessor2D
+         * @param points view of points which is needed for clustering
+         * @param cluster_distance_threshold minimum distance threshold between
+         * any two clusters
+         * @param min_cluster_size clusters containing points smaller than this
+         * limit will be removed
+         * @return std::vector<std::vector<size_t>> collection of clusters. Each
+         * cluster is a collection of indices of points in the view
+         */
+        template <typename T>
+        static std::vector<std::vector<size_t>> clusterPointIndices(
+                const PointArrayView2D<T>& points,
+                float cluster_distance_threshold = 0.1f,
+                size_t min_cluster_size = 3);
+
         /**
          * @brief cluster 2D points that are ordered based on distance.
          * More efficient than `Utils::clusterPoints`.
@@ -186,18 +215,46 @@ class Utils
 
         /**
          * @brief Calculate trajectory (vector of poses) for fixed velocity
-         * using euler forward integration
+         * using euler forward integration. \n \n
+         * The k-th pose is the k-th power of the per step transformation,
+         * which is evaluated in closed form instead of by repeated matrix
+         * multiplication so that no error accumulates along the trajectory.
          *
          * @param vel velocity at which the object is travelling
          * @param num_of_poses number of poses in trajectory
          * @param future_time time for which the object is travelling
-         * @return std::vector<Pose2D> trajectory
+         * @return std::vector<Pose2D> trajectory (num_of_poses + 1 poses
+         * including the current pose)
          */
         static std::vector<Pose2D> calcTrajectory(
                 const Velocity2D& vel,
                 size_t num_of_poses,
                 float future_time);
 
+        /**
+         * @brief Calculate trajectories for a batch of fixed velocities (same
+         * integration as calcTrajectory()) into struct of arrays buffers. \n
+         * \n
+         * Pose `k` (k = 0 being the current pose) of velocity `i` is stored
+         * at index `(i * (num_of_poses + 1)) + k` of the output buffers. The
+         * buffers are resized as needed, so reusing them across calls avoids
+         * reallocation.
+         *
+         * @param vels velocities at which the object may travel
+         * @param num_of_poses number of poses in each trajectory
+         * @param future_time time for which the object is travelling
+         * @param xs X coordinates of trajectory poses
+         * @param ys Y coordinates of trajectory poses
+         * @param thetas orientations of trajectory poses in range [-pi, pi]
+         */
+        static void calcTrajectories(
+                const std::vector<Velocity2D>& vels,
+                size_t num_of_poses,
+                float future_time,
+                std::vector<float>& xs,
+                std::vector<float>& ys,
+                std::vector<float>& thetas);
+
         /**
          * @brief Calculate the shortest angular difference between two given
          * angles. The result will always be between -pi and pi
@@ -506,7 +563,12 @@ class Utils
                 float angle_threshold = 0.2f);
 
         /**
-         * @brief 
+         * @brief Merge line segments with similar angle where the end of one
+         * is close to the start of the other, irrespective of their position
+         * in the vector
+         *
+         * @note Uses LineSegmentMerger, which only tests pairs of nearby
+         * segments
          * 
          * @param line_segments 
          * @param distance_threshold 
@@ -520,6 +582,9 @@ class Utils
         /**
          * @brief Merge co-linear line segments
          *
+         * @note Uses LineSegmentMerger, which only tests pairs of nearby
+         * segments
+         *
          * @param line_segments input line segments
          * @param distance_threshold threshold for distance between two line
          * segments
@@ -589,6 +654,21 @@ class Utils
         static float clipAngle(
                 float raw_angle);
 
+        /**
+         * @brief Calculate sine and cosine of an array of angles. \n \n
+         * Uses a branch free polynomial approximation (max error ~1e-7 for
+         * |angle| < 8192 rad) whose loop can be vectorised by the compiler.
+         * Larger or non finite angles fall back to std::sin and std::cos.
+         *
+         * @param angles angular values in radians
+         * @param sin_values sine of each angle (resized to angles.size())
+         * @param cos_values cosine of each angle (resized to angles.size())
+         */
+        static void calcSinCos(
+                const std::vector<float>& angles,
+                std::vector<float>& sin_values,
+                std::vector<float>& cos_values);
+
         /**
          * @brief Clip XYTheta between max and min limits
          *
@@ -648,7 +728,10 @@ class Utils
 
         /**
          * @brief Calculate an entire bezier spline curve full of points for
-         * given control points.
+         * given control points. \n \n
+         * When many curves with the same order and number of points are
+         * needed, use BezierCurveEvaluator directly to reuse its basis
+         * matrix across calls.
          *
          * @param control_points control points to generate spline curve from
          * @param num_of_points number of points to populate the spline curve
@@ -671,6 +754,10 @@ class Utils
          *
          * @param row_num row number from top on pascal's triangle
          *
+         * @note only valid for row_num <= 34; larger rows have coefficients
+         * beyond the range of unsigned int and the returned values wrap
+         * around. Use BezierCurveEvaluator for curves of such high order.
+         *
          * @return coefficients at the given row
          */
         static std::vector<unsigned int> calcPascalTriangleRowCoefficients(
@@ -707,6 +794,33 @@ class Utils
                 const std::vector<T>& pc,
                 const std::string& frame = "base_link");
 
+        /**
+         * @brief Convert from PointCloud2D or PointCloud3D to
+         * sensor_msgs::PointCloud2 with float32 x, y and z fields (z is 0 for
+         * PointCloud2D) followed by optional float32 channels.
+         * \n \n
+         * The data buffer is resized once and packed with bulk copies.
+         * Passing the same cloud_msg on every call reuses its field and data
+         * buffers. The header stamp is left untouched.
+         *
+         * @tparam T Point2D or Point3D
+         * @param pc PointCloud2D or PointCloud3D
+         * @param cloud_msg output message (overwritten)
+         * @param frame frame id of output message
+         * @param channel_names names of extra float32 fields
+         * @param channels values of extra fields; one vector per name, each
+         * with the same size as pc
+         * @return bool false if channels do not match channel_names or pc (in
+         * which case cloud_msg is not modified); true otherwise
+         */
+        template <typename T>
+        static bool convertToROSPointCloud2(
+                const std::vector<T>& pc,
+                sensor_msgs::PointCloud2& cloud_msg,
+                const std::string& frame = "base_link",
+                const std::vector<std::string>& channel_names = {},
+                const std::vector<std::vector<float>>& channels = {});
+
         /**
          * @brief 
          * 
@@ -734,7 +848,30 @@ class Utils
                 size_t col_sub_sample_factor = 1);
 
         /**
-         * @brief Convert from LaserScan msg to PointCloud
+         * @brief Same as above but writes into an existing cloud (reusing its
+         * memory) and additionally reports the index (row * width + col) of
+         * each point in the organised input cloud. \n \n
+         * Clouds whose x, y and z fields are float32 are decoded directly
+         * from the message data at fixed byte offsets, which is considerably
+         * faster than iterating over each field.
+         *
+         * @param cloud_msg
+         * @param points points without NaN coordinates (overwritten)
+         * @param indices index of each point in the input cloud (overwritten)
+         * @param row_sub_sample_factor
+         * @param col_sub_sample_factor
+         */
+        static void convertToPointCloud3D(
+                const sensor_msgs::PointCloud2& cloud_msg,
+                PointCloud3D& points,
+                std::vector<size_t>& indices,
+                size_t row_sub_sample_factor = 1,
+                size_t col_sub_sample_factor = 1);
+
+        /**
+         * @brief Convert from LaserScan msg to PointCloud. For repeated
+         * conversion of scans from the same sensor, LaserScanConverter avoids
+         * recomputing the beam directions.
          *
          * @tparam T Point2D or Point3D
          * @param scan laser scan message
@@ -780,6 +917,40 @@ class Utils
                 float max_angle,
                 float min_angle);
 
+        /**
+         * @brief Check if a point lies inside a polygon given by a view of its
+         * vertices (e.g. `PointArrayView2D<geometry_msgs::Point32>(polygon_msg.points)`)
+         *
+         * @tparam T element type of the view; one of the types listed in
+         * PointAccessor2D
+         * @param vertices view of polygon vertices
+         * @param point point to be checked
+         * @return bool true if point is inside the polygon; false otherwise
+         */
+        template <typename T>
+        static bool isPointInPolygon(
+                const PointArrayView2D<T>& vertices,
+                const Point2D& point);
+
+        /**
+         * @brief Find the indices of all points that lie inside a polygon
+         * given by a view of its vertices. Indices are returned in increasing
+         * order irrespective of the execution policy.
+         *
+         * @tparam T element type of the view; one of the types listed in
+         * PointAccessor2D
+         * @param vertices view of polygon vertices
+         * @param points points to be checked
+         * @param indices indices of points inside the polygon (output)
+         * @param policy execution policy used to split the points
+         */
+        template <typename T>
+        static void calcIndicesInPolygon(
+                const PointArrayView2D<T>& vertices,
+                const PointCloud2D& points,
+                std::vector<size_t>& indices,
+                const ExecutionPolicy& policy = ExecutionPolicy());
+
         /**
          * @brief 
          * 
@@ -821,6 +992,102 @@ class Utils
                 const Point2D& c,
                 float tolerance = 1e-6f);
 
+        /**
+         * @brief Check if two chains of line segments (e.g. polylines or
+         * polygon boundaries) intersect at atleast one point. Segments of the
+         * same chain are not checked against each other. \n \n
+         * Large inputs are handled with a Shamos-Hoey sweep line in
+         * O((n+m) log(n+m)); small inputs are checked pairwise. If a chain is
+         * found to be self intersecting, the sweep can not continue and the
+         * remaining check falls back to pairwise testing.
+         *
+         * @param vertices_a vertices of the first chain
+         * @param vertices_b vertices of the second chain
+         * @param is_a_closed if an edge from the last to the first vertex of
+         * the first chain exists (as in Polygon2D)
+         * @param is_b_closed if an edge from the last to the first vertex of
+         * the second chain exists (as in Polygon2D)
+         * @return bool True if the chains intersect, false otherwise
+         */
+        static bool doPolylinesIntersect(
+                const PointVec2D& vertices_a,
+                const PointVec2D& vertices_b,
+                bool is_a_closed = false,
+                bool is_b_closed = false);
+
+        /**
+         * @brief Calculate all intersections between two chains of line
+         * segments (e.g. polylines or polygon boundaries). Segment i of a
+         * chain connects vertex i and i+1 (and the last vertex to the first
+         * vertex for closed chains). \n \n
+         * The segments of the longer chain are indexed in a BVH2D so the
+         * complexity is O((n+m) log(n+m) + k) where k is the number of
+         * segment pairs with overlapping bounding boxes.
+         *
+         * @param vertices_a vertices of the first chain
+         * @param vertices_b vertices of the second chain
+         * @param segment_ids pair of segment indices (first chain, second
+         * chain) for each intersection sorted in ascending order
+         * @param intersection_pts intersection point for each pair of segment
+         * indices
+         * @param is_a_closed if the first chain is closed (as in Polygon2D)
+         * @param is_b_closed if the second chain is closed (as in Polygon2D)
+         */
+        static void calcPolylineIntersections(
+                const PointVec2D& vertices_a,
+                const PointVec2D& vertices_b,
+                std::vector<std::pair<size_t, size_t>>& segment_ids,
+                PointVec2D& intersection_pts,
+                bool is_a_closed = false,
+                bool is_b_closed = false);
+
+        /**
+         * @brief Simplify a chain of points with the Ramer-Douglas-Peucker
+         * algorithm. A vertex is only removed if it lies within `tolerance`
+         * of the simplified chain. \n \n
+         * Implemented iteratively with an explicit stack, so it needs O(n)
+         * memory and cannot overflow the call stack for long chains.
+         * Worst case complexity is O(n^2), typically O(n log n).
+         *
+         * @tparam T Point2D or Pose2D (orientation is ignored)
+         * @param points chain of points to be simplified
+         * @param tolerance maximum distance of a removed vertex to the
+         * simplified chain
+         * @param is_closed if an edge from the last to the first point exists
+         * (as in Polygon2D)
+         * @return std::vector<T> subset of input points in input order. For
+         * closed chains which would degenerate to less than 3 vertices the
+         * input points are returned.
+         */
+        template <typename T>
+        static std::vector<T> simplifyDouglasPeucker(
+                const std::vector<T>& points,
+                float tolerance,
+                bool is_closed = false);
+
+        /**
+         * @brief Simplify a chain of points with the Visvalingam-Whyatt
+         * algorithm. Vertices are removed in order of the area of the
+         * triangle they form with their neighbours (their "effective area")
+         * as long as this area is below `area_tolerance`. \n \n
+         * Uses a binary heap, hence O(n log n) time and O(n) memory.
+         *
+         * @tparam T Point2D or Pose2D (orientation is ignored)
+         * @param points chain of points to be simplified
+         * @param area_tolerance effective area below which vertices are
+         * removed
+         * @param is_closed if an edge from the last to the first point exists
+         * (as in Polygon2D)
+         * @return std::vector<T> subset of input points in input order. End
+         * points of open chains are always kept and closed chains keep at
+         * least 3 vertices.
+         */
+        template <typename T>
+        static std::vector<T> simplifyVisvalingamWhyatt(
+                const std::vector<T>& points,
+                float area_tolerance,
+                bool is_closed = false);
+
         /**
          * @brief Convert from Quaternion to Euler angles
          *
@@ -841,6 +1108,25 @@ class Utils
                 float& pitch,
                 float& yaw);
 
+        /**
+         * @brief Convert a float to IEEE 754 half precision (binary16) bits
+         * with round to nearest even. Values beyond the half range become
+         * infinity; NaN stays NaN.
+         *
+         * @param value float to be converted
+         * @return uint16_t half precision bits
+         */
+        static uint16_t convertToFloat16(float value);
+
+        /**
+         * @brief Convert IEEE 754 half precision (binary16) bits to float.
+         * The conversion is exact.
+         *
+         * @param bits half precision bits
+         * @return float converted value
+         */
+        static float convertFromFloat16(uint16_t bits);
+
         /**
          * @brief Convert from Euler to Quaternion angles
          *
@@ -872,6 +1158,21 @@ class Utils
                 const std::vector<Pose2D>& trajectory,
                 const std::string& frame);
 
+        /**
+         * @brief Fill a caller-owned nav_msgs::Path in place. The poses are
+         * resized once and each pose header is copied from path_msg.header
+         * (after its frame_id is set to frame), so reusing the same message
+         * across calls avoids reallocation.
+         *
+         * @param trajectory poses to be converted
+         * @param path_msg output message (header stamp is left untouched)
+         * @param frame frame id of output message
+         */
+        static void convertToROSPath(
+                const std::vector<Pose2D>& trajectory,
+                nav_msgs::Path& path_msg,
+                const std::string& frame);
+
         /**
          * @brief
          * 
@@ -893,6 +1194,56 @@ class Utils
                 float alpha = 1.0f,
                 float line_width = 0.05f);
 
+        /**
+         * @brief Fill a caller-owned LINE_STRIP marker in place with the
+         * positions of a geometric path. The points are resized once.
+         *
+         * @param geometric_path path to be converted
+         * @param marker output marker
+         * @param frame
+         * @param red
+         * @param green
+         * @param blue
+         * @param alpha
+         * @param line_width
+         */
+        static void convertGeometricPathToMarker(
+                const Path& geometric_path,
+                visualization_msgs::Marker& marker,
+                const std::string& frame = "base_link",
+                float red = 1.0f,
+                float green = 0.0f,
+                float blue = 0.0f,
+                float alpha = 1.0f,
+                float line_width = 0.05f);
+
+        /**
+         * @brief Batch many polylines (e.g. candidate trajectories) into a
+         * single caller-owned LINE_LIST marker. Each polyline with n points
+         * contributes n-1 line segments. The points are resized once for all
+         * polylines.
+         *
+         * @tparam T Point2D, Point3D or Pose2D
+         * @param polylines collection of polylines
+         * @param marker output marker
+         * @param frame
+         * @param red
+         * @param green
+         * @param blue
+         * @param alpha
+         * @param line_width
+         */
+        template <typename T>
+        static void convertPolylinesToMarker(
+                const std::vector<std::vector<T>>& polylines,
+                visualization_msgs::Marker& marker,
+                const std::string& frame = "base_link",
+                float red = 1.0f,
+                float green = 0.0f,
+                float blue = 0.0f,
+                float alpha = 1.0f,
+                float line_width = 0.05f);
+
         /**
          * @brief convert PointCloud2D or PointCloud3D to Marker
          *
@@ -917,6 +1268,32 @@ class Utils
                 float blue = 0.0f,
                 float alpha = 1.0f);
 
+        /**
+         * @brief Fill a caller-owned POINTS marker in place with a
+         * PointCloud2D or PointCloud3D. The points are resized once, so
+         * reusing the same marker across calls avoids reallocation.
+         *
+         * @tparam T Point2D or Point3D
+         * @param cloud PointCloud2D or PointCloud3D
+         * @param marker output marker
+         * @param frame
+         * @param diameter
+         * @param red
+         * @param green
+         * @param blue
+         * @param alpha
+         */
+        template <typename T>
+        static void convertPointCloudToMarker(
+                const std::vector<T>& cloud,
+                visualization_msgs::Marker& marker,
+                const std::string& frame = "base_link",
+                float diameter = 0.05f,
+                float red = 1.0f,
+                float green = 0.0f,
+                float blue = 0.0f,
+                float alpha = 1.0f);
+
         /**
          * @brief
          * 
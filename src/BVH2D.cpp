@@ -0,0 +1,439 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <geometry_common/BVH2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+namespace
+{
+
+bool containsPoint(const Polygon2D& polygon, const Point2D& point)
+{
+    return polygon.containsPoint(point);
+}
+
+bool containsPoint(const Polyline2D& polyline, const Point2D& point)
+{
+    if ( polyline.size() == 1 )
+    {
+        return ( polyline[0].distTo(point) < BVH_CONTAINMENT_TOLERANCE );
+    }
+    for ( size_t start = 0, end = 1; end < polyline.size(); start = end++ )
+    {
+        if ( LineSegment2D(polyline[start], polyline[end]).containsPoint(
+                    point, BVH_CONTAINMENT_TOLERANCE) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool containsPoint(const LineSegment2D& line_segment, const Point2D& point)
+{
+    return line_segment.containsPoint(point, BVH_CONTAINMENT_TOLERANCE);
+}
+
+float calcSquaredDistToEdges(const PointVec2D& vertices, const Point2D& point,
+                             bool is_closed)
+{
+    if ( vertices.size() == 1 )
+    {
+        return vertices[0].squaredDistTo(point);
+    }
+
+    float min_squared_dist = std::numeric_limits<float>::max();
+    for ( size_t start = 0, end = 1; end < vertices.size(); start = end++ )
+    {
+        min_squared_dist = std::min(min_squared_dist,
+                LineSegment2D(vertices[start], vertices[end]).squaredMinDistTo(point));
+    }
+    if ( is_closed && vertices.size() > 2 )
+    {
+        min_squared_dist = std::min(min_squared_dist,
+                LineSegment2D(vertices.back(), vertices.front()).squaredMinDistTo(point));
+    }
+    return min_squared_dist;
+}
+
+float calcSquaredDist(const Polygon2D& polygon, const Point2D& point)
+{
+    if ( polygon.containsPoint(point) )
+    {
+        return 0.0f;
+    }
+    return calcSquaredDistToEdges(polygon.vertices, point, true);
+}
+
+float calcSquaredDist(const Polyline2D& polyline, const Point2D& point)
+{
+    return calcSquaredDistToEdges(polyline.vertices, point, false);
+}
+
+float calcSquaredDist(const LineSegment2D& line_segment, const Point2D& point)
+{
+    return line_segment.squaredMinDistTo(point);
+}
+
+Box2D calcInflatedBox(const PointVec2D& points, float inflation_dist)
+{
+    Box2D box(points);
+    box.min_x -= inflation_dist;
+    box.max_x += inflation_dist;
+    box.min_y -= inflation_dist;
+    box.max_y += inflation_dist;
+    return box;
+}
+
+Box2D calcShapeBoundingBox(const Polygon2D& polygon)
+{
+    return Box2D(polygon.vertices);
+}
+
+Box2D calcShapeBoundingBox(const Polyline2D& polyline)
+{
+    return calcInflatedBox(polyline.vertices, BVH_CONTAINMENT_TOLERANCE);
+}
+
+Box2D calcShapeBoundingBox(const LineSegment2D& line_segment)
+{
+    return calcInflatedBox({line_segment.start, line_segment.end},
+                           BVH_CONTAINMENT_TOLERANCE);
+}
+
+struct BuildItem
+{
+    Box2D box;
+    float center_x, center_y;
+    uint32_t index;
+};
+
+uint32_t buildRecursive(std::vector<BuildItem>& items, size_t begin, size_t end,
+                        size_t max_leaf_size, std::vector<BVHNode2D>& nodes)
+{
+    const uint32_t node_index = nodes.size();
+    nodes.push_back(BVHNode2D());
+
+    BVHNode2D node;
+    node.min_x = std::numeric_limits<float>::max();
+    node.min_y = std::numeric_limits<float>::max();
+    node.max_x = std::numeric_limits<float>::lowest();
+    node.max_y = std::numeric_limits<float>::lowest();
+    float center_min_x = std::numeric_limits<float>::max();
+    float center_min_y = std::numeric_limits<float>::max();
+    float center_max_x = std::numeric_limits<float>::lowest();
+    float center_max_y = std::numeric_limits<float>::lowest();
+    for ( size_t i = begin; i < end; i++ )
+    {
+        const BuildItem& item = items[i];
+        node.min_x = std::min(node.min_x, item.box.min_x);
+        node.min_y = std::min(node.min_y, item.box.min_y);
+        node.max_x = std::max(node.max_x, item.box.max_x);
+        node.max_y = std::max(node.max_y, item.box.max_y);
+        center_min_x = std::min(center_min_x, item.center_x);
+        center_min_y = std::min(center_min_y, item.center_y);
+        center_max_x = std::max(center_max_x, item.center_x);
+        center_max_y = std::max(center_max_y, item.center_y);
+    }
+
+    if ( end - begin <= max_leaf_size )
+    {
+        node.first = begin;
+        node.count = end - begin;
+        nodes[node_index] = node;
+        return node_index;
+    }
+
+    // split at the median along the axis with largest spread of centers
+    const size_t mid = begin + (end - begin) / 2;
+    if ( center_max_x - center_min_x >= center_max_y - center_min_y )
+    {
+        std::nth_element(items.begin() + begin, items.begin() + mid,
+                         items.begin() + end,
+                         [](const BuildItem& a, const BuildItem& b)
+                         {
+                             return a.center_x < b.center_x;
+                         });
+    }
+    else
+    {
+        std::nth_element(items.begin() + begin, items.begin() + mid,
+                         items.begin() + end,
+                         [](const BuildItem& a, const BuildItem& b)
+                         {
+                             return a.center_y < b.center_y;
+                         });
+    }
+
+    buildRecursive(items, begin, mid, max_leaf_size, nodes);
+    node.first = buildRecursive(items, mid, end, max_leaf_size, nodes);
+    node.count = 0;
+    nodes[node_index] = node;
+    return node_index;
+}
+
+} // namespace
+
+template <typename T>
+BVH2D<T>::BVH2D(const std::vector<T>& shapes, size_t max_leaf_size)
+{
+    build(shapes, max_leaf_size);
+}
+
+template <typename T>
+void BVH2D<T>::build(const std::vector<T>& shapes, size_t max_leaf_size)
+{
+    nodes_.clear();
+    shapes_.clear();
+    item_indices_.clear();
+    item_positions_.clear();
+    if ( shapes.empty() )
+    {
+        return;
+    }
+
+    std::vector<BuildItem> items(shapes.size());
+    for ( size_t i = 0; i < shapes.size(); i++ )
+    {
+        items[i].box = calcBoundingBox(shapes[i]);
+        items[i].center_x = (items[i].box.min_x + items[i].box.max_x) / 2;
+        items[i].center_y = (items[i].box.min_y + items[i].box.max_y) / 2;
+        items[i].index = i;
+    }
+
+    nodes_.reserve(2 * shapes.size() / std::max<size_t>(max_leaf_size, 1) + 1);
+    buildRecursive(items, 0, items.size(), std::max<size_t>(max_leaf_size, 1),
+                   nodes_);
+
+    shapes_.reserve(shapes.size());
+    item_indices_.resize(shapes.size());
+    item_positions_.resize(shapes.size());
+    for ( size_t i = 0; i < items.size(); i++ )
+    {
+        shapes_.push_back(shapes[items[i].index]);
+        item_indices_[i] = items[i].index;
+        item_positions_[items[i].index] = i;
+    }
+}
+
+template <typename T>
+bool BVH2D<T>::containsPoint(const Point2D& point) const
+{
+    return !BVHNode2D::traverse(nodes_.data(), nodes_.size(),
+            [&point](const BVHNode2D& node)
+            {
+                return node.containsPoint(point);
+            },
+            [this, &point](size_t i)
+            {
+                return !geometry_common::containsPoint(shapes_[i], point);
+            });
+}
+
+template <typename T>
+void BVH2D<T>::calcIndicesContaining(
+        const Point2D& point,
+        std::vector<size_t>& indices) const
+{
+    indices.clear();
+    BVHNode2D::traverse(nodes_.data(), nodes_.size(),
+            [&point](const BVHNode2D& node)
+            {
+                return node.containsPoint(point);
+            },
+            [this, &point, &indices](size_t i)
+            {
+                if ( geometry_common::containsPoint(shapes_[i], point) )
+                {
+                    indices.push_back(item_indices_[i]);
+                }
+                return true;
+            });
+}
+
+template <typename T>
+bool BVH2D<T>::intersects(const LineSegment2D& line_segment) const
+{
+    const Box2D box({line_segment.start, line_segment.end});
+    return !BVHNode2D::traverse(nodes_.data(), nodes_.size(),
+            [&box](const BVHNode2D& node)
+            {
+                return node.intersects(box);
+            },
+            [this, &line_segment](size_t i)
+            {
+                return !shapes_[i].intersects(line_segment);
+            });
+}
+
+template <typename T>
+void BVH2D<T>::calcIndicesIntersecting(
+        const LineSegment2D& line_segment,
+        std::vector<size_t>& indices) const
+{
+    indices.clear();
+    const Box2D box({line_segment.start, line_segment.end});
+    BVHNode2D::traverse(nodes_.data(), nodes_.size(),
+            [&box](const BVHNode2D& node)
+            {
+                return node.intersects(box);
+            },
+            [this, &line_segment, &indices](size_t i)
+            {
+                if ( shapes_[i].intersects(line_segment) )
+                {
+                    indices.push_back(item_indices_[i]);
+                }
+                return true;
+            });
+}
+
+template <typename T>
+void BVH2D<T>::calcIndicesOverlapping(
+        const Box2D& box,
+        std::vector<size_t>& indices) const
+{
+    indices.clear();
+    BVHNode2D::traverse(nodes_.data(), nodes_.size(),
+            [&box](const BVHNode2D& node)
+            {
+                return node.intersects(box);
+            },
+            [this, &box, &indices](size_t i)
+            {
+                const Box2D shape_box = calcBoundingBox(shapes_[i]);
+                if ( shape_box.min_x <= box.max_x && shape_box.max_x >= box.min_x &&
+                     shape_box.min_y <= box.max_y && shape_box.max_y >= box.min_y )
+                {
+                    indices.push_back(item_indices_[i]);
+                }
+                return true;
+            });
+}
+
+template <typename T>
+bool BVH2D<T>::calcNearest(
+        const Point2D& point,
+        size_t& index,
+        float& dist) const
+{
+    if ( nodes_.empty() )
+    {
+        return false;
+    }
+
+    // depth first traversal visiting the closer child first and pruning
+    // subtrees that are farther than the best shape found so far
+    float min_squared_dist = std::numeric_limits<float>::max();
+    bool is_found = false;
+    uint32_t stack[64];
+    size_t stack_size = 0;
+    stack[stack_size++] = 0;
+    while ( stack_size > 0 )
+    {
+        const uint32_t node_index = stack[--stack_size];
+        const BVHNode2D& node = nodes_[node_index];
+        if ( node.squaredDistTo(point) >= min_squared_dist )
+        {
+            continue;
+        }
+
+        if ( node.isLeaf() )
+        {
+            for ( uint32_t i = node.first; i < node.first + node.count; i++ )
+            {
+                float squared_dist = calcSquaredDist(shapes_[i], point);
+                if ( squared_dist < min_squared_dist )
+                {
+                    min_squared_dist = squared_dist;
+                    index = item_indices_[i];
+                    is_found = true;
+                }
+            }
+            continue;
+        }
+
+        const uint32_t left = node_index + 1;
+        const uint32_t right = node.first;
+        if ( nodes_[left].squaredDistTo(point) <= nodes_[right].squaredDistTo(point) )
+        {
+            stack[stack_size++] = right;
+            stack[stack_size++] = left;
+        }
+        else
+        {
+            stack[stack_size++] = left;
+            stack[stack_size++] = right;
+        }
+    }
+    if ( !is_found )
+    {
+        return false; // all shapes are empty
+    }
+    dist = std::sqrt(min_squared_dist);
+    return true;
+}
+
+template <typename T>
+const T& BVH2D<T>::operator [] (size_t index) const
+{
+    return shapes_[item_positions_[index]];
+}
+
+template <typename T>
+Box2D BVH2D<T>::calcBoundingBox(const T& shape)
+{
+    return calcShapeBoundingBox(shape);
+}
+
+template class BVH2D<Polygon2D>;
+template class BVH2D<Polyline2D>;
+template class BVH2D<LineSegment2D>;
+
+} // namespace geometry_common
+} // namespace kelo
@@ -0,0 +1,143 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <geometry_common/BezierCurveEvaluator.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+void BezierCurveEvaluator::calcCurvePoints(
+        const PointVec2D& control_points,
+        size_t num_of_points,
+        PointVec2D& curve_points) const
+{
+    curve_points.clear();
+    if ( control_points.size() < 2 || num_of_points < 2 )
+    {
+        return;
+    }
+
+    const size_t num_of_control_points = control_points.size();
+    const std::vector<float>& weights = basis(num_of_control_points - 1,
+                                              num_of_points);
+    curve_points.resize(num_of_points);
+    for ( size_t j = 0; j < num_of_points; j++ )
+    {
+        const float* row = &weights[j * num_of_control_points];
+        float x = 0.0f;
+        float y = 0.0f;
+        for ( size_t i = 0; i < num_of_control_points; i++ )
+        {
+            x += row[i] * control_points[i].x;
+            y += row[i] * control_points[i].y;
+        }
+        curve_points[j].x = x;
+        curve_points[j].y = y;
+    }
+
+    /* end points are exactly the first and last control points */
+    curve_points.front() = control_points.front();
+    curve_points.back() = control_points.back();
+}
+
+void BezierCurveEvaluator::calcCurvePoints(
+        const std::vector<PointVec2D>& control_points_list,
+        size_t num_of_points,
+        std::vector<PointVec2D>& curves) const
+{
+    curves.resize(control_points_list.size());
+    for ( size_t i = 0; i < control_points_list.size(); i++ )
+    {
+        calcCurvePoints(control_points_list[i], num_of_points, curves[i]);
+    }
+}
+
+const std::vector<float>& BezierCurveEvaluator::basis(
+        size_t order,
+        size_t num_of_points) const
+{
+    const std::pair<size_t, size_t> key(order, num_of_points);
+    std::map<std::pair<size_t, size_t>, std::vector<float>>::const_iterator it =
+        basis_cache_.find(key);
+    if ( it != basis_cache_.end() )
+    {
+        return it->second;
+    }
+
+    const size_t num_of_control_points = order + 1;
+    std::vector<float>& weights = basis_cache_[key];
+    weights.resize(num_of_points * num_of_control_points);
+    std::vector<double> bernstein(num_of_control_points);
+    const double offset = ( num_of_points > 1 ) ? 1.0 / (num_of_points - 1) : 0.0;
+    for ( size_t j = 0; j < num_of_points; j++ )
+    {
+        /**
+         * de Casteljau recurrence of Bernstein polynomials
+         * B(i, n) = (1-t) * B(i, n-1) + t * B(i-1, n-1)
+         */
+        const double t = offset * j;
+        const double one_minus_t = 1.0 - t;
+        bernstein[0] = 1.0;
+        for ( size_t n = 1; n <= order; n++ )
+        {
+            bernstein[n] = t * bernstein[n-1];
+            for ( size_t i = n-1; i > 0; i-- )
+            {
+                bernstein[i] = (one_minus_t * bernstein[i]) + (t * bernstein[i-1]);
+            }
+            bernstein[0] *= one_minus_t;
+        }
+        for ( size_t i = 0; i < num_of_control_points; i++ )
+        {
+            weights[(j * num_of_control_points) + i] = static_cast<float>(bernstein[i]);
+        }
+    }
+    return weights;
+}
+
+void BezierCurveEvaluator::clearCache()
+{
+    basis_cache_.clear();
+}
+
+} // namespace geometry_common
+} // namespace kelo
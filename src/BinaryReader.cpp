@@ -0,0 +1,495 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cstring>
+#include <algorithm>
+#include <geometry_common/Utils.h>
+#include <geometry_common/BinaryReader.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+namespace
+{
+
+/**
+ * @brief Size of stack buffer used for unpacking point clouds
+ */
+const size_t chunk_size = 1024;
+
+inline uint16_t loadUInt16(const uint8_t* src)
+{
+    return static_cast<uint16_t>(src[0] | (src[1] << 8));
+}
+
+inline uint32_t loadUInt32(const uint8_t* src)
+{
+    return static_cast<uint32_t>(src[0]) |
+           (static_cast<uint32_t>(src[1]) << 8) |
+           (static_cast<uint32_t>(src[2]) << 16) |
+           (static_cast<uint32_t>(src[3]) << 24);
+}
+
+inline float loadFloat(const uint8_t* src)
+{
+    const uint32_t bits = loadUInt32(src);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline void setCoordinates(const float* coordinates, Point2D& point)
+{
+    point.x = coordinates[0];
+    point.y = coordinates[1];
+}
+
+inline void setCoordinates(const float* coordinates, Point3D& point)
+{
+    point.x = coordinates[0];
+    point.y = coordinates[1];
+    point.z = coordinates[2];
+}
+
+template <typename T>
+struct Dimensions;
+
+template <>
+struct Dimensions<Point2D>
+{
+    static const size_t value = 2;
+};
+
+template <>
+struct Dimensions<Point3D>
+{
+    static const size_t value = 3;
+};
+
+/**
+ * @brief Smallest encoded size of each type, used to reject corrupted
+ * counts before allocating
+ */
+template <typename T>
+struct MinEncodedSize
+{
+    static const size_t value = 12;
+};
+
+template <> struct MinEncodedSize<LineSegment2D> { static const size_t value = 16; };
+template <> struct MinEncodedSize<Box2D> { static const size_t value = 16; };
+template <> struct MinEncodedSize<Box3D> { static const size_t value = 24; };
+template <> struct MinEncodedSize<Polyline2D> { static const size_t value = 5; };
+template <> struct MinEncodedSize<Polygon2D> { static const size_t value = 5; };
+template <> struct MinEncodedSize<PolygonWithHoles2D> { static const size_t value = 9; };
+
+} // namespace
+
+BinaryReader::BinaryReader(std::istream& stream):
+    stream_(&stream)
+{
+}
+
+BinaryReader::BinaryReader(const uint8_t* data, size_t size):
+    data_(data),
+    size_(size)
+{
+}
+
+BinaryReader::BinaryReader(const std::vector<uint8_t>& buffer):
+    BinaryReader(buffer.data(), buffer.size())
+{
+}
+
+bool BinaryReader::readHeader()
+{
+    uint8_t bytes[6];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    const uint16_t version = loadUInt16(&bytes[4]);
+    if ( std::memcmp(bytes, BinaryWriter::MAGIC, sizeof(BinaryWriter::MAGIC)) != 0 ||
+         version == 0 || version > BinaryWriter::VERSION )
+    {
+        is_good_ = false;
+        return false;
+    }
+    version_ = version;
+    return true;
+}
+
+bool BinaryReader::read(uint32_t& value)
+{
+    uint8_t bytes[4];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    value = loadUInt32(bytes);
+    return true;
+}
+
+bool BinaryReader::read(float& value)
+{
+    uint8_t bytes[4];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    value = loadFloat(bytes);
+    return true;
+}
+
+bool BinaryReader::read(Point2D& point)
+{
+    uint8_t bytes[8];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    point.x = loadFloat(&bytes[0]);
+    point.y = loadFloat(&bytes[4]);
+    return true;
+}
+
+bool BinaryReader::read(Point3D& point)
+{
+    uint8_t bytes[12];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    point.x = loadFloat(&bytes[0]);
+    point.y = loadFloat(&bytes[4]);
+    point.z = loadFloat(&bytes[8]);
+    return true;
+}
+
+bool BinaryReader::read(XYTheta& x_y_theta)
+{
+    uint8_t bytes[12];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    x_y_theta.x = loadFloat(&bytes[0]);
+    x_y_theta.y = loadFloat(&bytes[4]);
+    x_y_theta.theta = loadFloat(&bytes[8]);
+    return true;
+}
+
+bool BinaryReader::read(Pose2D& pose)
+{
+    return read(static_cast<XYTheta&>(pose));
+}
+
+bool BinaryReader::read(Circle& circle)
+{
+    uint8_t bytes[12];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    circle.x = loadFloat(&bytes[0]);
+    circle.y = loadFloat(&bytes[4]);
+    circle.r = loadFloat(&bytes[8]);
+    return true;
+}
+
+bool BinaryReader::read(LineSegment2D& line_segment)
+{
+    uint8_t bytes[16];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    line_segment.start.x = loadFloat(&bytes[0]);
+    line_segment.start.y = loadFloat(&bytes[4]);
+    line_segment.end.x = loadFloat(&bytes[8]);
+    line_segment.end.y = loadFloat(&bytes[12]);
+    return true;
+}
+
+bool BinaryReader::read(Box2D& box)
+{
+    uint8_t bytes[16];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    box.min_x = loadFloat(&bytes[0]);
+    box.max_x = loadFloat(&bytes[4]);
+    box.min_y = loadFloat(&bytes[8]);
+    box.max_y = loadFloat(&bytes[12]);
+    return true;
+}
+
+bool BinaryReader::read(Box3D& box)
+{
+    uint8_t bytes[24];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    box.min_x = loadFloat(&bytes[0]);
+    box.max_x = loadFloat(&bytes[4]);
+    box.min_y = loadFloat(&bytes[8]);
+    box.max_y = loadFloat(&bytes[12]);
+    box.min_z = loadFloat(&bytes[16]);
+    box.max_z = loadFloat(&bytes[20]);
+    return true;
+}
+
+bool BinaryReader::read(Polyline2D& polyline)
+{
+    return read(polyline.vertices);
+}
+
+bool BinaryReader::read(Polygon2D& polygon)
+{
+    return read(polygon.vertices);
+}
+
+bool BinaryReader::read(PolygonWithHoles2D& polygon_with_holes)
+{
+    return ( read(polygon_with_holes.boundary) &&
+             read(polygon_with_holes.holes) );
+}
+
+bool BinaryReader::read(TransformMatrix2D& tf_mat)
+{
+    uint8_t bytes[12];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    tf_mat.update(loadFloat(&bytes[0]), loadFloat(&bytes[4]), loadFloat(&bytes[8]));
+    return true;
+}
+
+bool BinaryReader::read(TransformMatrix3D& tf_mat)
+{
+    uint8_t bytes[28];
+    if ( !readBytes(bytes, sizeof(bytes)) )
+    {
+        return false;
+    }
+    tf_mat.update(loadFloat(&bytes[0]), loadFloat(&bytes[4]), loadFloat(&bytes[8]),
+                  loadFloat(&bytes[12]), loadFloat(&bytes[16]),
+                  loadFloat(&bytes[20]), loadFloat(&bytes[24]));
+    return true;
+}
+
+bool BinaryReader::read(PointCloud2D& cloud)
+{
+    return readCloud(cloud);
+}
+
+bool BinaryReader::read(PointCloud3D& cloud)
+{
+    return readCloud(cloud);
+}
+
+template <typename T>
+bool BinaryReader::read(std::vector<T>& values)
+{
+    uint32_t size;
+    if ( !read(size) )
+    {
+        return false;
+    }
+    if ( !canRead(size * MinEncodedSize<T>::value) )
+    {
+        is_good_ = false;
+        return false;
+    }
+    /* grow as data arrives; the size check above can not bound a stream */
+    values.clear();
+    values.reserve(( stream_ != nullptr ) ? std::min<size_t>(size, chunk_size) : size);
+    for ( size_t i = 0; i < size; i++ )
+    {
+        values.emplace_back();
+        if ( !read(values.back()) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+template bool BinaryReader::read(std::vector<Pose2D>& values);
+template bool BinaryReader::read(std::vector<XYTheta>& values);
+template bool BinaryReader::read(std::vector<Circle>& values);
+template bool BinaryReader::read(std::vector<LineSegment2D>& values);
+template bool BinaryReader::read(std::vector<Box2D>& values);
+template bool BinaryReader::read(std::vector<Box3D>& values);
+template bool BinaryReader::read(std::vector<Polyline2D>& values);
+template bool BinaryReader::read(std::vector<Polygon2D>& values);
+template bool BinaryReader::read(std::vector<PolygonWithHoles2D>& values);
+
+bool BinaryReader::good() const
+{
+    return is_good_;
+}
+
+uint16_t BinaryReader::version() const
+{
+    return version_;
+}
+
+size_t BinaryReader::bytesRead() const
+{
+    return bytes_read_;
+}
+
+bool BinaryReader::readBytes(uint8_t* bytes, size_t size)
+{
+    if ( !is_good_ )
+    {
+        return false;
+    }
+    if ( stream_ != nullptr )
+    {
+        stream_->read(reinterpret_cast<char*>(bytes), size);
+        is_good_ = ( static_cast<size_t>(stream_->gcount()) == size );
+    }
+    else
+    {
+        is_good_ = canRead(size);
+        if ( is_good_ )
+        {
+            std::memcpy(bytes, data_ + bytes_read_, size);
+        }
+    }
+    if ( is_good_ )
+    {
+        bytes_read_ += size;
+    }
+    return is_good_;
+}
+
+bool BinaryReader::canRead(size_t size) const
+{
+    return ( stream_ != nullptr || size <= size_ - bytes_read_ );
+}
+
+template <typename T>
+bool BinaryReader::readCloud(std::vector<T>& cloud)
+{
+    const size_t dims = Dimensions<T>::value;
+    uint8_t chunk[chunk_size];
+    if ( !readBytes(chunk, 5) )
+    {
+        return false;
+    }
+    const CloudEncoding encoding = static_cast<CloudEncoding>(chunk[0]);
+    const size_t size = loadUInt32(&chunk[1]);
+    if ( encoding != CloudEncoding::FLOAT32 &&
+         encoding != CloudEncoding::FLOAT16 &&
+         encoding != CloudEncoding::QUANTISED_INT16 )
+    {
+        is_good_ = false;
+        return false;
+    }
+
+    float resolution = 0.0f;
+    float min_coordinates[dims] = {};
+    if ( encoding == CloudEncoding::QUANTISED_INT16 )
+    {
+        if ( !readBytes(chunk, (dims + 1) * 4) )
+        {
+            return false;
+        }
+        resolution = loadFloat(chunk);
+        for ( size_t j = 0; j < dims; j++ )
+        {
+            min_coordinates[j] = loadFloat(&chunk[4 * (j + 1)]);
+        }
+    }
+
+    const size_t bytes_per_value = ( encoding == CloudEncoding::FLOAT32 ) ? 4 : 2;
+    if ( !canRead(size * dims * bytes_per_value) )
+    {
+        is_good_ = false;
+        return false;
+    }
+    const size_t points_per_chunk = chunk_size / (dims * bytes_per_value);
+
+    /* grow chunk by chunk as data arrives; the size check above can not
+     * bound a stream */
+    cloud.clear();
+    cloud.reserve(( stream_ != nullptr ) ? std::min(size, points_per_chunk) : size);
+    float coordinates[dims];
+    for ( size_t start = 0; start < size; start += points_per_chunk )
+    {
+        const size_t end = std::min(start + points_per_chunk, size);
+        if ( !readBytes(chunk, (end - start) * dims * bytes_per_value) )
+        {
+            return false;
+        }
+        cloud.resize(end);
+        const uint8_t* src = chunk;
+        for ( size_t i = start; i < end; i++ )
+        {
+            for ( size_t j = 0; j < dims; j++, src += bytes_per_value )
+            {
+                if ( encoding == CloudEncoding::FLOAT32 )
+                {
+                    coordinates[j] = loadFloat(src);
+                }
+                else if ( encoding == CloudEncoding::FLOAT16 )
+                {
+                    coordinates[j] = Utils::convertFromFloat16(loadUInt16(src));
+                }
+                else
+                {
+                    coordinates[j] = min_coordinates[j] + (loadUInt16(src) * resolution);
+                }
+            }
+            setCoordinates(coordinates, cloud[i]);
+        }
+    }
+    return true;
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -0,0 +1,439 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+#include <geometry_common/Utils.h>
+#include <geometry_common/BinaryWriter.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+const uint16_t BinaryWriter::VERSION;
+const uint8_t BinaryWriter::MAGIC[4] = {'K', 'G', 'C', 'B'};
+
+namespace
+{
+
+/**
+ * @brief Size of stack buffer used for packing point clouds
+ */
+const size_t chunk_size = 1024;
+
+inline void storeUInt16(uint16_t value, uint8_t* dest)
+{
+    dest[0] = value & 0xffu;
+    dest[1] = (value >> 8) & 0xffu;
+}
+
+inline void storeUInt32(uint32_t value, uint8_t* dest)
+{
+    dest[0] = value & 0xffu;
+    dest[1] = (value >> 8) & 0xffu;
+    dest[2] = (value >> 16) & 0xffu;
+    dest[3] = (value >> 24) & 0xffu;
+}
+
+inline void storeFloat(float value, uint8_t* dest)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    storeUInt32(bits, dest);
+}
+
+inline void getCoordinates(const Point2D& point, float* coordinates)
+{
+    coordinates[0] = point.x;
+    coordinates[1] = point.y;
+}
+
+inline void getCoordinates(const Point3D& point, float* coordinates)
+{
+    coordinates[0] = point.x;
+    coordinates[1] = point.y;
+    coordinates[2] = point.z;
+}
+
+template <typename T>
+struct Dimensions;
+
+template <>
+struct Dimensions<Point2D>
+{
+    static const size_t value = 2;
+};
+
+template <>
+struct Dimensions<Point3D>
+{
+    static const size_t value = 3;
+};
+
+} // namespace
+
+BinaryWriter::BinaryWriter(std::ostream& stream):
+    stream_(&stream)
+{
+}
+
+BinaryWriter::BinaryWriter(std::vector<uint8_t>& buffer):
+    buffer_(&buffer)
+{
+}
+
+bool BinaryWriter::writeHeader()
+{
+    uint8_t bytes[6];
+    std::memcpy(bytes, MAGIC, sizeof(MAGIC));
+    storeUInt16(VERSION, &bytes[4]);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(uint32_t value)
+{
+    uint8_t bytes[4];
+    storeUInt32(value, bytes);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(float value)
+{
+    uint8_t bytes[4];
+    storeFloat(value, bytes);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(const Point2D& point)
+{
+    uint8_t bytes[8];
+    storeFloat(point.x, &bytes[0]);
+    storeFloat(point.y, &bytes[4]);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(const Point3D& point)
+{
+    uint8_t bytes[12];
+    storeFloat(point.x, &bytes[0]);
+    storeFloat(point.y, &bytes[4]);
+    storeFloat(point.z, &bytes[8]);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(const XYTheta& x_y_theta)
+{
+    uint8_t bytes[12];
+    storeFloat(x_y_theta.x, &bytes[0]);
+    storeFloat(x_y_theta.y, &bytes[4]);
+    storeFloat(x_y_theta.theta, &bytes[8]);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(const Pose2D& pose)
+{
+    return write(static_cast<const XYTheta&>(pose));
+}
+
+bool BinaryWriter::write(const Circle& circle)
+{
+    uint8_t bytes[12];
+    storeFloat(circle.x, &bytes[0]);
+    storeFloat(circle.y, &bytes[4]);
+    storeFloat(circle.r, &bytes[8]);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(const LineSegment2D& line_segment)
+{
+    uint8_t bytes[16];
+    storeFloat(line_segment.start.x, &bytes[0]);
+    storeFloat(line_segment.start.y, &bytes[4]);
+    storeFloat(line_segment.end.x, &bytes[8]);
+    storeFloat(line_segment.end.y, &bytes[12]);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(const Box2D& box)
+{
+    uint8_t bytes[16];
+    storeFloat(box.min_x, &bytes[0]);
+    storeFloat(box.max_x, &bytes[4]);
+    storeFloat(box.min_y, &bytes[8]);
+    storeFloat(box.max_y, &bytes[12]);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(const Box3D& box)
+{
+    uint8_t bytes[24];
+    storeFloat(box.min_x, &bytes[0]);
+    storeFloat(box.max_x, &bytes[4]);
+    storeFloat(box.min_y, &bytes[8]);
+    storeFloat(box.max_y, &bytes[12]);
+    storeFloat(box.min_z, &bytes[16]);
+    storeFloat(box.max_z, &bytes[20]);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(const Polyline2D& polyline)
+{
+    return write(polyline.vertices);
+}
+
+bool BinaryWriter::write(const Polygon2D& polygon)
+{
+    return write(polygon.vertices);
+}
+
+bool BinaryWriter::write(const PolygonWithHoles2D& polygon_with_holes)
+{
+    return ( write(polygon_with_holes.boundary) &&
+             write(polygon_with_holes.holes) );
+}
+
+bool BinaryWriter::write(const TransformMatrix2D& tf_mat)
+{
+    uint8_t bytes[12];
+    storeFloat(tf_mat.x(), &bytes[0]);
+    storeFloat(tf_mat.y(), &bytes[4]);
+    storeFloat(tf_mat.theta(), &bytes[8]);
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(const TransformMatrix3D& tf_mat)
+{
+    const std::array<float, 4> q = tf_mat.quaternion();
+    uint8_t bytes[28];
+    storeFloat(tf_mat.x(), &bytes[0]);
+    storeFloat(tf_mat.y(), &bytes[4]);
+    storeFloat(tf_mat.z(), &bytes[8]);
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        storeFloat(q[i], &bytes[12 + (4 * i)]);
+    }
+    writeBytes(bytes, sizeof(bytes));
+    return is_good_;
+}
+
+bool BinaryWriter::write(
+        const PointCloud2D& cloud,
+        CloudEncoding encoding,
+        float resolution)
+{
+    return writeCloud(cloud, encoding, resolution);
+}
+
+bool BinaryWriter::write(
+        const PointCloud3D& cloud,
+        CloudEncoding encoding,
+        float resolution)
+{
+    return writeCloud(cloud, encoding, resolution);
+}
+
+template <typename T>
+bool BinaryWriter::write(const std::vector<T>& values)
+{
+    write(static_cast<uint32_t>(values.size()));
+    for ( const T& value : values )
+    {
+        if ( !write(value) )
+        {
+            return false;
+        }
+    }
+    return is_good_;
+}
+template bool BinaryWriter::write(const std::vector<Pose2D>& values);
+template bool BinaryWriter::write(const std::vector<XYTheta>& values);
+template bool BinaryWriter::write(const std::vector<Circle>& values);
+template bool BinaryWriter::write(const std::vector<LineSegment2D>& values);
+template bool BinaryWriter::write(const std::vector<Box2D>& values);
+template bool BinaryWriter::write(const std::vector<Box3D>& values);
+template bool BinaryWriter::write(const std::vector<Polyline2D>& values);
+template bool BinaryWriter::write(const std::vector<Polygon2D>& values);
+template bool BinaryWriter::write(const std::vector<PolygonWithHoles2D>& values);
+
+bool BinaryWriter::good() const
+{
+    return is_good_;
+}
+
+size_t BinaryWriter::bytesWritten() const
+{
+    return bytes_written_;
+}
+
+void BinaryWriter::writeBytes(const uint8_t* bytes, size_t size)
+{
+    if ( buffer_ != nullptr )
+    {
+        buffer_->insert(buffer_->end(), bytes, bytes + size);
+    }
+    else
+    {
+        stream_->write(reinterpret_cast<const char*>(bytes), size);
+        is_good_ = is_good_ && stream_->good();
+    }
+    bytes_written_ += size;
+}
+
+void BinaryWriter::reserve(size_t size)
+{
+    /* keep the geometric growth of the buffer; reserving the exact size
+     * would reallocate on every following write */
+    if ( buffer_ != nullptr && buffer_->size() + size > buffer_->capacity() )
+    {
+        buffer_->reserve(std::max(2 * buffer_->capacity(), buffer_->size() + size));
+    }
+}
+
+template <typename T>
+bool BinaryWriter::writeCloud(
+        const std::vector<T>& cloud,
+        CloudEncoding encoding,
+        float resolution)
+{
+    const size_t dims = Dimensions<T>::value;
+    float coordinates[dims];
+    float min_coordinates[dims] = {};
+
+    if ( encoding == CloudEncoding::QUANTISED_INT16 )
+    {
+        /* fall back to FLOAT32 if cloud can not be represented */
+        float max_coordinates[dims];
+        for ( size_t j = 0; j < dims; j++ )
+        {
+            min_coordinates[j] = std::numeric_limits<float>::max();
+            max_coordinates[j] = std::numeric_limits<float>::lowest();
+        }
+        bool is_valid = ( resolution > 0.0f && std::isfinite(resolution) );
+        for ( size_t i = 0; i < cloud.size() && is_valid; i++ )
+        {
+            getCoordinates(cloud[i], coordinates);
+            for ( size_t j = 0; j < dims; j++ )
+            {
+                is_valid = is_valid && std::isfinite(coordinates[j]);
+                min_coordinates[j] = std::min(min_coordinates[j], coordinates[j]);
+                max_coordinates[j] = std::max(max_coordinates[j], coordinates[j]);
+            }
+        }
+        for ( size_t j = 0; j < dims && is_valid && !cloud.empty(); j++ )
+        {
+            is_valid = ( std::round((max_coordinates[j] - min_coordinates[j]) / resolution)
+                         <= std::numeric_limits<uint16_t>::max() );
+        }
+        if ( !is_valid )
+        {
+            encoding = CloudEncoding::FLOAT32;
+        }
+    }
+    else if ( encoding != CloudEncoding::FLOAT16 )
+    {
+        encoding = CloudEncoding::FLOAT32;
+    }
+
+    const size_t bytes_per_value = ( encoding == CloudEncoding::FLOAT32 ) ? 4 : 2;
+    const size_t points_per_chunk = chunk_size / (dims * bytes_per_value);
+    reserve(5 + ((dims + 1) * 4) + (cloud.size() * dims * bytes_per_value));
+
+    uint8_t chunk[chunk_size];
+    chunk[0] = static_cast<uint8_t>(encoding);
+    storeUInt32(cloud.size(), &chunk[1]);
+    size_t header_size = 5;
+    if ( encoding == CloudEncoding::QUANTISED_INT16 )
+    {
+        storeFloat(resolution, &chunk[header_size]);
+        header_size += 4;
+        for ( size_t j = 0; j < dims; j++ )
+        {
+            storeFloat(min_coordinates[j], &chunk[header_size]);
+            header_size += 4;
+        }
+    }
+    writeBytes(chunk, header_size);
+
+    for ( size_t start = 0; start < cloud.size(); start += points_per_chunk )
+    {
+        const size_t end = std::min(start + points_per_chunk, cloud.size());
+        uint8_t* dest = chunk;
+        for ( size_t i = start; i < end; i++ )
+        {
+            getCoordinates(cloud[i], coordinates);
+            for ( size_t j = 0; j < dims; j++, dest += bytes_per_value )
+            {
+                if ( encoding == CloudEncoding::FLOAT32 )
+                {
+                    storeFloat(coordinates[j], dest);
+                }
+                else if ( encoding == CloudEncoding::FLOAT16 )
+                {
+                    storeUInt16(Utils::convertToFloat16(coordinates[j]), dest);
+                }
+                else
+                {
+                    storeUInt16(static_cast<uint16_t>(std::round(
+                                (coordinates[j] - min_coordinates[j]) / resolution)),
+                                dest);
+                }
+            }
+        }
+        writeBytes(chunk, dest - chunk);
+    }
+    return is_good_;
+}
+
+} // namespace geometry_common
+} // namespace kelo
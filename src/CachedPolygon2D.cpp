@@ -0,0 +1,166 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+
+#include <geometry_common/CachedPolygon2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+void CachedPolygon2D::updatePolygon(const Polygon2D& polygon)
+{
+    polygon_ = polygon;
+    invalidateCache();
+}
+
+void CachedPolygon2D::setVertex(unsigned int index, const Point2D& vertex)
+{
+    polygon_[index] = vertex;
+    invalidateCache();
+}
+
+void CachedPolygon2D::invalidateCache()
+{
+    is_bounding_box_valid_ = false;
+    is_area_valid_ = false;
+    is_centroid_valid_ = false;
+    is_mean_point_valid_ = false;
+    is_convexity_valid_ = false;
+}
+
+const Box2D& CachedPolygon2D::boundingBox() const
+{
+    if ( !is_bounding_box_valid_ )
+    {
+        bounding_box_ = Box2D(polygon_);
+        is_bounding_box_valid_ = true;
+    }
+    return bounding_box_;
+}
+
+float CachedPolygon2D::area() const
+{
+    if ( !is_area_valid_ )
+    {
+        area_ = polygon_.area();
+        is_area_valid_ = true;
+    }
+    return area_;
+}
+
+const Point2D& CachedPolygon2D::centroid() const
+{
+    if ( !is_centroid_valid_ )
+    {
+        centroid_ = polygon_.centroid();
+        is_centroid_valid_ = true;
+    }
+    return centroid_;
+}
+
+const Point2D& CachedPolygon2D::meanPoint() const
+{
+    if ( !is_mean_point_valid_ )
+    {
+        mean_point_ = polygon_.meanPoint();
+        is_mean_point_valid_ = true;
+    }
+    return mean_point_;
+}
+
+WindingOrder CachedPolygon2D::windingOrder() const
+{
+    const float signed_area = area();
+    return ( signed_area > 0.0f ) ? WindingOrder::COUNTER_CLOCKWISE :
+           ( signed_area < 0.0f ) ? WindingOrder::CLOCKWISE :
+                                    WindingOrder::COLLINEAR;
+}
+
+bool CachedPolygon2D::isConvex() const
+{
+    if ( !is_convexity_valid_ )
+    {
+        is_convex_ = polygon_.isConvex();
+        is_convexity_valid_ = true;
+    }
+    return is_convex_;
+}
+
+bool CachedPolygon2D::containsPoint(const Point2D& point) const
+{
+    return ( boundingBox().containsPoint(point) && polygon_.containsPoint(point) );
+}
+
+bool CachedPolygon2D::containsAnyPoint(const PointVec2D& points) const
+{
+    for ( const Point2D& pt : points )
+    {
+        if ( containsPoint(pt) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool CachedPolygon2D::intersects(const LineSegment2D& line_segment) const
+{
+    const Box2D& box = boundingBox();
+    if ( std::max(line_segment.start.x, line_segment.end.x) < box.min_x ||
+         std::min(line_segment.start.x, line_segment.end.x) > box.max_x ||
+         std::max(line_segment.start.y, line_segment.end.y) < box.min_y ||
+         std::min(line_segment.start.y, line_segment.end.y) > box.max_y )
+    {
+        return false;
+    }
+    return polygon_.intersects(line_segment);
+}
+
+std::ostream& operator << (std::ostream& out, const CachedPolygon2D& polygon)
+{
+    out << polygon.polygon_;
+    return out;
+}
+
+} // namespace geometry_common
+} // namespace kelo
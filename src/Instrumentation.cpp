@@ -0,0 +1,401 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include <geometry_common/Instrumentation.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+const size_t Instrumentation::MAX_NUM_OF_PROBES = 128;
+/* 8 exact buckets below 8ns, then 8 buckets for each power of two up to 2^63 */
+const size_t Instrumentation::NUM_OF_BUCKETS = 8 + (61 * 8);
+
+namespace
+{
+
+/**
+ * Only the owning thread (or, for retired counters, the holder of the
+ * registry mutex) writes to the counters, so plain load + store is enough and
+ * no atomic read-modify-write is needed. The atomics only make the concurrent
+ * reads of takeSnapshot well defined.
+ */
+inline void add(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value,
+                  std::memory_order_relaxed);
+}
+
+struct ProbeData
+{
+    std::atomic<uint64_t> num_of_calls;
+    std::atomic<uint64_t> num_of_elements;
+    std::atomic<uint64_t> total_latency_ns;
+    std::atomic<uint64_t> max_latency_ns;
+    std::unique_ptr<std::atomic<uint64_t>[]> latency_histogram;
+
+    ProbeData():
+        num_of_calls(0),
+        num_of_elements(0),
+        total_latency_ns(0),
+        max_latency_ns(0),
+        latency_histogram(new std::atomic<uint64_t>[Instrumentation::NUM_OF_BUCKETS])
+    {
+        for ( size_t i = 0; i < Instrumentation::NUM_OF_BUCKETS; i++ )
+        {
+            latency_histogram[i].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+inline void addMax(std::atomic<uint64_t>& counter, uint64_t value)
+{
+    if ( value > counter.load(std::memory_order_relaxed) )
+    {
+        counter.store(value, std::memory_order_relaxed);
+    }
+}
+
+struct ThreadData
+{
+    /// allocated lazily by the owning thread on the first call of a probe
+    std::unique_ptr<std::atomic<ProbeData*>[]> probes;
+
+    ThreadData():
+        probes(new std::atomic<ProbeData*>[Instrumentation::MAX_NUM_OF_PROBES])
+    {
+        for ( size_t i = 0; i < Instrumentation::MAX_NUM_OF_PROBES; i++ )
+        {
+            probes[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~ThreadData()
+    {
+        for ( size_t i = 0; i < Instrumentation::MAX_NUM_OF_PROBES; i++ )
+        {
+            delete probes[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Get the counters of a probe, allocating them on first use. Must
+     * only be called by the thread writing to this object.
+     */
+    ProbeData& probe(size_t probe_id)
+    {
+        ProbeData* probe = probes[probe_id].load(std::memory_order_relaxed);
+        if ( probe == nullptr )
+        {
+            probe = new ProbeData();
+            probes[probe_id].store(probe, std::memory_order_release);
+        }
+        return *probe;
+    }
+};
+
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::string> probe_names;
+    /// threads that are currently running and have recorded at least once
+    std::vector<ThreadData*> threads;
+    /// accumulated measurements of all threads that have exited
+    ThreadData retired;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+/**
+ * @brief Owner of the measurements of one thread. When the thread exits they
+ * are folded into Registry::retired, so that memory does not grow with the
+ * number of threads ever created.
+ */
+struct ThreadDataOwner
+{
+    ThreadData* data{nullptr};
+
+    ~ThreadDataOwner()
+    {
+        if ( data == nullptr )
+        {
+            return;
+        }
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for ( size_t i = 0; i < Instrumentation::MAX_NUM_OF_PROBES; i++ )
+        {
+            const ProbeData* probe = data->probes[i].load(std::memory_order_relaxed);
+            if ( probe == nullptr )
+            {
+                continue;
+            }
+            ProbeData& retired = reg.retired.probe(i);
+            add(retired.num_of_calls, probe->num_of_calls.load(std::memory_order_relaxed));
+            add(retired.num_of_elements, probe->num_of_elements.load(std::memory_order_relaxed));
+            add(retired.total_latency_ns, probe->total_latency_ns.load(std::memory_order_relaxed));
+            addMax(retired.max_latency_ns, probe->max_latency_ns.load(std::memory_order_relaxed));
+            for ( size_t j = 0; j < Instrumentation::NUM_OF_BUCKETS; j++ )
+            {
+                add(retired.latency_histogram[j],
+                    probe->latency_histogram[j].load(std::memory_order_relaxed));
+            }
+        }
+        reg.threads.erase(std::find(reg.threads.begin(), reg.threads.end(), data));
+        delete data;
+    }
+};
+
+thread_local ThreadDataOwner current_thread_data;
+
+/// value must be non zero
+size_t calcMostSignificantBit(uint64_t value)
+{
+#ifdef __GNUC__
+    return 63 - __builtin_clzll(value);
+#else
+    size_t msb = 0;
+    while ( value >>= 1 )
+    {
+        msb++;
+    }
+    return msb;
+#endif
+}
+
+} // namespace
+
+float ProbeSnapshot::calcMeanLatency() const
+{
+    return ( num_of_calls == 0 )
+           ? 0.0f
+           : static_cast<float>(total_latency_ns) / num_of_calls;
+}
+
+uint64_t ProbeSnapshot::calcPercentileLatency(float percentile) const
+{
+    if ( num_of_calls == 0 )
+    {
+        return 0;
+    }
+
+    const uint64_t target = std::max(static_cast<uint64_t>(1),
+            static_cast<uint64_t>(std::ceil(num_of_calls * percentile / 100.0f)));
+    uint64_t num_of_calls_so_far = 0;
+    for ( size_t i = 0; i < latency_histogram.size(); i++ )
+    {
+        num_of_calls_so_far += latency_histogram[i];
+        if ( num_of_calls_so_far >= target )
+        {
+            return std::min(Instrumentation::calcBucketUpperBound(i), max_latency_ns);
+        }
+    }
+    return max_latency_ns;
+}
+
+std::ostream& operator << (std::ostream& out, const ProbeSnapshot& snapshot)
+{
+    out << "<name: " << snapshot.name
+        << ", calls: " << snapshot.num_of_calls
+        << ", elements: " << snapshot.num_of_elements
+        << ", mean_ns: " << snapshot.calcMeanLatency()
+        << ", p50_ns: " << snapshot.calcPercentileLatency(50.0f)
+        << ", p99_ns: " << snapshot.calcPercentileLatency(99.0f)
+        << ", max_ns: " << snapshot.max_latency_ns << ">";
+    return out;
+}
+
+bool Instrumentation::isEnabled()
+{
+#ifdef GEOMETRY_COMMON_ENABLE_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+size_t Instrumentation::registerProbe(const std::string& name)
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for ( size_t i = 0; i < reg.probe_names.size(); i++ )
+    {
+        if ( reg.probe_names[i] == name )
+        {
+            return i;
+        }
+    }
+    if ( reg.probe_names.size() >= Instrumentation::MAX_NUM_OF_PROBES )
+    {
+        return Instrumentation::MAX_NUM_OF_PROBES;
+    }
+    reg.probe_names.push_back(name);
+    return reg.probe_names.size() - 1;
+}
+
+void Instrumentation::record(
+        size_t probe_id,
+        uint64_t latency_ns,
+        size_t num_of_elements)
+{
+    if ( probe_id >= Instrumentation::MAX_NUM_OF_PROBES )
+    {
+        return;
+    }
+
+    if ( current_thread_data.data == nullptr )
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        current_thread_data.data = new ThreadData();
+        reg.threads.push_back(current_thread_data.data);
+    }
+
+    ProbeData& probe = current_thread_data.data->probe(probe_id);
+    add(probe.num_of_calls, 1);
+    add(probe.num_of_elements, num_of_elements);
+    add(probe.total_latency_ns, latency_ns);
+    add(probe.latency_histogram[Instrumentation::calcBucketIndex(latency_ns)], 1);
+    addMax(probe.max_latency_ns, latency_ns);
+}
+
+std::vector<ProbeSnapshot> Instrumentation::takeSnapshot()
+{
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    std::vector<const ThreadData*> threads(reg.threads.begin(), reg.threads.end());
+    threads.push_back(&reg.retired);
+
+    std::vector<ProbeSnapshot> snapshots;
+    for ( size_t i = 0; i < reg.probe_names.size(); i++ )
+    {
+        ProbeSnapshot snapshot;
+        snapshot.name = reg.probe_names[i];
+        snapshot.latency_histogram.resize(Instrumentation::NUM_OF_BUCKETS, 0);
+        for ( const ThreadData* thread : threads )
+        {
+            const ProbeData* probe = thread->probes[i].load(std::memory_order_acquire);
+            if ( probe == nullptr )
+            {
+                continue;
+            }
+            snapshot.num_of_calls += probe->num_of_calls.load(std::memory_order_relaxed);
+            snapshot.num_of_elements += probe->num_of_elements.load(std::memory_order_relaxed);
+            snapshot.total_latency_ns += probe->total_latency_ns.load(std::memory_order_relaxed);
+            snapshot.max_latency_ns = std::max(snapshot.max_latency_ns,
+                    probe->max_latency_ns.load(std::memory_order_relaxed));
+            for ( size_t j = 0; j < Instrumentation::NUM_OF_BUCKETS; j++ )
+            {
+                snapshot.latency_histogram[j] +=
+                    probe->latency_histogram[j].load(std::memory_order_relaxed);
+            }
+        }
+        if ( snapshot.num_of_calls > 0 )
+        {
+            snapshots.push_back(snapshot);
+        }
+    }
+    return snapshots;
+}
+
+std::vector<std::pair<std::string, std::string>> Instrumentation::convertToKeyValues(
+        const std::vector<ProbeSnapshot>& snapshots)
+{
+    std::vector<std::pair<std::string, std::string>> key_values;
+    key_values.reserve(snapshots.size() * 6);
+    for ( const ProbeSnapshot& snapshot : snapshots )
+    {
+        key_values.push_back(std::make_pair(snapshot.name + "/calls",
+                    std::to_string(snapshot.num_of_calls)));
+        key_values.push_back(std::make_pair(snapshot.name + "/elements",
+                    std::to_string(snapshot.num_of_elements)));
+        key_values.push_back(std::make_pair(snapshot.name + "/mean_ns",
+                    std::to_string(snapshot.calcMeanLatency())));
+        key_values.push_back(std::make_pair(snapshot.name + "/p50_ns",
+                    std::to_string(snapshot.calcPercentileLatency(50.0f))));
+        key_values.push_back(std::make_pair(snapshot.name + "/p99_ns",
+                    std::to_string(snapshot.calcPercentileLatency(99.0f))));
+        key_values.push_back(std::make_pair(snapshot.name + "/max_ns",
+                    std::to_string(snapshot.max_latency_ns)));
+    }
+    return key_values;
+}
+
+size_t Instrumentation::calcBucketIndex(uint64_t latency_ns)
+{
+    if ( latency_ns < 8 )
+    {
+        return latency_ns;
+    }
+    const size_t msb = calcMostSignificantBit(latency_ns);
+    const size_t sub_bucket = (latency_ns >> (msb - 3)) - 8;
+    return 8 + ((msb - 3) * 8) + sub_bucket;
+}
+
+uint64_t Instrumentation::calcBucketUpperBound(size_t bucket_index)
+{
+    if ( bucket_index < 8 )
+    {
+        return bucket_index;
+    }
+    if ( bucket_index >= Instrumentation::NUM_OF_BUCKETS - 1 )
+    {
+        return UINT64_MAX;
+    }
+    const size_t shift = (bucket_index - 8) / 8;
+    const uint64_t sub_bucket = ((bucket_index - 8) % 8) + 8;
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -0,0 +1,368 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+#include <geometry_common/KDTree.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+namespace
+{
+
+inline size_t numOfDims(const Point2D& /*point*/)
+{
+    return 2;
+}
+
+inline size_t numOfDims(const Point3D& /*point*/)
+{
+    return 3;
+}
+
+inline float getCoord(const Point2D& point, size_t axis)
+{
+    return ( axis == 0 ) ? point.x : point.y;
+}
+
+inline float getCoord(const Point3D& point, size_t axis)
+{
+    return ( axis == 0 ) ? point.x : ( axis == 1 ) ? point.y : point.z;
+}
+
+inline float calcSquaredDist(const Point2D& a, const Point2D& b)
+{
+    const float dx = a.x - b.x;
+    const float dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+inline float calcSquaredDist(const Point3D& a, const Point3D& b)
+{
+    const float dx = a.x - b.x;
+    const float dy = a.y - b.y;
+    const float dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+template <typename T>
+uint32_t buildRecursive(const std::vector<T>& points, std::vector<uint32_t>& order,
+                        size_t begin, size_t end, size_t max_leaf_size,
+                        std::vector<KDTreeNode>& nodes)
+{
+    const uint32_t node_index = nodes.size();
+    nodes.push_back(KDTreeNode());
+
+    KDTreeNode node;
+    node.split = 0.0f;
+    node.axis = 0;
+    if ( end - begin <= max_leaf_size )
+    {
+        node.first = begin;
+        node.count = end - begin;
+        nodes[node_index] = node;
+        return node_index;
+    }
+
+    /* split along the axis with the largest spread */
+    float max_spread = -1.0f;
+    const size_t num_of_dims = numOfDims(points[order[begin]]);
+    for ( size_t axis = 0; axis < num_of_dims; axis++ )
+    {
+        float min_coord = std::numeric_limits<float>::max();
+        float max_coord = std::numeric_limits<float>::lowest();
+        for ( size_t i = begin; i < end; i++ )
+        {
+            const float coord = getCoord(points[order[i]], axis);
+            min_coord = std::min(min_coord, coord);
+            max_coord = std::max(max_coord, coord);
+        }
+        if ( max_coord - min_coord > max_spread )
+        {
+            max_spread = max_coord - min_coord;
+            node.axis = axis;
+        }
+    }
+
+    const size_t mid = begin + (end - begin) / 2;
+    const uint32_t axis = node.axis;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                     [&points, axis](uint32_t a, uint32_t b)
+                     {
+                         return ( getCoord(points[a], axis) < getCoord(points[b], axis) );
+                     });
+    node.split = getCoord(points[order[mid]], axis);
+    node.count = 0;
+
+    buildRecursive(points, order, begin, mid, max_leaf_size, nodes);
+    node.first = buildRecursive(points, order, mid, end, max_leaf_size, nodes);
+    nodes[node_index] = node;
+    return node_index;
+}
+
+/**
+ * @brief Depth first search visiting the side of the splitting plane
+ * containing the query point first. The far side is only visited if the
+ * splitting plane is closer than the current bound returned by visitLeaf.
+ */
+template <typename T, typename LeafVisitor>
+void searchRecursive(const std::vector<KDTreeNode>& nodes, uint32_t node_index,
+                     const T& point, LeafVisitor& visit_leaf, float& bound)
+{
+    const KDTreeNode& node = nodes[node_index];
+    if ( node.isLeaf() )
+    {
+        visit_leaf(node);
+        return;
+    }
+
+    const float diff = getCoord(point, node.axis) - node.split;
+    const uint32_t near_index = ( diff < 0.0f ) ? node_index + 1 : node.first;
+    const uint32_t far_index = ( diff < 0.0f ) ? node.first : node_index + 1;
+    searchRecursive(nodes, near_index, point, visit_leaf, bound);
+    if ( diff * diff <= bound )
+    {
+        searchRecursive(nodes, far_index, point, visit_leaf, bound);
+    }
+}
+
+} // namespace
+
+template <typename T>
+KDTree<T>::KDTree(const std::vector<T>& points, size_t max_leaf_size)
+{
+    build(points, max_leaf_size);
+}
+
+template <typename T>
+void KDTree<T>::build(const std::vector<T>& points, size_t max_leaf_size)
+{
+    nodes_.clear();
+    points_.clear();
+    item_indices_.clear();
+    item_positions_.clear();
+    if ( points.empty() )
+    {
+        return;
+    }
+
+    std::vector<uint32_t> order(points.size());
+    for ( size_t i = 0; i < points.size(); i++ )
+    {
+        order[i] = i;
+    }
+    nodes_.reserve(2 * (points.size() / std::max<size_t>(max_leaf_size, 1)) + 1);
+    buildRecursive(points, order, 0, points.size(), std::max<size_t>(max_leaf_size, 1),
+                   nodes_);
+
+    points_.reserve(points.size());
+    item_indices_ = order;
+    item_positions_.resize(points.size());
+    for ( size_t i = 0; i < order.size(); i++ )
+    {
+        points_.push_back(points[order[i]]);
+        item_positions_[order[i]] = i;
+    }
+}
+
+template <typename T>
+bool KDTree<T>::calcNearestNeighbour(
+        const T& point,
+        size_t& index,
+        float& squared_dist) const
+{
+    if ( points_.empty() )
+    {
+        return false;
+    }
+
+    uint32_t best_position = 0;
+    float best_squared_dist = std::numeric_limits<float>::max();
+    auto visit_leaf = [&](const KDTreeNode& node)
+    {
+        for ( uint32_t i = node.first; i < node.first + node.count; i++ )
+        {
+            const float dist = calcSquaredDist(points_[i], point);
+            if ( dist < best_squared_dist )
+            {
+                best_squared_dist = dist;
+                best_position = i;
+            }
+        }
+    };
+    searchRecursive(nodes_, 0, point, visit_leaf, best_squared_dist);
+
+    index = item_indices_[best_position];
+    squared_dist = best_squared_dist;
+    return true;
+}
+
+template <typename T>
+bool KDTree<T>::calcNearestNeighbours(
+        const std::vector<T>& points,
+        std::vector<size_t>& indices,
+        std::vector<float>& squared_dists) const
+{
+    indices.clear();
+    squared_dists.clear();
+    if ( points_.empty() )
+    {
+        return false;
+    }
+    indices.resize(points.size());
+    squared_dists.resize(points.size());
+
+    uint32_t best_position = 0;
+    float best_squared_dist = 0.0f;
+    for ( size_t q = 0; q < points.size(); q++ )
+    {
+        const T& point = points[q];
+        // the result of the previous query is an upper bound for this one
+        best_squared_dist = calcSquaredDist(points_[best_position], point);
+        auto visit = [&](const KDTreeNode& node)
+        {
+            for ( uint32_t i = node.first; i < node.first + node.count; i++ )
+            {
+                const float dist = calcSquaredDist(points_[i], point);
+                if ( dist < best_squared_dist )
+                {
+                    best_squared_dist = dist;
+                    best_position = i;
+                }
+            }
+        };
+        searchRecursive(nodes_, 0, point, visit, best_squared_dist);
+        indices[q] = item_indices_[best_position];
+        squared_dists[q] = best_squared_dist;
+    }
+    return true;
+}
+
+template <typename T>
+void KDTree<T>::calcKNearestNeighbours(
+        const T& point,
+        size_t k,
+        std::vector<size_t>& indices,
+        std::vector<float>& squared_dists) const
+{
+    indices.clear();
+    squared_dists.clear();
+    if ( points_.empty() || k == 0 )
+    {
+        return;
+    }
+
+    /* max heap of the k closest points found so far */
+    std::priority_queue<std::pair<float, uint32_t>> heap;
+    float bound = std::numeric_limits<float>::max();
+    auto visit_leaf = [&](const KDTreeNode& node)
+    {
+        for ( uint32_t i = node.first; i < node.first + node.count; i++ )
+        {
+            const float dist = calcSquaredDist(points_[i], point);
+            if ( heap.size() < k )
+            {
+                heap.push(std::make_pair(dist, i));
+            }
+            else if ( dist < heap.top().first )
+            {
+                heap.pop();
+                heap.push(std::make_pair(dist, i));
+            }
+            if ( heap.size() == k )
+            {
+                bound = heap.top().first;
+            }
+        }
+    };
+    searchRecursive(nodes_, 0, point, visit_leaf, bound);
+
+    indices.resize(heap.size());
+    squared_dists.resize(heap.size());
+    for ( size_t i = heap.size(); i > 0; i-- )
+    {
+        indices[i-1] = item_indices_[heap.top().second];
+        squared_dists[i-1] = heap.top().first;
+        heap.pop();
+    }
+}
+
+template <typename T>
+void KDTree<T>::calcNeighboursWithinRadius(
+        const T& point,
+        float radius,
+        std::vector<size_t>& indices) const
+{
+    indices.clear();
+    if ( points_.empty() || radius < 0.0f )
+    {
+        return;
+    }
+
+    float bound = radius * radius;
+    auto visit_leaf = [&](const KDTreeNode& node)
+    {
+        for ( uint32_t i = node.first; i < node.first + node.count; i++ )
+        {
+            if ( calcSquaredDist(points_[i], point) <= bound )
+            {
+                indices.push_back(item_indices_[i]);
+            }
+        }
+    };
+    searchRecursive(nodes_, 0, point, visit_leaf, bound);
+}
+
+template <typename T>
+const T& KDTree<T>::operator [] (size_t index) const
+{
+    return points_[item_positions_[index]];
+}
+
+template class KDTree<Point2D>;
+template class KDTree<Point3D>;
+
+} // namespace geometry_common
+} // namespace kelo
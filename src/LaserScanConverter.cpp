@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cmath>
+
+#include <geometry_common/LaserScanConverter.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+void LaserScanConverter::convert(
+        const sensor_msgs::LaserScan& scan,
+        PointCloud2D& cloud)
+{
+    projectBeams(scan);
+    const size_t num_of_beams = scan.ranges.size();
+    cloud.resize(num_of_beams);
+    size_t num_of_points = 0;
+    for ( size_t i = 0; i < num_of_beams; i++ )
+    {
+        // write unconditionally and only advance for valid beams
+        cloud[num_of_points].x = beam_xs_[i];
+        cloud[num_of_points].y = beam_ys_[i];
+        num_of_points += isRangeValid(scan.ranges[i], scan);
+    }
+    cloud.resize(num_of_points);
+}
+
+void LaserScanConverter::convert(
+        const sensor_msgs::LaserScan& scan,
+        PointCloud3D& cloud)
+{
+    projectBeams(scan);
+    const size_t num_of_beams = scan.ranges.size();
+    cloud.resize(num_of_beams);
+    size_t num_of_points = 0;
+    for ( size_t i = 0; i < num_of_beams; i++ )
+    {
+        cloud[num_of_points].x = beam_xs_[i];
+        cloud[num_of_points].y = beam_ys_[i];
+        cloud[num_of_points].z = 0.0f;
+        num_of_points += isRangeValid(scan.ranges[i], scan);
+    }
+    cloud.resize(num_of_points);
+}
+
+void LaserScanConverter::convert(
+        const sensor_msgs::LaserScan& scan,
+        std::vector<float>& xs,
+        std::vector<float>& ys,
+        std::vector<size_t>& beam_indices)
+{
+    projectBeams(scan);
+    const size_t num_of_beams = scan.ranges.size();
+    xs.resize(num_of_beams);
+    ys.resize(num_of_beams);
+    beam_indices.resize(num_of_beams);
+    size_t num_of_points = 0;
+    for ( size_t i = 0; i < num_of_beams; i++ )
+    {
+        xs[num_of_points] = beam_xs_[i];
+        ys[num_of_points] = beam_ys_[i];
+        beam_indices[num_of_points] = i;
+        num_of_points += isRangeValid(scan.ranges[i], scan);
+    }
+    xs.resize(num_of_points);
+    ys.resize(num_of_points);
+    beam_indices.resize(num_of_points);
+}
+
+void LaserScanConverter::updateDirectionTable(
+        float angle_min,
+        float angle_increment,
+        size_t num_of_beams)
+{
+    if ( cos_table_.size() == num_of_beams &&
+         cached_angle_min_ == angle_min &&
+         cached_angle_increment_ == angle_increment )
+    {
+        return;
+    }
+
+    cached_angle_min_ = angle_min;
+    cached_angle_increment_ = angle_increment;
+    cos_table_.resize(num_of_beams);
+    sin_table_.resize(num_of_beams);
+    for ( size_t i = 0; i < num_of_beams; i++ )
+    {
+        // same angles as Utils::convertToPointCloud
+        const float angle = angle_min + (i * angle_increment);
+        cos_table_[i] = std::cos(angle);
+        sin_table_[i] = std::sin(angle);
+    }
+}
+
+void LaserScanConverter::projectBeams(const sensor_msgs::LaserScan& scan)
+{
+    const size_t num_of_beams = scan.ranges.size();
+    updateDirectionTable(scan.angle_min, scan.angle_increment, num_of_beams);
+    beam_xs_.resize(num_of_beams);
+    beam_ys_.resize(num_of_beams);
+
+    const float* ranges = scan.ranges.data();
+    const float* cos_values = cos_table_.data();
+    const float* sin_values = sin_table_.data();
+    float* xs = beam_xs_.data();
+    float* ys = beam_ys_.data();
+    for ( size_t i = 0; i < num_of_beams; i++ )
+    {
+        xs[i] = ranges[i] * cos_values[i];
+        ys[i] = ranges[i] * sin_values[i];
+    }
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -113,6 +113,21 @@ bool LineSegment2D::calcIntersectionPointWith(
     if ( std::fabs(vec1_cross_vec2) < 1e-10f &&
          std::fabs(vec3_cross_vec1) < 1e-10f ) // the two lines are collinear
     {
+        if ( vec1.dotProduct(vec1) == 0.0f ) // this line segment is a single point
+        {
+            const float length_sq = vec2.dotProduct(vec2);
+            const float t = ( length_sq == 0.0f ) ? 0.0f
+                            : -vec3.dotProduct(vec2) / length_sq;
+            if ( std::fabs(vec3_cross_vec2) > 1e-10f ||
+                 ( length_sq == 0.0f && (vec3.x != 0.0f || vec3.y != 0.0f) ) ||
+                 t < 0.0f || t > 1.0f )
+            {
+                return false;
+            }
+            intersection_point = start;
+            return true;
+        }
+
         const float t0 = vec3.dotProduct(vec1) / vec1.dotProduct(vec1);
         const float t1 = t0 + (vec2.dotProduct(vec1) / vec1.dotProduct(vec1));
         const bool are_lines_opposite = ( vec2.dotProduct(vec1) < 0.0f );
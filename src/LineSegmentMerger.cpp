@@ -0,0 +1,419 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <geometry_common/Utils.h>
+#include <geometry_common/LineSegmentMerger.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+void LineSegmentMerger::mergeCloseLines(std::vector<LineSegment2D>& line_segments)
+{
+    if ( line_segments.size() < 2 || !(distance_threshold_ > 0.0f) )
+    {
+        return;
+    }
+    initialise(line_segments);
+
+    for ( uint32_t id = 0; id < segments_.size(); id++ )
+    {
+        updateCloseLinePairs(id);
+    }
+
+    /*
+     * Emulates the passes of Utils::mergeCloseLinesBF where pass s compares
+     * each segment with the one s positions further in the vector. Passes
+     * without any mergeable pair at distance s do not modify anything and are
+     * skipped. Within a pass, only segments which are part of a mergeable
+     * pair at distance s are visited.
+     */
+    size_t num_of_alive = segments_.size();
+    size_t skip_index = 1;
+    while ( skip_index < num_of_alive && !pairs_.empty() )
+    {
+        size_t next_skip_index = std::numeric_limits<size_t>::max();
+        for ( PairSet::iterator it = pairs_.begin(); it != pairs_.end(); )
+        {
+            const size_t dist = calcRank(it->second) - calcRank(it->first);
+            if ( dist < skip_index )
+            {
+                it = pairs_.erase(it); // will never be compared again
+                continue;
+            }
+            next_skip_index = std::min(next_skip_index, dist);
+            it++;
+        }
+        if ( next_skip_index >= num_of_alive )
+        {
+            break;
+        }
+        skip_index = next_skip_index;
+
+        uint32_t cursor = 0;
+        while ( true )
+        {
+            PairSet::iterator it = pairs_.lower_bound(std::make_pair(cursor, 0u));
+            while ( it != pairs_.end() &&
+                    calcRank(it->second) - calcRank(it->first) != skip_index )
+            {
+                it++;
+            }
+            if ( it == pairs_.end() )
+            {
+                break;
+            }
+
+            const uint32_t id = it->first;
+            while ( true )
+            {
+                const uint32_t rank = calcRank(id);
+                if ( rank + skip_index >= num_of_alive )
+                {
+                    break;
+                }
+                const uint32_t other_id = calcIdAtRank(rank + skip_index);
+                LineSegment2D& segment = segments_[id];
+                const LineSegment2D& other_segment = segments_[other_id];
+                const float angular_dist = Utils::calcShortestAngle(
+                        angles_[id], angles_[other_id]);
+                if ( !(std::fabs(angular_dist) < angle_threshold_) )
+                {
+                    break;
+                }
+                if ( segment.end.distTo(other_segment.start) < distance_threshold_ )
+                {
+                    removeFromCell(end_cells_, segment.end, id);
+                    segment.end = other_segment.end;
+                    addToCell(end_cells_, segment.end, id);
+                }
+                else if ( other_segment.end.distTo(segment.start) < distance_threshold_ )
+                {
+                    removeFromCell(start_cells_, segment.start, id);
+                    segment.start = other_segment.start;
+                    addToCell(start_cells_, segment.start, id);
+                }
+                else
+                {
+                    break;
+                }
+                angles_[id] = segment.angle();
+                removeSegment(other_id);
+                num_of_alive--;
+                updateCloseLinePairs(id);
+            }
+            cursor = id + 1;
+        }
+        skip_index++;
+    }
+
+    finalise(line_segments);
+}
+
+void LineSegmentMerger::mergeCoLinearLines(std::vector<LineSegment2D>& line_segments)
+{
+    if ( line_segments.size() < 2 || !(distance_threshold_ > 0.0f) )
+    {
+        return;
+    }
+    initialise(line_segments);
+
+    for ( uint32_t id = 0; id < segments_.size(); id++ )
+    {
+        updateCoLinearPairs(id);
+    }
+
+    /*
+     * Utils::mergeCoLinearLines always merges the first mergeable pair in
+     * the order of the vector. Since merging keeps the relative order of the
+     * remaining segments, this is the smallest pair of ids.
+     */
+    while ( !pairs_.empty() )
+    {
+        const uint32_t id = pairs_.begin()->first;
+        const uint32_t other_id = pairs_.begin()->second;
+        removeFromCell(end_cells_, segments_[id].end, id);
+        segments_[id].end = segments_[other_id].end;
+        addToCell(end_cells_, segments_[id].end, id);
+        angles_[id] = segments_[id].angle();
+        removeSegment(other_id);
+        updateCoLinearPairs(id);
+    }
+
+    finalise(line_segments);
+}
+
+void LineSegmentMerger::initialise(const std::vector<LineSegment2D>& line_segments)
+{
+    cell_size_ = distance_threshold_ * 1.01f;
+    segments_ = line_segments;
+    angles_.resize(segments_.size());
+    is_alive_.assign(segments_.size(), true);
+    start_cells_.clear();
+    end_cells_.clear();
+    pairs_.clear();
+    partners_.assign(segments_.size(), std::vector<uint32_t>());
+    rank_tree_.assign(segments_.size() + 1, 0);
+
+    for ( uint32_t id = 0; id < segments_.size(); id++ )
+    {
+        angles_[id] = segments_[id].angle();
+        addToCell(start_cells_, segments_[id].start, id);
+        addToCell(end_cells_, segments_[id].end, id);
+
+        /* linear time fenwick tree construction with all elements set to 1 */
+        rank_tree_[id+1] += 1;
+        const size_t parent = (id + 1) + ((id + 1) & (~(id + 1) + 1));
+        if ( parent < rank_tree_.size() )
+        {
+            rank_tree_[parent] += rank_tree_[id+1];
+        }
+    }
+}
+
+void LineSegmentMerger::finalise(std::vector<LineSegment2D>& line_segments) const
+{
+    line_segments.clear();
+    for ( size_t id = 0; id < segments_.size(); id++ )
+    {
+        if ( is_alive_[id] )
+        {
+            line_segments.push_back(segments_[id]);
+        }
+    }
+}
+
+uint64_t LineSegmentMerger::calcCellKey(const Point2D& point, int offset_x,
+                                        int offset_y) const
+{
+    const double max_cell_index = 1 << 30;
+    double cell_x = std::floor(static_cast<double>(point.x) / cell_size_);
+    double cell_y = std::floor(static_cast<double>(point.y) / cell_size_);
+    cell_x = ( std::isfinite(cell_x) )
+             ? std::max(-max_cell_index, std::min(cell_x, max_cell_index)) : 0.0;
+    cell_y = ( std::isfinite(cell_y) )
+             ? std::max(-max_cell_index, std::min(cell_y, max_cell_index)) : 0.0;
+    const uint32_t x = static_cast<int32_t>(cell_x) + offset_x;
+    const uint32_t y = static_cast<int32_t>(cell_y) + offset_y;
+    return ( static_cast<uint64_t>(x) << 32 ) | y;
+}
+
+void LineSegmentMerger::addToCell(CellMap& cells, const Point2D& point, uint32_t id)
+{
+    cells[calcCellKey(point)].push_back(id);
+}
+
+void LineSegmentMerger::removeFromCell(CellMap& cells, const Point2D& point, uint32_t id)
+{
+    std::vector<uint32_t>& ids = cells[calcCellKey(point)];
+    std::vector<uint32_t>::iterator it = std::find(ids.begin(), ids.end(), id);
+    if ( it != ids.end() )
+    {
+        *it = ids.back();
+        ids.pop_back();
+    }
+}
+
+void LineSegmentMerger::calcNeighbours(const CellMap& cells, const Point2D& point,
+                                       std::vector<uint32_t>& ids) const
+{
+    ids.clear();
+    for ( int offset_x = -1; offset_x <= 1; offset_x++ )
+    {
+        for ( int offset_y = -1; offset_y <= 1; offset_y++ )
+        {
+            CellMap::const_iterator it = cells.find(calcCellKey(point, offset_x, offset_y));
+            if ( it != cells.end() )
+            {
+                ids.insert(ids.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+}
+
+void LineSegmentMerger::addPair(uint32_t id_a, uint32_t id_b)
+{
+    if ( pairs_.insert(std::make_pair(id_a, id_b)).second )
+    {
+        partners_[id_a].push_back(id_b);
+        partners_[id_b].push_back(id_a);
+    }
+}
+
+void LineSegmentMerger::removePairs(uint32_t id)
+{
+    for ( uint32_t partner : partners_[id] )
+    {
+        pairs_.erase(std::make_pair(id, partner));
+        pairs_.erase(std::make_pair(partner, id));
+        std::vector<uint32_t>& partner_partners = partners_[partner];
+        partner_partners.erase(std::remove(partner_partners.begin(),
+                                           partner_partners.end(), id),
+                               partner_partners.end());
+    }
+    partners_[id].clear();
+}
+
+void LineSegmentMerger::removeSegment(uint32_t id)
+{
+    removePairs(id);
+    removeFromCell(start_cells_, segments_[id].start, id);
+    removeFromCell(end_cells_, segments_[id].end, id);
+    is_alive_[id] = false;
+    for ( size_t i = id + 1; i < rank_tree_.size(); i += i & (~i + 1) )
+    {
+        rank_tree_[i]--;
+    }
+}
+
+bool LineSegmentMerger::canMergeClose(uint32_t id_a, uint32_t id_b) const
+{
+    /* same conditions as Utils::mergeCloseLinesBF */
+    const LineSegment2D& segment_a = segments_[id_a];
+    const LineSegment2D& segment_b = segments_[id_b];
+    const float angular_dist = Utils::calcShortestAngle(angles_[id_a], angles_[id_b]);
+    return ( std::fabs(angular_dist) < angle_threshold_ &&
+             ( segment_a.end.distTo(segment_b.start) < distance_threshold_ ||
+               segment_b.end.distTo(segment_a.start) < distance_threshold_ ) );
+}
+
+bool LineSegmentMerger::canMergeCoLinear(uint32_t id_a, uint32_t id_b) const
+{
+    /* same conditions as Utils::mergeCoLinearLines */
+    const LineSegment2D& segment_a = segments_[id_a];
+    const LineSegment2D& segment_b = segments_[id_b];
+    const float linear_dist = segment_a.end.distTo(segment_b.start);
+    const float angular_dist = Utils::calcShortestAngle(angles_[id_a], angles_[id_b]);
+    if ( !(linear_dist < distance_threshold_ &&
+           std::fabs(angular_dist) < angle_threshold_) )
+    {
+        return false;
+    }
+    const Point2D start_proj_pt = Utils::calcProjectedPointOnLine(
+            segment_a.start, segment_a.end, segment_b.start, false);
+    const Point2D end_proj_pt = Utils::calcProjectedPointOnLine(
+            segment_a.start, segment_a.end, segment_b.end, false);
+    return ( start_proj_pt.distTo(segment_b.start) < perp_dist_threshold_ &&
+             end_proj_pt.distTo(segment_b.end) < perp_dist_threshold_ );
+}
+
+void LineSegmentMerger::updateCloseLinePairs(uint32_t id)
+{
+    removePairs(id);
+    std::vector<uint32_t> neighbours;
+    std::vector<uint32_t> end_neighbours;
+    calcNeighbours(start_cells_, segments_[id].end, neighbours);
+    calcNeighbours(end_cells_, segments_[id].start, end_neighbours);
+    neighbours.insert(neighbours.end(), end_neighbours.begin(), end_neighbours.end());
+    for ( uint32_t other_id : neighbours )
+    {
+        if ( other_id == id )
+        {
+            continue;
+        }
+        const uint32_t id_a = std::min(id, other_id);
+        const uint32_t id_b = std::max(id, other_id);
+        if ( canMergeClose(id_a, id_b) )
+        {
+            addPair(id_a, id_b);
+        }
+    }
+}
+
+void LineSegmentMerger::updateCoLinearPairs(uint32_t id)
+{
+    removePairs(id);
+    std::vector<uint32_t> neighbours;
+    calcNeighbours(start_cells_, segments_[id].end, neighbours);
+    for ( uint32_t other_id : neighbours )
+    {
+        if ( other_id != id && canMergeCoLinear(id, other_id) )
+        {
+            addPair(id, other_id);
+        }
+    }
+    calcNeighbours(end_cells_, segments_[id].start, neighbours);
+    for ( uint32_t other_id : neighbours )
+    {
+        if ( other_id != id && canMergeCoLinear(other_id, id) )
+        {
+            addPair(other_id, id);
+        }
+    }
+}
+
+uint32_t LineSegmentMerger::calcRank(uint32_t id) const
+{
+    uint32_t rank = 0;
+    for ( size_t i = id; i > 0; i -= i & (~i + 1) )
+    {
+        rank += rank_tree_[i];
+    }
+    return rank;
+}
+
+uint32_t LineSegmentMerger::calcIdAtRank(uint32_t rank) const
+{
+    size_t step = 1;
+    while ( step * 2 < rank_tree_.size() )
+    {
+        step *= 2;
+    }
+
+    size_t position = 0;
+    for ( ; step > 0; step /= 2 )
+    {
+        if ( position + step < rank_tree_.size() &&
+             rank_tree_[position + step] <= rank )
+        {
+            position += step;
+            rank -= rank_tree_[position];
+        }
+    }
+    return position;
+}
+
+} // namespace geometry_common
+} // namespace kelo
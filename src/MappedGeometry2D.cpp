@@ -0,0 +1,541 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <geometry_common/Utils.h>
+#include <geometry_common/MappedGeometry2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+const uint32_t MappedGeometry2D::VERSION;
+
+namespace
+{
+
+/// "KGCM" when read as bytes
+const uint32_t MAGIC = 0x4d43474bu;
+
+/// BVHNode2D::traverse uses a fixed stack of 64 entries
+const size_t MAX_TREE_DEPTH = 60;
+
+/**
+ * @brief Location of one kind of shape in the file. Number of leaf items
+ * equals number of shapes.
+ */
+struct FileSection
+{
+    uint32_t num_of_shapes;
+    uint32_t shapes_offset;
+    uint32_t num_of_points;
+    uint32_t points_offset;
+    uint32_t num_of_nodes;
+    uint32_t nodes_offset;
+    uint32_t items_offset;
+};
+
+struct FileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t file_size;
+    FileSection sections[3];
+};
+
+/**
+ * @brief Content of one FileSection before it is written
+ */
+struct SectionData
+{
+    std::vector<uint32_t> shapes;
+    std::vector<PackedPoint2D> points;
+    std::vector<BVHNode2D> nodes;
+    std::vector<uint32_t> items;
+};
+
+void appendVertices(const PointVec2D& vertices, std::vector<PackedPoint2D>& points)
+{
+    for ( const Point2D& vertex : vertices )
+    {
+        points.push_back(PackedPoint2D{vertex.x, vertex.y});
+    }
+}
+
+void appendVertices(const Polyline2D& polyline, std::vector<PackedPoint2D>& points)
+{
+    appendVertices(polyline.vertices, points);
+}
+
+void appendVertices(const LineSegment2D& line_segment, std::vector<PackedPoint2D>& points)
+{
+    points.push_back(PackedPoint2D{line_segment.start.x, line_segment.start.y});
+    points.push_back(PackedPoint2D{line_segment.end.x, line_segment.end.y});
+}
+
+template <typename T>
+void buildSection(
+        const std::vector<T>& shapes,
+        size_t max_leaf_size,
+        SectionData& data)
+{
+    const BVH2D<T> bvh(shapes, max_leaf_size);
+    data.nodes = bvh.nodes();
+    data.items = bvh.itemIndices();
+    data.shapes.reserve(2 * shapes.size());
+    for ( const T& shape : shapes )
+    {
+        const size_t first = data.points.size();
+        appendVertices(shape, data.points);
+        data.shapes.push_back(first);
+        data.shapes.push_back(data.points.size() - first);
+    }
+}
+
+/**
+ * @brief Check that offsets, shape records and the hierarchy of a section
+ * only refer to data within the file, and that the hierarchy is a tree that
+ * BVHNode2D::traverse can walk.
+ *
+ * @param min_shape_size minimum number of vertices of a shape
+ * @param max_shape_size maximum number of vertices of a shape
+ */
+bool isSectionValid(const uint8_t* data, size_t size, const FileSection& section,
+                    uint32_t min_shape_size,
+                    uint32_t max_shape_size = std::numeric_limits<uint32_t>::max())
+{
+    const uint64_t num_of_shapes = section.num_of_shapes;
+    const uint64_t extents[4][2] = {
+        {section.shapes_offset, num_of_shapes * 2 * sizeof(uint32_t)},
+        {section.points_offset, section.num_of_points * sizeof(PackedPoint2D)},
+        {section.nodes_offset, section.num_of_nodes * sizeof(BVHNode2D)},
+        {section.items_offset, num_of_shapes * sizeof(uint32_t)}};
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        if ( extents[i][0] % 4 != 0 || extents[i][0] + extents[i][1] > size )
+        {
+            return false;
+        }
+    }
+    if ( ( num_of_shapes == 0 ) != ( section.num_of_nodes == 0 ) )
+    {
+        return false;
+    }
+
+    const uint32_t* shapes = reinterpret_cast<const uint32_t*>(data + section.shapes_offset);
+    for ( size_t i = 0; i < num_of_shapes; i++ )
+    {
+        const uint32_t count = shapes[(2*i)+1];
+        if ( count < min_shape_size || count > max_shape_size ||
+             static_cast<uint64_t>(shapes[2*i]) + count > section.num_of_points )
+        {
+            return false;
+        }
+    }
+
+    const uint32_t* items = reinterpret_cast<const uint32_t*>(data + section.items_offset);
+    for ( size_t i = 0; i < num_of_shapes; i++ )
+    {
+        if ( items[i] >= num_of_shapes )
+        {
+            return false;
+        }
+    }
+
+    /* every node must be reached exactly once from its parent */
+    const BVHNode2D* nodes = reinterpret_cast<const BVHNode2D*>(data + section.nodes_offset);
+    std::vector<uint8_t> depths(section.num_of_nodes, 0);
+    if ( !depths.empty() )
+    {
+        depths[0] = 1;
+    }
+    for ( size_t i = 0; i < section.num_of_nodes; i++ )
+    {
+        const BVHNode2D& node = nodes[i];
+        if ( depths[i] == 0 )
+        {
+            return false;
+        }
+        if ( node.isLeaf() )
+        {
+            if ( static_cast<uint64_t>(node.first) + node.count > num_of_shapes )
+            {
+                return false;
+            }
+            continue;
+        }
+        const size_t children[2] = {i + 1, node.first};
+        if ( node.first <= i + 1 || node.first >= section.num_of_nodes ||
+             depths[i] >= MAX_TREE_DEPTH )
+        {
+            return false;
+        }
+        for ( size_t child : children )
+        {
+            if ( depths[child] != 0 )
+            {
+                return false;
+            }
+            depths[child] = depths[i] + 1;
+        }
+    }
+    return true;
+}
+
+Box2D calcBoundingBox(const MappedGeometry2D::VertexView& vertices, float tolerance)
+{
+    Box2D box(std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest(),
+              std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest());
+    for ( size_t i = 0; i < vertices.size(); i++ )
+    {
+        box.min_x = std::min(box.min_x, vertices.x(i) - tolerance);
+        box.max_x = std::max(box.max_x, vertices.x(i) + tolerance);
+        box.min_y = std::min(box.min_y, vertices.y(i) - tolerance);
+        box.max_y = std::max(box.max_y, vertices.y(i) + tolerance);
+    }
+    return box;
+}
+
+bool doBoxesOverlap(const Box2D& box_1, const Box2D& box_2)
+{
+    return ( box_1.min_x <= box_2.max_x && box_1.max_x >= box_2.min_x &&
+             box_1.min_y <= box_2.max_y && box_1.max_y >= box_2.min_y );
+}
+
+bool intersectsEdges(
+        const MappedGeometry2D::VertexView& vertices,
+        bool is_closed,
+        const LineSegment2D& line_segment)
+{
+    if ( vertices.size() < 2 )
+    {
+        return false;
+    }
+    const size_t num_of_edges = ( is_closed ) ? vertices.size() : vertices.size() - 1;
+    for ( size_t i = 0; i < num_of_edges; i++ )
+    {
+        const size_t j = ( i + 1 == vertices.size() ) ? 0 : i + 1;
+        if ( line_segment.intersects(LineSegment2D(vertices[i], vertices[j])) )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+MappedGeometry2D::~MappedGeometry2D()
+{
+    close();
+}
+
+bool MappedGeometry2D::write(
+        const std::string& file_path,
+        const std::vector<Polygon2D>& polygons,
+        const std::vector<Polyline2D>& polylines,
+        const std::vector<LineSegment2D>& line_segments,
+        size_t max_leaf_size)
+{
+    /* open() rejects shapes without vertices */
+    auto is_empty = [](const Polyline2D& shape) { return shape.vertices.empty(); };
+    if ( std::any_of(polygons.begin(), polygons.end(), is_empty) ||
+         std::any_of(polylines.begin(), polylines.end(), is_empty) )
+    {
+        return false;
+    }
+
+    SectionData sections[3];
+    buildSection(polygons, max_leaf_size, sections[0]);
+    buildSection(polylines, max_leaf_size, sections[1]);
+    buildSection(line_segments, max_leaf_size, sections[2]);
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = MAGIC;
+    header.version = VERSION;
+    uint64_t offset = sizeof(FileHeader);
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        FileSection& section = header.sections[i];
+        section.num_of_shapes = sections[i].items.size();
+        section.num_of_points = sections[i].points.size();
+        section.num_of_nodes = sections[i].nodes.size();
+        section.shapes_offset = offset;
+        offset += sections[i].shapes.size() * sizeof(uint32_t);
+        section.points_offset = offset;
+        offset += sections[i].points.size() * sizeof(PackedPoint2D);
+        section.nodes_offset = offset;
+        offset += sections[i].nodes.size() * sizeof(BVHNode2D);
+        section.items_offset = offset;
+        offset += sections[i].items.size() * sizeof(uint32_t);
+    }
+    if ( offset > std::numeric_limits<uint32_t>::max() )
+    {
+        return false;
+    }
+    header.file_size = offset;
+
+    const std::string tmp_file_path = file_path + ".tmp";
+    std::ofstream file(tmp_file_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        file.write(reinterpret_cast<const char*>(sections[i].shapes.data()),
+                   sections[i].shapes.size() * sizeof(uint32_t));
+        file.write(reinterpret_cast<const char*>(sections[i].points.data()),
+                   sections[i].points.size() * sizeof(PackedPoint2D));
+        file.write(reinterpret_cast<const char*>(sections[i].nodes.data()),
+                   sections[i].nodes.size() * sizeof(BVHNode2D));
+        file.write(reinterpret_cast<const char*>(sections[i].items.data()),
+                   sections[i].items.size() * sizeof(uint32_t));
+    }
+    file.close();
+    if ( !file || std::rename(tmp_file_path.c_str(), file_path.c_str()) != 0 )
+    {
+        std::remove(tmp_file_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool MappedGeometry2D::open(const std::string& file_path)
+{
+    close();
+
+    const int fd = ::open(file_path.c_str(), O_RDONLY);
+    if ( fd < 0 )
+    {
+        return false;
+    }
+    struct stat file_stat;
+    if ( ::fstat(fd, &file_stat) != 0 ||
+         static_cast<size_t>(file_stat.st_size) < sizeof(FileHeader) )
+    {
+        ::close(fd);
+        return false;
+    }
+    const size_t size = file_stat.st_size;
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if ( data == MAP_FAILED )
+    {
+        return false;
+    }
+    data_ = data;
+    size_ = size;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data_);
+    const FileHeader* header = static_cast<const FileHeader*>(data_);
+    if ( header->magic != MAGIC || header->version != VERSION ||
+         header->file_size != size_ ||
+         !isSectionValid(bytes, size_, header->sections[0], 1) ||
+         !isSectionValid(bytes, size_, header->sections[1], 1) ||
+         !isSectionValid(bytes, size_, header->sections[2], 2, 2) )
+    {
+        close();
+        return false;
+    }
+
+    Section* sections[3] = {&polygons_, &polylines_, &line_segments_};
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        const FileSection& file_section = header->sections[i];
+        Section& section = *sections[i];
+        section.shapes = reinterpret_cast<const uint32_t*>(bytes + file_section.shapes_offset);
+        section.points = reinterpret_cast<const PackedPoint2D*>(bytes + file_section.points_offset);
+        section.nodes = reinterpret_cast<const BVHNode2D*>(bytes + file_section.nodes_offset);
+        section.items = reinterpret_cast<const uint32_t*>(bytes + file_section.items_offset);
+        section.num_of_shapes = file_section.num_of_shapes;
+        section.num_of_nodes = file_section.num_of_nodes;
+    }
+    return true;
+}
+
+void MappedGeometry2D::close()
+{
+    if ( data_ != nullptr )
+    {
+        ::munmap(data_, size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    polygons_ = Section();
+    polylines_ = Section();
+    line_segments_ = Section();
+}
+
+bool MappedGeometry2D::isOpen() const
+{
+    return ( data_ != nullptr );
+}
+
+size_t MappedGeometry2D::numOfPolygons() const
+{
+    return polygons_.num_of_shapes;
+}
+
+size_t MappedGeometry2D::numOfPolylines() const
+{
+    return polylines_.num_of_shapes;
+}
+
+size_t MappedGeometry2D::numOfLineSegments() const
+{
+    return line_segments_.num_of_shapes;
+}
+
+MappedGeometry2D::VertexView MappedGeometry2D::polygon(size_t index) const
+{
+    return polygons_.vertices(index);
+}
+
+MappedGeometry2D::VertexView MappedGeometry2D::polyline(size_t index) const
+{
+    return polylines_.vertices(index);
+}
+
+LineSegment2D MappedGeometry2D::lineSegment(size_t index) const
+{
+    const VertexView vertices = line_segments_.vertices(index);
+    return LineSegment2D(vertices[0], vertices[1]);
+}
+
+void MappedGeometry2D::calcPolygonsContaining(
+        const Point2D& point,
+        std::vector<size_t>& indices) const
+{
+    indices.clear();
+    BVHNode2D::traverse(polygons_.nodes, polygons_.num_of_nodes,
+            [&point](const BVHNode2D& node)
+            {
+                return node.containsPoint(point);
+            },
+            [this, &point, &indices](size_t i)
+            {
+                const size_t index = polygons_.items[i];
+                if ( Utils::isPointInPolygon(polygons_.vertices(index), point) )
+                {
+                    indices.push_back(index);
+                }
+                return true;
+            });
+}
+
+bool MappedGeometry2D::intersects(const LineSegment2D& line_segment) const
+{
+    const Box2D box(std::min(line_segment.start.x, line_segment.end.x),
+                    std::max(line_segment.start.x, line_segment.end.x),
+                    std::min(line_segment.start.y, line_segment.end.y),
+                    std::max(line_segment.start.y, line_segment.end.y));
+    const Section* sections[3] = {&polygons_, &polylines_, &line_segments_};
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        const Section& section = *sections[i];
+        const bool is_closed = ( i == 0 );
+        const bool is_traversal_complete = BVHNode2D::traverse(
+                section.nodes, section.num_of_nodes,
+                [&box](const BVHNode2D& node)
+                {
+                    return node.intersects(box);
+                },
+                [&section, is_closed, &line_segment](size_t item)
+                {
+                    return !intersectsEdges(section.vertices(section.items[item]),
+                                            is_closed, line_segment);
+                });
+        if ( !is_traversal_complete )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MappedGeometry2D::calcIndicesOverlapping(
+        const Box2D& box,
+        std::vector<size_t>& polygon_indices,
+        std::vector<size_t>& polyline_indices,
+        std::vector<size_t>& line_segment_indices) const
+{
+    const Section* sections[3] = {&polygons_, &polylines_, &line_segments_};
+    std::vector<size_t>* indices[3] = {&polygon_indices, &polyline_indices,
+                                       &line_segment_indices};
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        const Section& section = *sections[i];
+        const float tolerance = ( i == 0 ) ? 0.0f : BVH_CONTAINMENT_TOLERANCE;
+        std::vector<size_t>& section_indices = *indices[i];
+        section_indices.clear();
+        BVHNode2D::traverse(section.nodes, section.num_of_nodes,
+                [&box](const BVHNode2D& node)
+                {
+                    return node.intersects(box);
+                },
+                [&section, tolerance, &box, &section_indices](size_t item)
+                {
+                    const size_t index = section.items[item];
+                    if ( doBoxesOverlap(calcBoundingBox(section.vertices(index), tolerance), box) )
+                    {
+                        section_indices.push_back(index);
+                    }
+                    return true;
+                });
+    }
+}
+
+MappedGeometry2D::VertexView MappedGeometry2D::Section::vertices(size_t index) const
+{
+    return VertexView(points + shapes[2*index], shapes[(2*index)+1]);
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -0,0 +1,159 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+
+#include <geometry_common/MonotonicArena.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+namespace
+{
+
+/// arena activated by the innermost ArenaScope of the calling thread
+thread_local MonotonicArena* current_arena = nullptr;
+
+} // namespace
+
+MonotonicArena::MonotonicArena(size_t initial_block_size):
+    initial_block_size_(std::max(initial_block_size, static_cast<size_t>(64)))
+{
+}
+
+void* MonotonicArena::allocate(size_t num_of_bytes, size_t alignment)
+{
+    if ( num_of_bytes == 0 )
+    {
+        num_of_bytes = 1;
+    }
+
+    if ( !blocks_.empty() )
+    {
+        Block& block = blocks_.back();
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        const uintptr_t aligned = (base + offset_ + alignment - 1) & ~(alignment - 1);
+        const size_t aligned_offset = aligned - base;
+        if ( aligned_offset + num_of_bytes <= block.size )
+        {
+            bytes_used_ += aligned_offset + num_of_bytes - offset_;
+            offset_ = aligned_offset + num_of_bytes;
+            return block.data.get() + aligned_offset;
+        }
+    }
+
+    addBlock(num_of_bytes + alignment);
+    Block& block = blocks_.back();
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+    const size_t aligned_offset = ((base + alignment - 1) & ~(alignment - 1)) - base;
+    bytes_used_ += aligned_offset + num_of_bytes;
+    offset_ = aligned_offset + num_of_bytes;
+    return block.data.get() + aligned_offset;
+}
+
+void MonotonicArena::addBlock(size_t min_size)
+{
+    size_t block_size = ( blocks_.empty() )
+                        ? initial_block_size_
+                        : 2 * blocks_.back().size;
+    block_size = std::max(block_size, min_size);
+
+    Block block;
+    block.data.reset(new char[block_size]);
+    block.size = block_size;
+    blocks_.push_back(std::move(block));
+    offset_ = 0;
+}
+
+void MonotonicArena::reset()
+{
+    if ( blocks_.size() > 1 )
+    {
+        const size_t total_size = bytesReserved();
+        blocks_.clear();
+        addBlock(total_size);
+    }
+    offset_ = 0;
+    bytes_used_ = 0;
+}
+
+void MonotonicArena::release()
+{
+    blocks_.clear();
+    offset_ = 0;
+    bytes_used_ = 0;
+}
+
+size_t MonotonicArena::bytesUsed() const
+{
+    return bytes_used_;
+}
+
+size_t MonotonicArena::bytesReserved() const
+{
+    size_t total_size = 0;
+    for ( const Block& block : blocks_ )
+    {
+        total_size += block.size;
+    }
+    return total_size;
+}
+
+MonotonicArena* MonotonicArena::current()
+{
+    return current_arena;
+}
+
+ArenaScope::ArenaScope(MonotonicArena& arena):
+    previous_arena_(current_arena)
+{
+    current_arena = &arena;
+}
+
+ArenaScope::~ArenaScope()
+{
+    current_arena = previous_arena_;
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -0,0 +1,314 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <geometry_common/Utils.h>
+#include <geometry_common/PathIndex2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+PathIndex2D::PathIndex2D(const Path& path)
+{
+    build(path);
+}
+
+PathIndex2D::PathIndex2D(const Polyline2D& polyline)
+{
+    build(polyline);
+}
+
+void PathIndex2D::build(const Path& path)
+{
+    points_.resize(path.size());
+    thetas_.resize(path.size());
+    for ( size_t i = 0; i < path.size(); i++ )
+    {
+        points_[i].x = path[i].x;
+        points_[i].y = path[i].y;
+        thetas_[i] = path[i].theta;
+    }
+    interpolate_theta_ = true;
+    buildIndex();
+}
+
+void PathIndex2D::build(const Polyline2D& polyline)
+{
+    points_ = polyline.vertices;
+    thetas_.resize(points_.size());
+    float theta = 0.0f;
+    for ( size_t i = 0; i+1 < points_.size(); i++ )
+    {
+        // zero length segments keep the orientation of the previous segment
+        if ( points_[i] != points_[i+1] )
+        {
+            theta = (points_[i+1] - points_[i]).angle();
+        }
+        thetas_[i] = theta;
+    }
+    if ( !points_.empty() )
+    {
+        thetas_.back() = theta;
+    }
+    interpolate_theta_ = false;
+    buildIndex();
+}
+
+void PathIndex2D::buildIndex()
+{
+    arc_lengths_.resize(points_.size());
+    std::vector<LineSegment2D> segments;
+    segments.reserve(points_.size());
+    float arc_length = 0.0f;
+    for ( size_t i = 0; i < points_.size(); i++ )
+    {
+        if ( i > 0 )
+        {
+            arc_length += points_[i-1].distTo(points_[i]);
+            segments.push_back(LineSegment2D(points_[i-1], points_[i]));
+        }
+        arc_lengths_[i] = arc_length;
+    }
+    bvh_.build(segments);
+}
+
+bool PathIndex2D::calcPointAt(float arc_length, Point2D& point) const
+{
+    if ( points_.empty() )
+    {
+        return false;
+    }
+    if ( points_.size() == 1 )
+    {
+        point = points_.front();
+        return true;
+    }
+
+    const size_t i = findSegment(arc_length);
+    const float segment_length = arc_lengths_[i+1] - arc_lengths_[i];
+    const float t = ( segment_length > 0.0f )
+                    ? Utils::clip((arc_length - arc_lengths_[i]) / segment_length,
+                                  1.0f, 0.0f)
+                    : 0.0f;
+    point = points_[i] + ((points_[i+1] - points_[i]) * t);
+    return true;
+}
+
+bool PathIndex2D::calcPoseAt(float arc_length, Pose2D& pose) const
+{
+    if ( points_.empty() )
+    {
+        return false;
+    }
+    if ( points_.size() == 1 )
+    {
+        pose = Pose2D(points_[0].x, points_[0].y, thetas_[0]);
+        return true;
+    }
+
+    const size_t i = findSegment(arc_length);
+    const float segment_length = arc_lengths_[i+1] - arc_lengths_[i];
+    const float t = ( segment_length > 0.0f )
+                    ? Utils::clip((arc_length - arc_lengths_[i]) / segment_length,
+                                  1.0f, 0.0f)
+                    : 0.0f;
+    const Point2D point = points_[i] + ((points_[i+1] - points_[i]) * t);
+    pose = Pose2D(point.x, point.y, calcThetaAt(i, t));
+    return true;
+}
+
+bool PathIndex2D::calcProjection(
+        const Point2D& point,
+        PathProjection2D& projection) const
+{
+    if ( points_.empty() )
+    {
+        return false;
+    }
+    if ( points_.size() == 1 )
+    {
+        projection.segment_index = 0;
+        projection.arc_length = 0.0f;
+        projection.point = points_.front();
+        projection.dist = point.distTo(projection.point);
+        return true;
+    }
+
+    size_t segment_index = 0;
+    float dist;
+    if ( !bvh_.calcNearest(point, segment_index, dist) )
+    {
+        return false;
+    }
+    projectOnSegment(point, segment_index, projection);
+    projection.dist = std::sqrt(projection.dist);
+    return true;
+}
+
+bool PathIndex2D::calcProjection(
+        const Point2D& point,
+        const PathProjection2D& hint,
+        float max_arc_length_ahead,
+        float max_arc_length_behind,
+        PathProjection2D& projection) const
+{
+    if ( points_.size() < 2 )
+    {
+        return calcProjection(point, projection);
+    }
+
+    const size_t num_of_segments = points_.size() - 1;
+    const size_t hint_segment_index =
+        ( hint.segment_index < num_of_segments &&
+          arc_lengths_[hint.segment_index] <= hint.arc_length &&
+          arc_lengths_[hint.segment_index+1] >= hint.arc_length )
+        ? hint.segment_index
+        : findSegment(hint.arc_length);
+    const float min_arc_length = hint.arc_length - max_arc_length_behind;
+    const float max_arc_length = hint.arc_length + max_arc_length_ahead;
+
+    PathProjection2D candidate;
+    projectOnSegment(point, hint_segment_index, projection);
+    for ( size_t i = hint_segment_index + 1;
+          i < num_of_segments && arc_lengths_[i] <= max_arc_length; i++ )
+    {
+        projectOnSegment(point, i, candidate);
+        if ( candidate.dist < projection.dist )
+        {
+            projection = candidate;
+        }
+    }
+    for ( size_t i = hint_segment_index;
+          i > 0 && arc_lengths_[i] >= min_arc_length; i-- )
+    {
+        projectOnSegment(point, i-1, candidate);
+        if ( candidate.dist < projection.dist )
+        {
+            projection = candidate;
+        }
+    }
+    projection.dist = std::sqrt(projection.dist);
+    return true;
+}
+
+void PathIndex2D::resample(float spacing, Path& resampled_path) const
+{
+    resampled_path.clear();
+    if ( points_.empty() )
+    {
+        return;
+    }
+    if ( points_.size() == 1 || spacing <= 0.0f )
+    {
+        resampled_path.reserve(points_.size());
+        for ( size_t i = 0; i < points_.size(); i++ )
+        {
+            resampled_path.push_back(Pose2D(points_[i].x, points_[i].y, thetas_[i]));
+        }
+        return;
+    }
+
+    const float path_length = length();
+    resampled_path.reserve(static_cast<size_t>(path_length / spacing) + 2);
+    size_t i = 0;
+    for ( size_t k = 0; k * spacing < path_length || k == 0; k++ )
+    {
+        // multiples of spacing instead of accumulation to avoid drift
+        const float arc_length = k * spacing;
+        while ( i+2 < points_.size() && arc_lengths_[i+1] < arc_length )
+        {
+            i++;
+        }
+        const float segment_length = arc_lengths_[i+1] - arc_lengths_[i];
+        const float t = ( segment_length > 0.0f )
+                        ? Utils::clip((arc_length - arc_lengths_[i]) / segment_length,
+                                      1.0f, 0.0f)
+                        : 0.0f;
+        const Point2D point = points_[i] + ((points_[i+1] - points_[i]) * t);
+        resampled_path.push_back(Pose2D(point.x, point.y, calcThetaAt(i, t)));
+    }
+    resampled_path.push_back(Pose2D(points_.back().x, points_.back().y,
+                                    thetas_.back()));
+}
+
+size_t PathIndex2D::findSegment(float arc_length) const
+{
+    const size_t index = std::upper_bound(arc_lengths_.begin(), arc_lengths_.end(),
+                                          arc_length) - arc_lengths_.begin();
+    return std::min(( index > 0 ) ? index - 1 : 0, points_.size() - 2);
+}
+
+void PathIndex2D::projectOnSegment(
+        const Point2D& point,
+        size_t segment_index,
+        PathProjection2D& projection) const
+{
+    const Point2D& start = points_[segment_index];
+    const Vector2D diff = points_[segment_index+1] - start;
+    const float squared_length = diff.dotProduct(diff);
+    const float t = ( squared_length > 0.0f )
+                    ? Utils::clip((point - start).dotProduct(diff) / squared_length,
+                                  1.0f, 0.0f)
+                    : 0.0f;
+    projection.segment_index = segment_index;
+    projection.point = start + (diff * t);
+    projection.arc_length = arc_lengths_[segment_index] +
+        (t * (arc_lengths_[segment_index+1] - arc_lengths_[segment_index]));
+    projection.dist = point.squaredDistTo(projection.point); // squared until done
+}
+
+float PathIndex2D::calcThetaAt(size_t segment_index, float t) const
+{
+    if ( !interpolate_theta_ )
+    {
+        return thetas_[segment_index];
+    }
+    const float theta = thetas_[segment_index];
+    return Utils::clipAngle(theta + (t * Utils::calcShortestAngle(
+                    thetas_[segment_index+1], theta)));
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -39,7 +39,10 @@
  ******************************************************************************/
 
 #include <cmath>
+#include <mutex>
 #include <geometry_common/Utils.h>
+#include <geometry_common/MonotonicArena.h>
+#include <geometry_common/Instrumentation.h>
 #include <geometry_common/PointCloudProjector.h>
 
 namespace kelo
@@ -51,6 +54,8 @@ using geometry_common::PointCloud2D;
 using geometry_common::PointCloud3D;
 using geometry_common::TransformMatrix3D;
 using geometry_common::Utils;
+using geometry_common::ExecutionPolicy;
+using geometry_common::ArenaVector;
 
 void PointCloudProjector::configureTransform(
         float cam_x,
@@ -90,6 +95,31 @@ PointCloud3D PointCloudProjector::transformAndFilterPointCloud(
         const PointCloud3D& cloud_in) const
 {
     PointCloud3D cloud_out;
+    if ( execution_policy_.isParallel() )
+    {
+        /* transform and validate in parallel, then compact in order */
+        ArenaVector<Point3D> transformed_cloud(cloud_in.size());
+        ArenaVector<uint8_t> is_valid(cloud_in.size());
+        execution_policy_.parallelFor(0, cloud_in.size(),
+                [this, &cloud_in, &transformed_cloud, &is_valid](size_t begin, size_t end)
+                {
+                    for ( size_t i = begin; i < end; i++ )
+                    {
+                        transformed_cloud[i] = camera_to_target_tf_mat_ * cloud_in[i];
+                        is_valid[i] = isPointValid(transformed_cloud[i]);
+                    }
+                });
+        cloud_out.reserve(cloud_in.size());
+        for ( size_t i = 0; i < transformed_cloud.size(); i++ )
+        {
+            if ( is_valid[i] )
+            {
+                cloud_out.push_back(transformed_cloud[i]);
+            }
+        }
+        return cloud_out;
+    }
+
     cloud_out.reserve(cloud_in.size());
     for ( const Point3D& pt : cloud_in )
     {
@@ -113,20 +143,44 @@ std::vector<float> PointCloudProjector::projectedPointCloudToScan(
 
     std::vector<float> scan(num_of_scan_pts, radial_dist_max_);
 
-    for ( const Point3D& pt : cloud_in )
+    auto project = [&](size_t begin, size_t end, std::vector<float>& target_scan)
     {
-        float dist = std::sqrt(std::pow(pt.x, 2) + std::pow(pt.y, 2));
-        float angle = std::atan2(pt.y, pt.x);
-        if ( is_angle_flipped && angle < angle_max && angle > -M_PI )
-        {
-            angle += 2*M_PI;
-        }
-        size_t scan_index = ((angle - angle_min) * angle_increment_inv_) + 0.5f;
-        if ( scan_index < num_of_scan_pts )
+        for ( size_t i = begin; i < end; i++ )
         {
-            scan[scan_index] = std::min(dist, scan[scan_index]);
+            const Point3D& pt = cloud_in[i];
+            float dist = std::sqrt(std::pow(pt.x, 2) + std::pow(pt.y, 2));
+            float angle = std::atan2(pt.y, pt.x);
+            if ( is_angle_flipped && angle < angle_max && angle > -M_PI )
+            {
+                angle += 2*M_PI;
+            }
+            size_t scan_index = ((angle - angle_min) * angle_increment_inv_) + 0.5f;
+            if ( scan_index < num_of_scan_pts )
+            {
+                target_scan[scan_index] = std::min(dist, target_scan[scan_index]);
+            }
         }
+    };
+
+    if ( !execution_policy_.isParallel() )
+    {
+        project(0, cloud_in.size(), scan);
+        return scan;
     }
+
+    /* project chunks into local scans and merge them with min */
+    std::mutex scan_mutex;
+    execution_policy_.parallelFor(0, cloud_in.size(),
+            [&](size_t begin, size_t end)
+            {
+                std::vector<float> local_scan(num_of_scan_pts, radial_dist_max_);
+                project(begin, end, local_scan);
+                std::lock_guard<std::mutex> lock(scan_mutex);
+                for ( size_t i = 0; i < num_of_scan_pts; i++ )
+                {
+                    scan[i] = std::min(scan[i], local_scan[i]);
+                }
+            });
     return scan;
 }
 
@@ -145,6 +199,8 @@ std::vector<float> PointCloudProjector::projectToScan(
         float angle_min,
         float angle_max) const
 {
+    GEOMETRY_COMMON_PROFILE_SCOPE("PointCloudProjector::projectToScan", cloud_in.size());
+
     filtered_cloud = transformAndFilterPointCloud(cloud_in);
     return projectedPointCloudToScan(filtered_cloud, angle_min, angle_max);
 }
@@ -160,6 +216,8 @@ std::vector<float> PointCloudProjector::projectToScan(
         const PointCloud3D& cloud_in,
         PointCloud3D& filtered_cloud) const
 {
+    GEOMETRY_COMMON_PROFILE_SCOPE("PointCloudProjector::projectToScan", cloud_in.size());
+
     filtered_cloud = transformAndFilterPointCloud(cloud_in);
     return projectedPointCloudToScan(filtered_cloud, angle_min_, angle_max_);
 }
@@ -235,6 +293,12 @@ bool PointCloudProjector::isPointValid(
     return true;
 }
 
+void PointCloudProjector::setExecutionPolicy(
+        const ExecutionPolicy& policy)
+{
+    execution_policy_ = policy;
+}
+
 float PointCloudProjector::getRadialDistMax() const
 {
     return radial_dist_max_;
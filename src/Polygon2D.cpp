@@ -38,8 +38,12 @@
  *
  ******************************************************************************/
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <geometry_common/Utils.h>
+#include <geometry_common/MonotonicArena.h>
+#include <geometry_common/Instrumentation.h>
 #include <geometry_common/Polygon2D.h>
 
 namespace kelo
@@ -47,6 +51,16 @@ namespace kelo
 namespace geometry_common
 {
 
+namespace
+{
+
+inline double calcSquaredLength(const Vector2D& vec)
+{
+    return ( static_cast<double>(vec.x) * vec.x ) + ( static_cast<double>(vec.y) * vec.y );
+}
+
+} // namespace
+
 float Polygon2D::length() const
 {
     size_t nVertices = vertices.size();
@@ -58,6 +72,8 @@ float Polygon2D::length() const
 
 bool Polygon2D::intersects(const LineSegment2D& line_segment) const
 {
+    GEOMETRY_COMMON_PROFILE_SCOPE("Polygon2D::intersects(LineSegment2D)", vertices.size());
+
     for ( size_t start = vertices.size() - 1, end = 0; end < vertices.size(); start = end++ )
     {
         if ( LineSegment2D(vertices[start], vertices[end]).intersects(line_segment) )
@@ -70,14 +86,9 @@ bool Polygon2D::intersects(const LineSegment2D& line_segment) const
 
 bool Polygon2D::intersects(const Polyline2D& polyline) const
 {
-    for ( size_t start = 0, end = start + 1; end < polyline.size(); start = end++ )
-    {
-        if ( intersects(LineSegment2D(polyline[start], polyline[end])) )
-        {
-            return true;
-        }
-    }
-    return false;
+    GEOMETRY_COMMON_PROFILE_SCOPE("Polygon2D::intersects(Polyline2D)", vertices.size());
+
+    return Utils::doPolylinesIntersect(vertices, polyline.vertices, true, false);
 }
 
 bool Polygon2D::calcClosestIntersectionPointWith(
@@ -124,23 +135,16 @@ bool Polygon2D::calcClosestIntersectionPoseWith(
     return false;
 }
 
+void Polygon2D::simplify(float tolerance)
+{
+    vertices = Utils::simplifyDouglasPeucker(vertices, tolerance, true);
+}
+
 bool Polygon2D::containsPoint(const Point2D& point) const
 {
-    /* 
-     * Source: https://stackoverflow.com/a/2922778/10460994
-     */
-    size_t i, j, counter = 0;
-    for ( i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++ )
-    {
-        const Point2D& currVert = vertices[i];
-        const Point2D& prevVert = vertices[j];
-        if ( ((currVert.y > point.y) != (prevVert.y > point.y)) &&
-             (point.x < (prevVert.x - currVert.x) * (point.y - currVert.y) / (prevVert.y - currVert.y) + currVert.x) )
-        {
-            counter++;
-        }
-    }
-    return ( counter % 2 == 1 );
+    GEOMETRY_COMMON_PROFILE_SCOPE("Polygon2D::containsPoint", vertices.size());
+
+    return Utils::isPointInPolygon(PointArrayView2D<Point2D>(vertices), point);
 }
 
 bool Polygon2D::containsAnyPoint(const PointVec2D& points) const
@@ -169,6 +173,33 @@ Point2D Polygon2D::meanPoint() const
     return mean;
 }
 
+Point2D Polygon2D::centroid() const
+{
+    if ( vertices.size() < 3 )
+    {
+        return meanPoint();
+    }
+
+    // accumulate relative to the first vertex to limit cancellation errors
+    const Point2D& origin = vertices[0];
+    float twice_area = 0.0f;
+    Point2D weighted_sum;
+    for ( size_t i = 1; i + 1 < vertices.size(); i++ )
+    {
+        const Point2D p1 = vertices[i] - origin;
+        const Point2D p2 = vertices[i+1] - origin;
+        const float cross = p1.scalarCrossProduct(p2);
+        twice_area += cross;
+        weighted_sum = weighted_sum + ((p1 + p2) * cross);
+    }
+
+    if ( std::fabs(twice_area) < 1e-10f )
+    {
+        return meanPoint();
+    }
+    return origin + (weighted_sum / (3.0f * twice_area));
+}
+
 float Polygon2D::area() const
 {
     float area = 0.0f;
@@ -183,64 +214,131 @@ float Polygon2D::area() const
 
 bool Polygon2D::isConvex() const
 {
-    if ( vertices.size() <= 2 )
-    {
-        return true;
-    }
-
-    Point2D meanPt = meanPoint();
-    if ( !containsPoint(meanPt) )
-    {
-        return false;
-    }
-
-    for ( size_t i = 0; i < vertices.size(); i++ )
-    {
-        Point2D p1(vertices[i]);
-        Point2D p2(vertices[(i+2)%vertices.size()]);
-        meanPt = (p1 + p2) * 0.5f;
-        if ( !containsPoint(meanPt) )
-        {
-            return false;
-        }
-    }
-    return true;
+    WindingOrder winding_order;
+    return calcConvexity(winding_order);
 }
 
 bool Polygon2D::isApproximatelyConvex(float tolerance) const
 {
+    WindingOrder winding_order;
+    return calcConvexity(winding_order, tolerance, true);
+}
+
+bool Polygon2D::calcConvexity(
+        WindingOrder& winding_order,
+        float tolerance,
+        bool ignore_repeated_points) const
+{
+    winding_order = WindingOrder::COLLINEAR;
     size_t n_vertices = vertices.size();
+
+    /* skip the first vertex repeated at the end of a closed ring */
+    if ( n_vertices > 1 && vertices.back() == vertices.front() )
+    {
+        n_vertices--;
+    }
     if ( n_vertices <= 2 )
     {
         return true;
     }
 
-    Point2D meanPt = meanPoint();
-    if ( !containsPoint(meanPt) )
+    /* find the first vertex which is not a repetition of its predecessor */
+    size_t start = 0;
+    while ( start < n_vertices &&
+            vertices[start] == vertices[(start + n_vertices - 1) % n_vertices] )
     {
-        return false;
+        if ( !ignore_repeated_points )
+        {
+            return false;
+        }
+        start++;
+    }
+    if ( start == n_vertices )
+    {
+        return true; // all vertices are the same point
     }
 
+    /**
+     * a turn by angle a between edges e1 and e2 lies within the tolerance if
+     * sin(a)^2 = cross^2 / (|e1|^2 * |e2|^2) <= sin(tolerance)^2, and is
+     * forward or backward depending on the sign of the dot product. Squares
+     * are taken in double so that they neither overflow nor underflow.
+     */
+    const double sin_tolerance = std::sin(std::min(std::max(tolerance, 0.0f),
+                                                   static_cast<float>(M_PI_2)));
+    const double sqr_sin_tolerance = sin_tolerance * sin_tolerance;
+
+    Vector2D prev_edge = vertices[start] - vertices[(start + n_vertices - 1) % n_vertices];
+    double prev_sqr_length = calcSquaredLength(prev_edge);
+    int winding_number = 0;
+    int turn_sign = 0;
     for ( size_t i = 0; i < n_vertices; i++ )
     {
-        const Point2D& p1 = vertices[i];
-        const Point2D& p2 = vertices[(i+1)%n_vertices];
-        const Point2D& p3 = vertices[(i+2)%n_vertices];
-
-        // Ignore repeated points
-        if (p2 == p3)
-            continue;
-
-        meanPt = (p1 + p3) * 0.5f;
-        // If the mean point is not contained inside the polygon, check if the
-        // three consecutive points are collinear within the tolerance. If they
-        // not collinear, the polygon is not convex
-        if ( !containsPoint(meanPt) &&
-             Utils::calcWindingOrder(p1, p2, p3, tolerance) != WindingOrder::COLLINEAR )
+        const Point2D& curr = vertices[(start + i) % n_vertices];
+        const Point2D& next = vertices[(start + i + 1) % n_vertices];
+        if ( next == curr )
+        {
+            if ( !ignore_repeated_points )
+            {
+                return false;
+            }
+            continue; // ignore repeated points
+        }
+
+        const Vector2D edge = next - curr;
+        const double sqr_length = calcSquaredLength(edge);
+        const float cross = prev_edge.scalarCrossProduct(edge);
+        const float dot = prev_edge.dotProduct(edge);
+
+        // winding of the edge directions around the origin (crossings of the
+        // positive X axis); one for each revolution of the polygon
+        if ( prev_edge.y <= 0.0f )
+        {
+            if ( edge.y > 0.0f && cross > 0.0f )
+            {
+                winding_number++;
+            }
+        }
+        else if ( edge.y <= 0.0f && cross < 0.0f )
+        {
+            winding_number--;
+        }
+        prev_edge = edge;
+
+        const bool is_small_angle = ( static_cast<double>(cross) * cross <=
+                                      sqr_sin_tolerance * prev_sqr_length * sqr_length );
+        prev_sqr_length = sqr_length;
+        if ( is_small_angle && dot < 0.0f )
+        {
+            return false; // polygon reverses its direction
+        }
+        if ( is_small_angle )
+        {
+            continue; // collinear within tolerance
+        }
+
+        const int sign = ( cross > 0.0f ) ? 1 : -1;
+        if ( turn_sign == 0 )
+        {
+            turn_sign = sign;
+        }
+        else if ( turn_sign != sign )
         {
             return false;
         }
     }
+
+    // a simple polygon turns by exactly one revolution while a self
+    // intersecting polygon with consistent turns (e.g. a pentagram) turns
+    // multiple times
+    if ( std::abs(winding_number) > 1 )
+    {
+        return false;
+    }
+
+    winding_order = ( turn_sign > 0 ) ? WindingOrder::COUNTER_CLOCKWISE :
+                    ( turn_sign < 0 ) ? WindingOrder::CLOCKWISE :
+                                        WindingOrder::COLLINEAR;
     return true;
 }
 
@@ -252,14 +350,14 @@ Polygon2D Polygon2D::calcConvexHullOfPolygons(
      * source: https://en.wikipedia.org/wiki/Graham_scan#Pseudocode
      */
 
-    /* aggregate all points */
-    PointVec2D pts;
+    /* aggregate all points (scratch memory from the active arena, if any) */
+    ArenaVector<Point2D> pts;
     pts.reserve(pts.size() + polygon_a.vertices.size() + polygon_b.vertices.size());
     pts.insert(pts.end(), polygon_a.vertices.begin(), polygon_a.vertices.end());
     pts.insert(pts.end(), polygon_b.vertices.begin(), polygon_b.vertices.end());
     if ( pts.size() < 3 )
     {
-        return pts;
+        return Polygon2D(PointVec2D(pts.begin(), pts.end()));
     }
 
     /* find the lowest left most point */
@@ -285,12 +383,12 @@ Polygon2D Polygon2D::calcConvexHullOfPolygons(
               });
 
     /* walk along pts and remove points that form non counter clockwise turn */
-    PointVec2D convex_hull;
+    ArenaVector<Point2D> convex_hull;
     for ( Point2D& p : pts )
     {
         while ( convex_hull.size() > 1 )
         {
-            PointVec2D::const_iterator it = convex_hull.end();
+            ArenaVector<Point2D>::const_iterator it = convex_hull.end();
             float angle = Utils::calcAngleBetweenPoints(p, *(it-1), *(it-2));
             if ( angle > 0 ) // counter clockwise turn is allowed
             {
@@ -300,7 +398,7 @@ Polygon2D Polygon2D::calcConvexHullOfPolygons(
         }
         convex_hull.push_back(p);
     }
-    return Polygon2D(convex_hull);
+    return Polygon2D(PointVec2D(convex_hull.begin(), convex_hull.end()));
 }
 
 Polygon2D Polygon2D::calcInflatedPolygon(float inflation_dist) const
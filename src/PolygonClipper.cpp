@@ -0,0 +1,1209 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+
+#include <geometry_common/PolygonClipper.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+namespace
+{
+
+/**
+ * @brief Point with double precision used internally during the sweep so that
+ * intersection points introduced while splitting edges do not accumulate
+ * rounding errors
+ */
+struct ClipPoint
+{
+    double x, y;
+
+    ClipPoint(double _x = 0.0, double _y = 0.0):
+        x(_x), y(_y) {}
+
+    bool operator == (const ClipPoint& other) const
+    {
+        return ( x == other.x && y == other.y );
+    }
+
+    bool operator != (const ClipPoint& other) const
+    {
+        return !((*this) == other);
+    }
+};
+
+enum class EdgeType
+{
+    NORMAL,
+    NON_CONTRIBUTING,
+    SAME_TRANSITION,
+    DIFFERENT_TRANSITION
+};
+
+struct SweepEvent;
+
+/**
+ * @brief Orders the left events of the edges currently intersected by the
+ * sweep line from bottom to top
+ */
+struct SegmentComparator
+{
+    bool operator () (const SweepEvent* le1, const SweepEvent* le2) const;
+};
+
+using SweepLine = std::set<SweepEvent*, SegmentComparator>;
+
+/**
+ * @brief Endpoint of an edge. Every edge is represented by a left and a right
+ * event pointing to each other.
+ */
+struct SweepEvent
+{
+    ClipPoint point;
+    bool left{false};
+    SweepEvent* other_event{nullptr};
+    bool is_subject{false};
+    EdgeType type{EdgeType::NORMAL};
+    /// true if the edge is an inside-outside transition of its own polygon
+    bool in_out{false};
+    /// true if the edge is an inside-outside transition of the other polygon
+    bool other_in_out{false};
+    /// closest edge below this edge that is part of the result
+    SweepEvent* prev_in_result{nullptr};
+    /// 0: not in result, 1: outside-inside transition, -1: inside-outside
+    int result_transition{0};
+    /// id of the result edge (later of the result ring) of a left event
+    int result_edge_id{-1};
+    size_t contour_id{0};
+    size_t id{0};
+    SweepLine::iterator sweep_line_pos;
+
+    inline bool isInResult() const
+    {
+        return ( result_transition != 0 );
+    }
+
+    inline bool isVertical() const
+    {
+        return ( point.x == other_event->point.x );
+    }
+
+    bool isBelow(const ClipPoint& p) const;
+
+    inline bool isAbove(const ClipPoint& p) const
+    {
+        return !isBelow(p);
+    }
+};
+
+inline double calcSignedArea(const ClipPoint& p0, const ClipPoint& p1,
+                             const ClipPoint& p2)
+{
+    return (p0.x - p2.x) * (p1.y - p2.y) - (p1.x - p2.x) * (p0.y - p2.y);
+}
+
+bool SweepEvent::isBelow(const ClipPoint& p) const
+{
+    return ( left )
+           ? calcSignedArea(point, other_event->point, p) > 0
+           : calcSignedArea(other_event->point, point, p) > 0;
+}
+
+/**
+ * @brief Check if p lies on the line through the edge of le. Endpoints of split
+ * edges are rounded, so a point on the line may be off by a tiny distance.
+ */
+bool isOnLine(const SweepEvent* le, const ClipPoint& p)
+{
+    const ClipPoint& a = le->point;
+    const ClipPoint& b = le->other_event->point;
+    double scale = std::max(1.0, std::max(std::max(std::fabs(a.x), std::fabs(a.y)),
+                                          std::max(std::fabs(b.x), std::fabs(b.y))));
+    double length = std::hypot(b.x - a.x, b.y - a.y);
+    return ( std::fabs(calcSignedArea(a, b, p)) <= 1e-9 * scale * length );
+}
+
+/**
+ * @brief Ordering of events in the event queue
+ *
+ * @return int 1 if e1 has to be processed after e2, -1 otherwise
+ */
+int compareEvents(const SweepEvent* e1, const SweepEvent* e2)
+{
+    const ClipPoint& p1 = e1->point;
+    const ClipPoint& p2 = e2->point;
+
+    if ( p1.x != p2.x )
+    {
+        return ( p1.x > p2.x ) ? 1 : -1;
+    }
+    if ( p1.y != p2.y )
+    {
+        return ( p1.y > p2.y ) ? 1 : -1;
+    }
+
+    // same point, right events are processed first
+    if ( e1->left != e2->left )
+    {
+        return ( e1->left ) ? 1 : -1;
+    }
+
+    // same point, both events are left or right; the event of the edge that
+    // lies below is processed first
+    if ( calcSignedArea(p1, e1->other_event->point, e2->other_event->point) != 0 )
+    {
+        return ( !e1->isBelow(e2->other_event->point) ) ? 1 : -1;
+    }
+
+    if ( e1->is_subject != e2->is_subject )
+    {
+        return ( !e1->is_subject && e2->is_subject ) ? 1 : -1;
+    }
+    return ( e1->id > e2->id ) ? 1 : -1;
+}
+
+struct EventQueueComparator
+{
+    bool operator () (const SweepEvent* e1, const SweepEvent* e2) const
+    {
+        return ( compareEvents(e1, e2) > 0 );
+    }
+};
+
+using EventQueue = std::priority_queue<SweepEvent*, std::vector<SweepEvent*>,
+                                       EventQueueComparator>;
+
+/**
+ * @brief Ordering of edges in the sweep line
+ *
+ * @return int -1 if le1 lies below le2, 1 otherwise
+ */
+int compareSegments(const SweepEvent* le1, const SweepEvent* le2)
+{
+    if ( le1 == le2 )
+    {
+        return 0;
+    }
+
+    if ( calcSignedArea(le1->point, le1->other_event->point, le2->point) != 0 ||
+         calcSignedArea(le1->point, le1->other_event->point, le2->other_event->point) != 0 )
+    {
+        // segments are not collinear
+
+        // same left endpoint, use the right endpoint to sort
+        if ( le1->point == le2->point )
+        {
+            return ( le1->isBelow(le2->other_event->point) ) ? -1 : 1;
+        }
+
+        // different left endpoint, use the left endpoint to sort
+        if ( le1->point.x == le2->point.x )
+        {
+            return ( le1->point.y < le2->point.y ) ? -1 : 1;
+        }
+
+        // has the line segment associated to le1 been inserted into the
+        // sweep line after the line segment associated to le2?
+        if ( compareEvents(le1, le2) == 1 )
+        {
+            // if le1 starts on the line of le2, the side of its right
+            // endpoint decides; otherwise both orders would report "above"
+            // and the segments would compare equal
+            if ( isOnLine(le2, le1->point) )
+            {
+                return ( le2->isAbove(le1->other_event->point) ) ? -1 : 1;
+            }
+            return ( le2->isAbove(le1->point) ) ? -1 : 1;
+        }
+
+        // the line segment associated to le2 has been inserted into the
+        // sweep line after the line segment associated to le1
+        if ( isOnLine(le1, le2->point) )
+        {
+            return ( le1->isBelow(le2->other_event->point) ) ? -1 : 1;
+        }
+        return ( le1->isBelow(le2->point) ) ? -1 : 1;
+    }
+
+    // segments are collinear
+    if ( le1->is_subject == le2->is_subject )
+    {
+        if ( le1->point == le2->point )
+        {
+            if ( le1->contour_id != le2->contour_id )
+            {
+                return ( le1->contour_id > le2->contour_id ) ? 1 : -1;
+            }
+            return ( le1->id > le2->id ) ? 1 : -1;
+        }
+    }
+    else
+    {
+        return ( le1->is_subject ) ? -1 : 1;
+    }
+
+    return ( compareEvents(le1, le2) == 1 ) ? 1 : -1;
+}
+
+bool SegmentComparator::operator () (const SweepEvent* le1,
+                                     const SweepEvent* le2) const
+{
+    return ( compareSegments(le1, le2) < 0 );
+}
+
+/**
+ * @brief Replace an intersection point by an endpoint of the segments if it
+ * only differs from it by rounding. Otherwise an intersection at an endpoint
+ * that is computed slightly off would split an edge into a (nearly) zero
+ * length piece, which the sweep line can not order.
+ */
+ClipPoint snapToEndpoint(const ClipPoint& p,
+                         const ClipPoint& a1, const ClipPoint& a2,
+                         const ClipPoint& b1, const ClipPoint& b2)
+{
+    // inputs are floats; 1e-9 relative is far below their resolution and far
+    // above the rounding error of the intersection in double
+    double scale = 1.0;
+    for ( const ClipPoint* q : {&a1, &a2, &b1, &b2} )
+    {
+        scale = std::max(scale, std::max(std::fabs(q->x), std::fabs(q->y)));
+    }
+    const double tolerance = 1e-9 * scale;
+    for ( const ClipPoint* q : {&a1, &a2, &b1, &b2} )
+    {
+        if ( std::fabs(p.x - q->x) <= tolerance && std::fabs(p.y - q->y) <= tolerance )
+        {
+            return *q;
+        }
+    }
+    return p;
+}
+
+/**
+ * @brief Calculate the intersection of two segments
+ *
+ * @return size_t number of intersection points written to i0 and i1. Two
+ * points are returned only for overlapping collinear segments.
+ */
+size_t calcSegmentIntersection(const ClipPoint& a1, const ClipPoint& a2,
+                               const ClipPoint& b1, const ClipPoint& b2,
+                               ClipPoint& i0, ClipPoint& i1)
+{
+    const ClipPoint va{a2.x - a1.x, a2.y - a1.y};
+    const ClipPoint vb{b2.x - b1.x, b2.y - b1.y};
+    const ClipPoint e{b1.x - a1.x, b1.y - a1.y};
+
+    auto crossProduct = [](const ClipPoint& a, const ClipPoint& b)
+    {
+        return a.x * b.y - a.y * b.x;
+    };
+    auto toPoint = [](const ClipPoint& p, double s, const ClipPoint& d)
+    {
+        return ClipPoint{p.x + s * d.x, p.y + s * d.y};
+    };
+
+    // endpoints of split edges are rounded. Hence edges on the same line may
+    // appear marginally non parallel and an intersection at an endpoint may be
+    // computed marginally outside of the segments.
+    const double tolerance = 1e-9;
+    const double sqr_tolerance = tolerance * tolerance;
+    const double sqr_len_a = va.x * va.x + va.y * va.y;
+    const double sqr_len_b = vb.x * vb.x + vb.y * vb.y;
+    const double sqr_len_e = e.x * e.x + e.y * e.y;
+
+    double kross = crossProduct(va, vb);
+    if ( kross * kross > sqr_tolerance * sqr_len_a * sqr_len_b )
+    {
+        // lines of the segments are not parallel
+        double s = crossProduct(e, vb) / kross;
+        if ( s < -tolerance || s > 1 + tolerance )
+        {
+            return 0;
+        }
+        double t = crossProduct(e, va) / kross;
+        if ( t < -tolerance || t > 1 + tolerance )
+        {
+            return 0;
+        }
+        if ( t == 0 || t == 1 )
+        {
+            i0 = ( t == 0 ) ? b1 : b2;
+            return 1;
+        }
+        s = std::min(std::max(s, 0.0), 1.0);
+        i0 = snapToEndpoint(toPoint(a1, s, va), a1, a2, b1, b2);
+        return 1;
+    }
+
+    // lines of the segments are parallel
+    const double cross_e = crossProduct(e, va);
+    if ( cross_e * cross_e > sqr_tolerance * sqr_len_a * sqr_len_e )
+    {
+        return 0; // not collinear
+    }
+
+    const double sa = (va.x * e.x + va.y * e.y) / sqr_len_a;
+    const double sb = sa + (va.x * vb.x + va.y * vb.y) / sqr_len_a;
+    const double smin = std::min(sa, sb);
+    const double smax = std::max(sa, sb);
+
+    if ( smin > 1 + tolerance || smax < -tolerance )
+    {
+        return 0;
+    }
+    if ( smin >= 1 - tolerance )
+    {
+        i0 = a2;
+        return 1;
+    }
+    if ( smax <= tolerance )
+    {
+        i0 = a1;
+        return 1;
+    }
+    i0 = ( smin > 0 ) ? toPoint(a1, smin, va) : a1;
+    i1 = ( smax < 1 ) ? toPoint(a1, smax, va) : a2;
+    return 2;
+}
+
+/**
+ * @brief Container of all the events created during one boolean operation.
+ * A deque is used so that pointers to the events stay valid while new events
+ * are added when edges are split.
+ */
+class EventPool
+{
+    public:
+        SweepEvent* createEvent(const ClipPoint& point, bool left,
+                                SweepEvent* other_event, bool is_subject)
+        {
+            events_.emplace_back();
+            SweepEvent* event = &events_.back();
+            event->point = point;
+            event->left = left;
+            event->other_event = other_event;
+            event->is_subject = is_subject;
+            event->id = events_.size();
+            return event;
+        }
+
+    private:
+        std::deque<SweepEvent> events_;
+};
+
+/**
+ * @brief Split the edge associated to le at point p
+ */
+void divideSegment(SweepEvent* le, const ClipPoint& p, EventQueue& queue,
+                   EventPool& pool)
+{
+    SweepEvent* r = pool.createEvent(p, false, le, le->is_subject);
+    SweepEvent* l = pool.createEvent(p, true, le->other_event, le->is_subject);
+    r->contour_id = l->contour_id = le->contour_id;
+
+    // avoid a rounding error. The left event would be processed after the
+    // right event
+    if ( compareEvents(l, le->other_event) > 0 )
+    {
+        le->other_event->left = true;
+        l->left = false;
+    }
+
+    le->other_event->other_event = l;
+    le->other_event = r;
+
+    queue.push(l);
+    queue.push(r);
+}
+
+/**
+ * @brief Decide whether both polygons change their state in the same way at
+ * the edge of le, if it overlaps an edge of the other polygon
+ *
+ * The overlapping edge lies directly above le and is non contributing, so its
+ * in_out equals !le->other_in_out. Its own flags may still be those computed
+ * against another edge it overlapped before being split, so they are not used.
+ */
+void updateTransitionType(SweepEvent* le)
+{
+    if ( le->type == EdgeType::SAME_TRANSITION ||
+         le->type == EdgeType::DIFFERENT_TRANSITION )
+    {
+        le->type = ( le->in_out != le->other_in_out )
+                   ? EdgeType::SAME_TRANSITION
+                   : EdgeType::DIFFERENT_TRANSITION;
+    }
+}
+
+/**
+ * @brief Check the edges of le1 and le2 for intersection and split them
+ * accordingly
+ *
+ * @return int 0: no intersection or intersection at a shared endpoint,
+ * 1: edges intersect at a point, 2: edges overlap and share the left
+ * endpoint, 3: edges overlap partially
+ */
+int handlePossibleIntersection(SweepEvent* le1, SweepEvent* le2,
+                               EventQueue& queue, EventPool& pool)
+{
+    ClipPoint i0, i1;
+    size_t num_of_intersections = calcSegmentIntersection(
+            le1->point, le1->other_event->point,
+            le2->point, le2->other_event->point, i0, i1);
+
+    if ( num_of_intersections == 0 )
+    {
+        return 0;
+    }
+
+    // the edges intersect at an endpoint of both edges
+    if ( num_of_intersections == 1 &&
+         (le1->point == le2->point ||
+          le1->other_event->point == le2->other_event->point) )
+    {
+        return 0;
+    }
+
+    // overlapping edges of the same polygon are not supported; ignore them
+    if ( num_of_intersections == 2 && le1->is_subject == le2->is_subject )
+    {
+        return 0;
+    }
+
+    // the edges intersect at a single point
+    if ( num_of_intersections == 1 )
+    {
+        if ( le1->point != i0 && le1->other_event->point != i0 )
+        {
+            divideSegment(le1, i0, queue, pool);
+        }
+        if ( le2->point != i0 && le2->other_event->point != i0 )
+        {
+            divideSegment(le2, i0, queue, pool);
+        }
+        return 1;
+    }
+
+    // the edges overlap
+    std::vector<SweepEvent*> events;
+    bool left_coincide = false;
+    bool right_coincide = false;
+
+    if ( le1->point == le2->point )
+    {
+        left_coincide = true;
+    }
+    else if ( compareEvents(le1, le2) == 1 )
+    {
+        events.push_back(le2);
+        events.push_back(le1);
+    }
+    else
+    {
+        events.push_back(le1);
+        events.push_back(le2);
+    }
+
+    if ( le1->other_event->point == le2->other_event->point )
+    {
+        right_coincide = true;
+    }
+    else if ( compareEvents(le1->other_event, le2->other_event) == 1 )
+    {
+        events.push_back(le2->other_event);
+        events.push_back(le1->other_event);
+    }
+    else
+    {
+        events.push_back(le1->other_event);
+        events.push_back(le2->other_event);
+    }
+
+    if ( left_coincide )
+    {
+        // both edges are equal or share the left endpoint
+        // the transition type of le1 is derived from its flags by
+        // computeFields, which the caller runs again for both edges
+        le2->type = EdgeType::NON_CONTRIBUTING;
+        le1->type = EdgeType::SAME_TRANSITION;
+        updateTransitionType(le1);
+
+        if ( !right_coincide )
+        {
+            divideSegment(events[1]->other_event, events[0]->point, queue, pool);
+        }
+        return 2;
+    }
+
+    // the edges share the right endpoint
+    if ( right_coincide )
+    {
+        divideSegment(events[0], events[1]->point, queue, pool);
+        return 3;
+    }
+
+    // no edge includes totally the other one
+    if ( events[0] != events[3]->other_event )
+    {
+        divideSegment(events[0], events[1]->point, queue, pool);
+        divideSegment(events[1], events[2]->point, queue, pool);
+        return 3;
+    }
+
+    // one edge includes the other one
+    divideSegment(events[0], events[1]->point, queue, pool);
+    divideSegment(events[3]->other_event, events[2]->point, queue, pool);
+    return 3;
+}
+
+bool isInResult(const SweepEvent* event, const BooleanOperation& operation)
+{
+    switch ( event->type )
+    {
+        case EdgeType::NORMAL:
+            switch ( operation )
+            {
+                case BooleanOperation::INTERSECTION:
+                    return !event->other_in_out;
+                case BooleanOperation::UNION:
+                    return event->other_in_out;
+                case BooleanOperation::DIFFERENCE:
+                    return ( (event->is_subject && event->other_in_out) ||
+                             (!event->is_subject && !event->other_in_out) );
+                case BooleanOperation::XOR:
+                    return true;
+                default:
+                    return false;
+            }
+        case EdgeType::SAME_TRANSITION:
+            return ( operation == BooleanOperation::INTERSECTION ||
+                     operation == BooleanOperation::UNION );
+        case EdgeType::DIFFERENT_TRANSITION:
+            return ( operation == BooleanOperation::DIFFERENCE );
+        case EdgeType::NON_CONTRIBUTING:
+        default:
+            return false;
+    }
+}
+
+int calcResultTransition(const SweepEvent* event,
+                         const BooleanOperation& operation)
+{
+    bool this_in = !event->in_out;
+    bool that_in = !event->other_in_out;
+
+    // for overlapping edges the other polygon changes its state at the edge
+    // as well
+    if ( event->type == EdgeType::SAME_TRANSITION )
+    {
+        return ( this_in ) ? 1 : -1;
+    }
+    if ( event->type == EdgeType::DIFFERENT_TRANSITION )
+    {
+        return ( this_in == event->is_subject ) ? 1 : -1;
+    }
+
+    bool is_in = false;
+    switch ( operation )
+    {
+        case BooleanOperation::INTERSECTION:
+            is_in = this_in && that_in;
+            break;
+        case BooleanOperation::UNION:
+            is_in = this_in || that_in;
+            break;
+        case BooleanOperation::XOR:
+            is_in = this_in != that_in;
+            break;
+        case BooleanOperation::DIFFERENCE:
+            is_in = ( event->is_subject )
+                    ? this_in && !that_in
+                    : that_in && !this_in;
+            break;
+        default:
+            break;
+    }
+    return ( is_in ) ? 1 : -1;
+}
+
+/**
+ * @brief Compute the in/out flags of event based on the edge immediately
+ * below it in the sweep line
+ */
+void computeFields(SweepEvent* event, const SweepEvent* prev,
+                   const BooleanOperation& operation)
+{
+    if ( prev == nullptr )
+    {
+        event->in_out = false;
+        event->other_in_out = true;
+    }
+    else
+    {
+        if ( event->is_subject == prev->is_subject )
+        {
+            // an edge starting on a vertical edge lies right of it, which
+            // is the side the vertical edge considers below
+            event->in_out = ( prev->isVertical() ) ? prev->in_out : !prev->in_out;
+            event->other_in_out = prev->other_in_out;
+        }
+        else
+        {
+            event->in_out = !prev->other_in_out;
+            event->other_in_out = ( prev->isVertical() )
+                                  ? !prev->in_out
+                                  : prev->in_out;
+        }
+
+        event->prev_in_result = ( !prev->isInResult() || prev->isVertical() )
+                                ? prev->prev_in_result
+                                : const_cast<SweepEvent*>(prev);
+    }
+
+    updateTransitionType(event);
+    event->result_transition = ( isInResult(event, operation) )
+                               ? calcResultTransition(event, operation)
+                               : 0;
+}
+
+/**
+ * @brief Edge of the result, directed such that the result region lies on its
+ * left side
+ */
+struct ResultEdge
+{
+    size_t start_vertex_id{0};
+    size_t end_vertex_id{0};
+    double angle{0.0};
+    const SweepEvent* left_event{nullptr};
+    int ring_id{-1};
+};
+
+struct Ring
+{
+    std::vector<ClipPoint> points;
+    const SweepEvent* first_event{nullptr};
+    double area{0.0};
+};
+
+/**
+ * @brief Trace the closed rings formed by the edges that are part of the
+ * result. At every vertex the ring continues along the first outgoing edge in
+ * clockwise direction from the incoming edge. Hence rings touching each other
+ * at a vertex are separated, boundaries are counter clockwise and holes are
+ * clockwise.
+ */
+std::vector<Ring> traceRings(const std::vector<SweepEvent*>& sorted_events)
+{
+    std::vector<ResultEdge> edges;
+    std::vector<ClipPoint> vertices;
+    std::map<std::pair<double, double>, size_t> vertex_ids;
+    auto calcVertexId = [&](const ClipPoint& p)
+    {
+        auto it = vertex_ids.insert(std::make_pair(std::make_pair(p.x, p.y),
+                                                   vertices.size()));
+        if ( it.second )
+        {
+            vertices.push_back(p);
+        }
+        return it.first->second;
+    };
+
+    for ( SweepEvent* event : sorted_events )
+    {
+        if ( !event->left || !event->isInResult() )
+        {
+            continue;
+        }
+
+        ResultEdge edge;
+        edge.left_event = event;
+        const ClipPoint& start = ( event->result_transition > 0 )
+                                 ? event->point : event->other_event->point;
+        const ClipPoint& end = ( event->result_transition > 0 )
+                               ? event->other_event->point : event->point;
+        edge.start_vertex_id = calcVertexId(start);
+        edge.end_vertex_id = calcVertexId(end);
+        edge.angle = std::atan2(end.y - start.y, end.x - start.x);
+        event->result_edge_id = edges.size();
+        edges.push_back(edge);
+    }
+
+    std::vector<std::vector<size_t>> outgoing_edges(vertices.size());
+    for ( size_t i = 0; i < edges.size(); i++ )
+    {
+        outgoing_edges[edges[i].start_vertex_id].push_back(i);
+    }
+
+    std::vector<Ring> rings;
+    for ( size_t i = 0; i < edges.size(); i++ )
+    {
+        if ( edges[i].ring_id >= 0 )
+        {
+            continue;
+        }
+
+        Ring ring;
+        ring.first_event = edges[i].left_event;
+        size_t edge_id = i;
+        while ( true )
+        {
+            ResultEdge& edge = edges[edge_id];
+            edge.ring_id = rings.size();
+            ring.points.push_back(vertices[edge.start_vertex_id]);
+
+            const double back_angle = edge.angle + M_PI;
+            double min_delta = std::numeric_limits<double>::max();
+            int next_edge_id = -1;
+            for ( size_t candidate_id : outgoing_edges[edge.end_vertex_id] )
+            {
+                double delta = std::fmod(back_angle - edges[candidate_id].angle,
+                                         2 * M_PI);
+                if ( delta <= 0 )
+                {
+                    delta += 2 * M_PI;
+                }
+                if ( delta < min_delta )
+                {
+                    min_delta = delta;
+                    next_edge_id = candidate_id;
+                }
+            }
+
+            if ( next_edge_id < 0 || edges[next_edge_id].ring_id >= 0 )
+            {
+                break; // ring is closed
+            }
+            edge_id = next_edge_id;
+        }
+
+        for ( size_t j = 0, k = ring.points.size() - 1; j < ring.points.size(); k = j++ )
+        {
+            ring.area += ring.points[k].x * ring.points[j].y
+                       - ring.points[j].x * ring.points[k].y;
+        }
+        ring.area /= 2;
+        rings.push_back(ring);
+    }
+
+    // rings are only needed in terms of events from now on
+    for ( SweepEvent* event : sorted_events )
+    {
+        if ( event->left && event->isInResult() )
+        {
+            event->result_edge_id = edges[event->result_edge_id].ring_id;
+        }
+    }
+    return rings;
+}
+
+/**
+ * @brief Create a polygon from the points of a ring while dropping the
+ * vertices introduced by splitting collinear edges
+ */
+Polygon2D asPolygon(const std::vector<ClipPoint>& points)
+{
+    std::vector<ClipPoint> vertices;
+    vertices.reserve(points.size());
+    for ( const ClipPoint& point : points )
+    {
+        while ( vertices.size() >= 2 &&
+                calcSignedArea(vertices[vertices.size()-2], vertices.back(), point) == 0 )
+        {
+            vertices.pop_back();
+        }
+        vertices.push_back(point);
+    }
+    while ( vertices.size() >= 3 &&
+            calcSignedArea(vertices[vertices.size()-2], vertices.back(), vertices.front()) == 0 )
+    {
+        vertices.pop_back();
+    }
+    size_t first = 0;
+    while ( vertices.size() - first >= 3 &&
+            calcSignedArea(vertices.back(), vertices[first], vertices[first+1]) == 0 )
+    {
+        first++;
+    }
+
+    Polygon2D polygon;
+    polygon.vertices.reserve(vertices.size() - first);
+    for ( size_t i = first; i < vertices.size(); i++ )
+    {
+        polygon.vertices.push_back(Point2D(vertices[i].x, vertices[i].y));
+    }
+    return polygon;
+}
+
+struct BoundingBox
+{
+    double min_x{std::numeric_limits<double>::max()};
+    double min_y{std::numeric_limits<double>::max()};
+    double max_x{std::numeric_limits<double>::lowest()};
+    double max_y{std::numeric_limits<double>::lowest()};
+};
+
+/**
+ * @brief Add the left and right events of all the edges of a ring to the
+ * event queue
+ */
+void fillQueue(const Polygon2D& ring, bool is_subject, size_t contour_id,
+               EventQueue& queue, EventPool& pool, BoundingBox& bbox)
+{
+    const size_t num_of_vertices = ring.size();
+    if ( num_of_vertices < 3 )
+    {
+        return;
+    }
+
+    for ( size_t i = 0; i < num_of_vertices; i++ )
+    {
+        const ClipPoint p1{ring[i].x, ring[i].y};
+        const Point2D& next = ring[(i+1) % num_of_vertices];
+        const ClipPoint p2{next.x, next.y};
+
+        if ( p1 == p2 )
+        {
+            continue; // skip collapsed edges
+        }
+
+        SweepEvent* e1 = pool.createEvent(p1, false, nullptr, is_subject);
+        SweepEvent* e2 = pool.createEvent(p2, false, e1, is_subject);
+        e1->other_event = e2;
+        e1->contour_id = e2->contour_id = contour_id;
+
+        if ( compareEvents(e1, e2) > 0 )
+        {
+            e2->left = true;
+        }
+        else
+        {
+            e1->left = true;
+        }
+
+        bbox.min_x = std::min(bbox.min_x, p1.x);
+        bbox.min_y = std::min(bbox.min_y, p1.y);
+        bbox.max_x = std::max(bbox.max_x, p1.x);
+        bbox.max_y = std::max(bbox.max_y, p1.y);
+
+        queue.push(e1);
+        queue.push(e2);
+    }
+}
+
+size_t fillQueue(const std::vector<PolygonWithHoles2D>& polygons,
+                 bool is_subject, size_t contour_id, EventQueue& queue,
+                 EventPool& pool, BoundingBox& bbox)
+{
+    for ( const PolygonWithHoles2D& polygon : polygons )
+    {
+        fillQueue(polygon.boundary, is_subject, contour_id++, queue, pool, bbox);
+        for ( const Polygon2D& hole : polygon.holes )
+        {
+            fillQueue(hole, is_subject, contour_id++, queue, pool, bbox);
+        }
+    }
+    return contour_id;
+}
+
+/**
+ * @brief Group the traced rings into boundaries and their holes. The parent of
+ * a hole is found from the result edge immediately below its first edge in
+ * the sweep line.
+ */
+std::vector<PolygonWithHoles2D> asPolygonsWithHoles(
+        const std::vector<Ring>& rings)
+{
+    std::vector<PolygonWithHoles2D> polygons;
+    std::vector<int> polygon_ids(rings.size(), -1);
+
+    for ( size_t i = 0; i < rings.size(); i++ )
+    {
+        const Ring& ring = rings[i];
+        if ( ring.points.size() < 3 || ring.area == 0 )
+        {
+            continue;
+        }
+
+        if ( ring.area > 0 )
+        {
+            polygon_ids[i] = polygons.size();
+            polygons.push_back(PolygonWithHoles2D(asPolygon(ring.points)));
+            continue;
+        }
+
+        const SweepEvent* lower_event = ring.first_event->prev_in_result;
+        int parent_id = -1;
+        if ( lower_event != nullptr && lower_event->isInResult() &&
+             lower_event->result_edge_id >= 0 &&
+             static_cast<size_t>(lower_event->result_edge_id) < i )
+        {
+            parent_id = polygon_ids[lower_event->result_edge_id];
+        }
+
+        if ( parent_id < 0 )
+        {
+            // fall back to a point in polygon test with a point just outside
+            // of the first edge of the hole
+            const ClipPoint& a = ring.points[0];
+            const ClipPoint& b = ring.points[1];
+            const double offset = 1e-6;
+            const Point2D test_pt((a.x + b.x)/2 - (b.y - a.y) * offset,
+                                  (a.y + b.y)/2 + (b.x - a.x) * offset);
+            float min_area = std::numeric_limits<float>::max();
+            for ( size_t j = 0; j < polygons.size(); j++ )
+            {
+                float area = polygons[j].boundary.area();
+                if ( area < min_area && polygons[j].boundary.containsPoint(test_pt) )
+                {
+                    min_area = area;
+                    parent_id = j;
+                }
+            }
+        }
+
+        if ( parent_id >= 0 )
+        {
+            polygon_ids[i] = parent_id;
+            polygons[parent_id].holes.push_back(asPolygon(ring.points));
+        }
+    }
+    return polygons;
+}
+
+} // namespace
+
+std::vector<PolygonWithHoles2D> PolygonClipper::calcBooleanOperation(
+        const std::vector<PolygonWithHoles2D>& subject,
+        const std::vector<PolygonWithHoles2D>& clipping,
+        const BooleanOperation& operation)
+{
+    if ( operation == BooleanOperation::INVALID )
+    {
+        return std::vector<PolygonWithHoles2D>();
+    }
+
+    EventPool pool;
+    EventQueue queue;
+    BoundingBox subject_bbox, clipping_bbox;
+    size_t contour_id = fillQueue(subject, true, 0, queue, pool, subject_bbox);
+    fillQueue(clipping, false, contour_id, queue, pool, clipping_bbox);
+
+    // trivial cases in which at least one of the operands is empty or the
+    // operands do not overlap
+    const bool is_subject_empty = ( subject_bbox.min_x > subject_bbox.max_x );
+    const bool is_clipping_empty = ( clipping_bbox.min_x > clipping_bbox.max_x );
+    const bool are_disjoint = ( is_subject_empty || is_clipping_empty ||
+                                subject_bbox.min_x > clipping_bbox.max_x ||
+                                clipping_bbox.min_x > subject_bbox.max_x ||
+                                subject_bbox.min_y > clipping_bbox.max_y ||
+                                clipping_bbox.min_y > subject_bbox.max_y );
+    if ( are_disjoint && operation == BooleanOperation::INTERSECTION )
+    {
+        return std::vector<PolygonWithHoles2D>();
+    }
+    const double right_bound = std::min(subject_bbox.max_x, clipping_bbox.max_x);
+
+    SweepLine sweep_line;
+    std::vector<SweepEvent*> sorted_events;
+
+    while ( !queue.empty() )
+    {
+        SweepEvent* event = queue.top();
+        queue.pop();
+
+        // optimisations; events beyond these bounds can not contribute
+        if ( (operation == BooleanOperation::INTERSECTION &&
+              event->point.x > right_bound) ||
+             (operation == BooleanOperation::DIFFERENCE &&
+              event->point.x > subject_bbox.max_x) )
+        {
+            break;
+        }
+
+        sorted_events.push_back(event);
+
+        if ( event->left )
+        {
+            const std::pair<SweepLine::iterator, bool> insertion = sweep_line.insert(event);
+            // compareSegments is a strict total order, so a segment is never
+            // considered equal to one already in the sweep line
+            assert(insertion.second);
+            event->sweep_line_pos = insertion.first;
+            SweepLine::iterator it = event->sweep_line_pos;
+
+            SweepEvent* prev = ( it != sweep_line.begin() ) ? *std::prev(it) : nullptr;
+            SweepLine::iterator next_it = std::next(it);
+            SweepEvent* next = ( next_it != sweep_line.end() ) ? *next_it : nullptr;
+
+            computeFields(event, prev, operation);
+
+            if ( next != nullptr &&
+                 handlePossibleIntersection(event, next, queue, pool) == 2 )
+            {
+                computeFields(event, prev, operation);
+                computeFields(next, event, operation);
+            }
+
+            if ( prev != nullptr &&
+                 handlePossibleIntersection(prev, event, queue, pool) == 2 )
+            {
+                SweepLine::iterator prev_it = std::prev(it);
+                SweepEvent* prev_prev = ( prev_it != sweep_line.begin() )
+                                        ? *std::prev(prev_it) : nullptr;
+                computeFields(prev, prev_prev, operation);
+                computeFields(event, prev, operation);
+            }
+        }
+        else
+        {
+            SweepEvent* left_event = event->other_event;
+            SweepLine::iterator it = left_event->sweep_line_pos;
+
+            if ( it != sweep_line.begin() && std::next(it) != sweep_line.end() )
+            {
+                handlePossibleIntersection(*std::prev(it), *std::next(it),
+                                           queue, pool);
+            }
+            sweep_line.erase(it);
+        }
+    }
+
+    return asPolygonsWithHoles(traceRings(sorted_events));
+}
+
+std::vector<PolygonWithHoles2D> PolygonClipper::calcIntersection(
+        const Polygon2D& subject,
+        const Polygon2D& clipping)
+{
+    return calcBooleanOperation({PolygonWithHoles2D(subject)},
+                                {PolygonWithHoles2D(clipping)},
+                                BooleanOperation::INTERSECTION);
+}
+
+std::vector<PolygonWithHoles2D> PolygonClipper::calcUnion(
+        const Polygon2D& subject,
+        const Polygon2D& clipping)
+{
+    return calcBooleanOperation({PolygonWithHoles2D(subject)},
+                                {PolygonWithHoles2D(clipping)},
+                                BooleanOperation::UNION);
+}
+
+std::vector<PolygonWithHoles2D> PolygonClipper::calcDifference(
+        const Polygon2D& subject,
+        const Polygon2D& clipping)
+{
+    return calcBooleanOperation({PolygonWithHoles2D(subject)},
+                                {PolygonWithHoles2D(clipping)},
+                                BooleanOperation::DIFFERENCE);
+}
+
+std::vector<PolygonWithHoles2D> PolygonClipper::calcXor(
+        const Polygon2D& subject,
+        const Polygon2D& clipping)
+{
+    return calcBooleanOperation({PolygonWithHoles2D(subject)},
+                                {PolygonWithHoles2D(clipping)},
+                                BooleanOperation::XOR);
+}
+
+std::vector<PolygonWithHoles2D> PolygonClipper::calcUnion(
+        const std::vector<Polygon2D>& polygons)
+{
+    std::vector<PolygonWithHoles2D> regions;
+    regions.reserve(polygons.size());
+    for ( const Polygon2D& polygon : polygons )
+    {
+        regions.push_back(PolygonWithHoles2D(polygon));
+    }
+    return calcUnion(regions);
+}
+
+std::vector<PolygonWithHoles2D> PolygonClipper::calcUnion(
+        const std::vector<PolygonWithHoles2D>& polygons)
+{
+    if ( polygons.size() <= 1 )
+    {
+        // a single region is still swept so that the result is normalised
+        return calcBooleanOperation(polygons, {}, BooleanOperation::UNION);
+    }
+
+    // every region in this list is a set of disjoint polygons; merge
+    // neighbouring sets until only one is left
+    std::vector<std::vector<PolygonWithHoles2D>> sets;
+    sets.reserve(polygons.size());
+    for ( const PolygonWithHoles2D& polygon : polygons )
+    {
+        sets.push_back({polygon});
+    }
+
+    while ( sets.size() > 1 )
+    {
+        std::vector<std::vector<PolygonWithHoles2D>> merged_sets;
+        merged_sets.reserve((sets.size() + 1) / 2);
+        for ( size_t i = 0; i + 1 < sets.size(); i += 2 )
+        {
+            merged_sets.push_back(calcBooleanOperation(
+                        sets[i], sets[i+1], BooleanOperation::UNION));
+        }
+        if ( sets.size() % 2 == 1 )
+        {
+            merged_sets.push_back(sets.back());
+        }
+        sets.swap(merged_sets);
+    }
+    return sets.front();
+}
+
+} // namespace geometry_common
+} // namespace kelo
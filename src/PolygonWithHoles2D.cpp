@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cmath>
+#include <geometry_common/PolygonWithHoles2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+bool PolygonWithHoles2D::containsPoint(const Point2D& point) const
+{
+    if ( !boundary.containsPoint(point) )
+    {
+        return false;
+    }
+
+    for ( const Polygon2D& hole : holes )
+    {
+        if ( hole.containsPoint(point) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+float PolygonWithHoles2D::area() const
+{
+    float area = std::fabs(boundary.area());
+    for ( const Polygon2D& hole : holes )
+    {
+        area -= std::fabs(hole.area());
+    }
+    return area;
+}
+
+size_t PolygonWithHoles2D::numOfVertices() const
+{
+    size_t num_of_vertices = boundary.size();
+    for ( const Polygon2D& hole : holes )
+    {
+        num_of_vertices += hole.size();
+    }
+    return num_of_vertices;
+}
+
+std::ostream& operator << (std::ostream& out, const PolygonWithHoles2D& polygon)
+{
+    out << "Boundary: " << polygon.boundary << std::endl;
+    for ( size_t i = 0; i < polygon.holes.size(); i++ )
+    {
+        out << "Hole " << i << ": " << polygon.holes[i] << std::endl;
+    }
+    return out;
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -41,6 +41,7 @@
 #include <geometry_common/LineSegment2D.h>
 #include <geometry_common/Point3D.h>
 #include <geometry_common/Polyline2D.h>
+#include <geometry_common/Utils.h>
 
 namespace kelo
 {
@@ -72,14 +73,7 @@ bool Polyline2D::intersects(const LineSegment2D& line_segment) const
 
 bool Polyline2D::intersects(const Polyline2D& polyline) const
 {
-    for ( size_t start = 0, end = start + 1; end < polyline.size(); start = end++ )
-    {
-        if ( intersects(LineSegment2D(polyline[start], polyline[end])) )
-        {
-            return true;
-        }
-    }
-    return false;
+    return Utils::doPolylinesIntersect(vertices, polyline.vertices, false, false);
 }
 
 bool Polyline2D::calcClosestIntersectionPointWith(
@@ -153,6 +147,11 @@ void Polyline2D::reverse()
     std::reverse(vertices.begin(), vertices.end());
 }
 
+void Polyline2D::simplify(float tolerance)
+{
+    vertices = Utils::simplifyDouglasPeucker(vertices, tolerance);
+}
+
 visualization_msgs::Marker Polyline2D::asMarker(const std::string& frame,
         float red, float green, float blue, float alpha, float line_width,
         bool use_line_strip) const
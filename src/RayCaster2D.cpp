@@ -0,0 +1,268 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <geometry_common/Utils.h>
+#include <geometry_common/RayCaster2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+namespace
+{
+
+/// angular slack when selecting the beams covered by an edge
+const float ANGULAR_TOLERANCE = 1e-5f;
+
+/**
+ * @brief Intersect a ray starting at the origin with a line segment
+ *
+ * @return float distance along the ray or +Inf if they do not intersect
+ */
+inline float calcRayIntersection(float dir_x, float dir_y,
+                                 const Point2D& start, const Vector2D& edge)
+{
+    const float denominator = dir_x * edge.y - dir_y * edge.x;
+    if ( std::fabs(denominator) < 1e-12f )
+    {
+        return std::numeric_limits<float>::infinity(); // parallel
+    }
+    const float t = (start.x * edge.y - start.y * edge.x) / denominator;
+    const float u = (start.x * dir_y - start.y * dir_x) / denominator;
+    if ( t < 0.0f || u < 0.0f || u > 1.0f )
+    {
+        return std::numeric_limits<float>::infinity();
+    }
+    return t;
+}
+
+} // namespace
+
+RayCaster2D::RayCaster2D(
+        const std::vector<LineSegment2D>& segments,
+        const std::vector<Polygon2D>& polygons)
+{
+    updateObstacles(segments, polygons);
+}
+
+void RayCaster2D::updateObstacles(
+        const std::vector<LineSegment2D>& segments,
+        const std::vector<Polygon2D>& polygons)
+{
+    std::vector<LineSegment2D> edges(segments);
+    for ( const Polygon2D& polygon : polygons )
+    {
+        for ( size_t start = polygon.size() - 1, end = 0; end < polygon.size(); start = end++ )
+        {
+            edges.push_back(LineSegment2D(polygon[start], polygon[end]));
+        }
+    }
+    bvh_.build(edges);
+}
+
+void RayCaster2D::calcRanges(
+        const Pose2D& sensor_pose,
+        float angle_min,
+        float angle_max,
+        float angle_increment,
+        float range_max,
+        std::vector<float>& ranges) const
+{
+    ranges.clear();
+    if ( !(angle_increment > 0.0f) || angle_max < angle_min )
+    {
+        return;
+    }
+    const size_t num_of_beams = std::floor((angle_max - angle_min) / angle_increment + 0.5f) + 1;
+    ranges.assign(num_of_beams, std::numeric_limits<float>::infinity());
+    updateDirectionTable(angle_min, angle_increment, num_of_beams);
+
+    std::vector<size_t> indices;
+    bvh_.calcIndicesOverlapping(Box2D(sensor_pose.x - range_max, sensor_pose.x + range_max,
+                                      sensor_pose.y - range_max, sensor_pose.y + range_max),
+                                indices);
+
+    const Point2D sensor_pos(sensor_pose.x, sensor_pose.y);
+    const float cos_theta = std::cos(sensor_pose.theta);
+    const float sin_theta = std::sin(sensor_pose.theta);
+    const float range_max_sq = range_max * range_max;
+    const float last_beam_angle = (num_of_beams - 1) * angle_increment;
+    for ( size_t index : indices )
+    {
+        /* edge in sensor frame */
+        const LineSegment2D& segment = bvh_[index];
+        const Point2D start_diff = segment.start - sensor_pos;
+        const Point2D end_diff = segment.end - sensor_pos;
+        const Point2D start( cos_theta * start_diff.x + sin_theta * start_diff.y,
+                            -sin_theta * start_diff.x + cos_theta * start_diff.y);
+        const Point2D end( cos_theta * end_diff.x + sin_theta * end_diff.y,
+                          -sin_theta * end_diff.x + cos_theta * end_diff.y);
+        const Vector2D edge = end - start;
+
+        const float length_sq = edge.x * edge.x + edge.y * edge.y;
+        const float closest_t = ( length_sq > 0.0f )
+                                ? Utils::clip(-(start.x * edge.x + start.y * edge.y) / length_sq, 1.0f, 0.0f)
+                                : 0.0f;
+        const Point2D closest_pt = start + (edge * closest_t);
+        if ( closest_pt.x * closest_pt.x + closest_pt.y * closest_pt.y > range_max_sq )
+        {
+            continue;
+        }
+
+        /* angular interval covered by the edge relative to the first beam */
+        const float start_angle = std::atan2(start.y, start.x);
+        const float angle_diff = Utils::clipAngle(std::atan2(end.y, end.x) - start_angle);
+        const float span = std::fabs(angle_diff);
+        float lower_angle = ( angle_diff >= 0.0f ) ? start_angle : start_angle + angle_diff;
+        lower_angle = std::fmod(lower_angle - angle_min, 2 * M_PI);
+        if ( lower_angle < 0.0f )
+        {
+            lower_angle += 2 * M_PI;
+        }
+
+        for ( float interval_start = lower_angle - 2 * M_PI;
+              interval_start <= last_beam_angle + ANGULAR_TOLERANCE;
+              interval_start += 2 * M_PI )
+        {
+            const float interval_end = interval_start + span;
+            if ( interval_end < -ANGULAR_TOLERANCE )
+            {
+                continue;
+            }
+            const size_t first_beam = std::max(0.0f, std::ceil(
+                        (interval_start - ANGULAR_TOLERANCE) / angle_increment));
+            const size_t last_beam = std::min<float>(num_of_beams - 1, std::floor(
+                        (interval_end + ANGULAR_TOLERANCE) / angle_increment));
+            for ( size_t i = first_beam; i <= last_beam; i++ )
+            {
+                const float range = calcRayIntersection(cos_table_[i], sin_table_[i],
+                                                        start, edge);
+                if ( range < ranges[i] && range <= range_max )
+                {
+                    ranges[i] = range;
+                }
+            }
+        }
+    }
+}
+
+float RayCaster2D::calcRange(
+        const Pose2D& sensor_pose,
+        float angle,
+        float range_max) const
+{
+    const float dir_x = std::cos(sensor_pose.theta + angle);
+    const float dir_y = std::sin(sensor_pose.theta + angle);
+    const float inv_dir_x = 1.0f / dir_x;
+    const float inv_dir_y = 1.0f / dir_y;
+    const Point2D sensor_pos(sensor_pose.x, sensor_pose.y);
+    float best_range = std::numeric_limits<float>::infinity();
+
+    const std::vector<BVHNode2D>& nodes = bvh_.nodes();
+    const std::vector<uint32_t>& item_indices = bvh_.itemIndices();
+    BVHNode2D::traverse(nodes.data(), nodes.size(),
+            [&](const BVHNode2D& node)
+            {
+                /* slab test of the ray against the bounds of the node */
+                float t_x1 = (node.min_x - sensor_pos.x) * inv_dir_x;
+                float t_x2 = (node.max_x - sensor_pos.x) * inv_dir_x;
+                float t_y1 = (node.min_y - sensor_pos.y) * inv_dir_y;
+                float t_y2 = (node.max_y - sensor_pos.y) * inv_dir_y;
+                if ( std::isnan(t_x1) || std::isnan(t_x2) )
+                {
+                    // ray parallel to and inside of the x slab
+                    t_x1 = -std::numeric_limits<float>::infinity();
+                    t_x2 = std::numeric_limits<float>::infinity();
+                }
+                if ( std::isnan(t_y1) || std::isnan(t_y2) )
+                {
+                    t_y1 = -std::numeric_limits<float>::infinity();
+                    t_y2 = std::numeric_limits<float>::infinity();
+                }
+                const float t_min = std::max(std::min(t_x1, t_x2), std::min(t_y1, t_y2));
+                const float t_max = std::min(std::max(t_x1, t_x2), std::max(t_y1, t_y2));
+                return ( t_max >= std::max(t_min, 0.0f) &&
+                         t_min <= std::min(best_range, range_max) );
+            },
+            [&](size_t item)
+            {
+                const LineSegment2D& segment = bvh_[item_indices[item]];
+                const float range = calcRayIntersection(dir_x, dir_y,
+                        segment.start - sensor_pos, segment.end - segment.start);
+                if ( range < best_range && range <= range_max )
+                {
+                    best_range = range;
+                }
+                return true;
+            });
+    return best_range;
+}
+
+void RayCaster2D::updateDirectionTable(
+        float angle_min,
+        float angle_increment,
+        size_t num_of_beams) const
+{
+    if ( cos_table_.size() == num_of_beams &&
+         cached_angle_min_ == angle_min &&
+         cached_angle_increment_ == angle_increment )
+    {
+        return;
+    }
+
+    cached_angle_min_ = angle_min;
+    cached_angle_increment_ = angle_increment;
+    cos_table_.resize(num_of_beams);
+    sin_table_.resize(num_of_beams);
+    for ( size_t i = 0; i < num_of_beams; i++ )
+    {
+        const double angle = static_cast<double>(angle_min) + i * static_cast<double>(angle_increment);
+        cos_table_[i] = std::cos(angle);
+        sin_table_[i] = std::sin(angle);
+    }
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#include <geometry_common/SinCosTable.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+SinCosTable::SinCosTable(size_t resolution):
+    resolution_(std::max(resolution, static_cast<size_t>(4)))
+{
+    table_.resize(2 * (resolution_ + 1));
+    for ( size_t i = 0; i <= resolution_; i++ )
+    {
+        const double angle = (2.0 * M_PI * i) / resolution_;
+        table_[2*i] = std::sin(angle);
+        table_[(2*i) + 1] = std::cos(angle);
+    }
+}
+
+void SinCosTable::calcSinCos(float angle, float& sin_value, float& cos_value) const
+{
+    if ( !std::isfinite(angle) )
+    {
+        sin_value = std::numeric_limits<float>::quiet_NaN();
+        cos_value = std::numeric_limits<float>::quiet_NaN();
+        return;
+    }
+
+    /* position of angle within one revolution in units of samples; reduced
+     * in double precision to not lose accuracy for large angles */
+    double revolutions = angle * (0.5 / M_PI);
+    revolutions -= std::floor(revolutions);
+    const float position = static_cast<float>(revolutions * resolution_);
+    const size_t index = std::min(static_cast<size_t>(position), resolution_ - 1);
+    const float fraction = position - index;
+
+    const float* sample = &table_[2 * index];
+    sin_value = sample[0] + (fraction * (sample[2] - sample[0]));
+    cos_value = sample[1] + (fraction * (sample[3] - sample[1]));
+}
+
+TransformMatrix2D SinCosTable::calcTransformMatrix(float x, float y, float theta) const
+{
+    float sin_theta, cos_theta;
+    calcSinCos(theta, sin_theta, cos_theta);
+    return TransformMatrix2D::initFromCosSin(x, y, cos_theta, sin_theta);
+}
+
+float SinCosTable::maxError() const
+{
+    /* linear interpolation error of a function bounded by 1 in its second
+     * derivative */
+    const float step = (2.0f * M_PI) / resolution_;
+    const float interpolation_error = step * step / 8.0f;
+
+    /* rounding of position to float shifts the fraction by up to
+     * resolution * 2^-24 samples, i.e. the value by up to 2*pi * 2^-24 since
+     * the slope is at most 1. Rounding of the table value, the product and
+     * the sum adds at most 4 * 2^-24 (values are bounded by 1). */
+    const float epsilon = std::ldexp(1.0f, -24);
+    const float rounding_error = ((2.0f * M_PI) + 4.0f) * epsilon;
+    return interpolation_error + rounding_error;
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -0,0 +1,334 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <exception>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <geometry_common/ThreadPool.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+namespace
+{
+
+/// pool and queue index of the calling worker thread
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local size_t current_queue_index = 0;
+
+/// number of chunks per thread created by parallelFor for load balancing
+const size_t CHUNKS_PER_THREAD = 4;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t num_of_threads, bool pin_threads, size_t first_core)
+{
+    queues_.reserve(num_of_threads);
+    for ( size_t i = 0; i < num_of_threads; i++ )
+    {
+        queues_.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    }
+
+    threads_.reserve(num_of_threads);
+    const size_t num_of_cores = std::thread::hardware_concurrency();
+    for ( size_t i = 0; i < num_of_threads; i++ )
+    {
+        threads_.push_back(std::thread(&ThreadPool::runWorker, this, i));
+#ifdef __linux__
+        if ( pin_threads && num_of_cores > 0 )
+        {
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET((first_core + i) % num_of_cores, &cpu_set);
+            pthread_setaffinity_np(threads_.back().native_handle(),
+                                   sizeof(cpu_set), &cpu_set);
+        }
+#endif
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        is_stopping_ = true;
+    }
+    wake_cv_.notify_all();
+    for ( std::thread& thread : threads_ )
+    {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::defaultNumOfThreads()
+{
+    const size_t num_of_cores = std::thread::hardware_concurrency();
+    return ( num_of_cores > 1 ) ? num_of_cores - 1 : 0;
+}
+
+size_t ThreadPool::numOfThreads() const
+{
+    return threads_.size();
+}
+
+void ThreadPool::submit(const Task& task)
+{
+    if ( queues_.empty() )
+    {
+        task();
+        return;
+    }
+
+    size_t queue_index = ownQueueIndex();
+    if ( queue_index >= queues_.size() )
+    {
+        queue_index = next_queue_.fetch_add(1) % queues_.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[queue_index]->mutex);
+        queues_[queue_index]->tasks.push_back(task);
+    }
+    num_of_queued_tasks_.fetch_add(1);
+
+    // lock once so that a worker checking the predicate can not miss the
+    // notification
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+    }
+    wake_cv_.notify_one();
+}
+
+void ThreadPool::parallelFor(
+        size_t begin,
+        size_t end,
+        size_t grain_size,
+        const std::function<void (size_t, size_t)>& func)
+{
+    if ( end <= begin )
+    {
+        return;
+    }
+
+    const size_t range = end - begin;
+    const size_t num_of_target_chunks = (threads_.size() + 1) * CHUNKS_PER_THREAD;
+    const size_t chunk_size = std::max(std::max<size_t>(grain_size, 1),
+            (range + num_of_target_chunks - 1) / num_of_target_chunks);
+    const size_t num_of_chunks = (range + chunk_size - 1) / chunk_size;
+    if ( threads_.empty() || num_of_chunks <= 1 )
+    {
+        func(begin, end);
+        return;
+    }
+
+    /* state shared with the tasks; valid until all chunks are done */
+    size_t num_of_remaining_chunks = num_of_chunks - 1;
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    std::mutex exception_mutex;
+    std::exception_ptr exception;
+    auto run_chunk = [&](size_t chunk_index)
+    {
+        const size_t chunk_begin = begin + (chunk_index * chunk_size);
+        const size_t chunk_end = std::min(chunk_begin + chunk_size, end);
+        try
+        {
+            func(chunk_begin, chunk_end);
+        }
+        catch ( ... )
+        {
+            std::lock_guard<std::mutex> lock(exception_mutex);
+            if ( !exception )
+            {
+                exception = std::current_exception();
+            }
+        }
+    };
+
+    for ( size_t i = 1; i < num_of_chunks; i++ )
+    {
+        submit([&run_chunk, &num_of_remaining_chunks, &done_mutex, &done_cv, i]()
+               {
+                   run_chunk(i);
+                   // notify while holding the lock; the waiting caller
+                   // destroys done_cv as soon as it sees the last chunk done
+                   std::lock_guard<std::mutex> lock(done_mutex);
+                   if ( --num_of_remaining_chunks == 0 )
+                   {
+                       done_cv.notify_all();
+                   }
+               });
+    }
+    run_chunk(0);
+
+    /* help with pending tasks; once none are left, the remaining chunks are
+     * running on workers and the last of them wakes this thread */
+    Task task;
+    while ( takeTask(ownQueueIndex(), task) )
+    {
+        task();
+    }
+    {
+        std::unique_lock<std::mutex> lock(done_mutex);
+        done_cv.wait(lock, [&num_of_remaining_chunks]()
+                     {
+                         return ( num_of_remaining_chunks == 0 );
+                     });
+    }
+
+    if ( exception )
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::runWorker(size_t worker_index)
+{
+    current_pool = this;
+    current_queue_index = worker_index;
+
+    Task task;
+    while ( true )
+    {
+        if ( takeTask(worker_index, task) )
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_cv_.wait(lock, [this]()
+                      {
+                          return ( is_stopping_ || num_of_queued_tasks_.load() > 0 );
+                      });
+        if ( is_stopping_ && num_of_queued_tasks_.load() == 0 )
+        {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::takeTask(size_t preferred_queue, Task& task)
+{
+    if ( num_of_queued_tasks_.load() == 0 )
+    {
+        return false;
+    }
+
+    const size_t num_of_queues = queues_.size();
+    if ( preferred_queue < num_of_queues )
+    {
+        WorkerQueue& queue = *queues_[preferred_queue];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if ( !queue.tasks.empty() )
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            num_of_queued_tasks_.fetch_sub(1);
+            return true;
+        }
+    }
+
+    const size_t first_victim = ( preferred_queue < num_of_queues ) ? preferred_queue + 1 : 0;
+    for ( size_t i = 0; i < num_of_queues; i++ )
+    {
+        const size_t victim = (first_victim + i) % num_of_queues;
+        if ( victim == preferred_queue )
+        {
+            continue;
+        }
+        WorkerQueue& queue = *queues_[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if ( !queue.tasks.empty() )
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            num_of_queued_tasks_.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ThreadPool::ownQueueIndex() const
+{
+    return ( current_pool == this ) ? current_queue_index : queues_.size();
+}
+
+void ExecutionPolicy::parallelFor(
+        size_t begin,
+        size_t end,
+        const std::function<void (size_t, size_t)>& func) const
+{
+    if ( end <= begin )
+    {
+        return;
+    }
+    if ( !isParallel() || end - begin <= grain_size_ )
+    {
+        func(begin, end);
+        return;
+    }
+    thread_pool_->parallelFor(begin, end, grain_size_, func);
+}
+
+bool ExecutionPolicy::isParallel() const
+{
+    return ( thread_pool_ != nullptr && thread_pool_->numOfThreads() > 0 );
+}
+
+ThreadPool* ExecutionPolicy::threadPool() const
+{
+    return thread_pool_;
+}
+
+size_t ExecutionPolicy::grainSize() const
+{
+    return grain_size_;
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <geometry_common/Utils.h>
+#include <geometry_common/TransformBuffer2D.h>
+
+#include "TransformBufferUtils.h"
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+void TransformBuffer2D::addPose(double stamp, const Pose2D& pose)
+{
+    transform_buffer::insert(buffer_, StampedPose{stamp, pose}, max_duration_);
+}
+
+bool TransformBuffer2D::calcPose(double stamp, Pose2D& pose) const
+{
+    const StampedPose* before;
+    const StampedPose* after;
+    float t;
+    if ( !transform_buffer::findInterval(buffer_, stamp, before, after, t) )
+    {
+        return false;
+    }
+    if ( before == after )
+    {
+        pose = before->pose;
+        return true;
+    }
+    pose.x = before->pose.x + (t * (after->pose.x - before->pose.x));
+    pose.y = before->pose.y + (t * (after->pose.y - before->pose.y));
+    pose.theta = Utils::clipAngle(before->pose.theta +
+            (t * Utils::calcShortestAngle(after->pose.theta, before->pose.theta)));
+    return true;
+}
+
+bool TransformBuffer2D::calcTransform(double stamp, TransformMatrix2D& tf_mat) const
+{
+    Pose2D pose;
+    if ( !calcPose(stamp, pose) )
+    {
+        return false;
+    }
+    tf_mat.update(pose);
+    return true;
+}
+
+bool TransformBuffer2D::deskew(
+        PointCloud2D& cloud,
+        const std::vector<float>& point_time_offsets,
+        double scan_stamp,
+        double target_stamp,
+        size_t num_of_bins) const
+{
+    return transform_buffer::deskew<TransformMatrix2D, 6>(
+            *this, cloud, point_time_offsets, scan_stamp, target_stamp,
+            num_of_bins,
+            [](const float* m, Point2D& pt)
+            {
+                const float x = pt.x;
+                const float y = pt.y;
+                pt.x = (m[0] * x) + (m[1] * y) + m[2];
+                pt.y = (m[3] * x) + (m[4] * y) + m[5];
+            });
+}
+
+void TransformBuffer2D::clear()
+{
+    buffer_.clear();
+}
+
+double TransformBuffer2D::oldestStamp() const
+{
+    return ( buffer_.empty() ) ? 0.0 : buffer_.front().stamp;
+}
+
+double TransformBuffer2D::newestStamp() const
+{
+    return ( buffer_.empty() ) ? 0.0 : buffer_.back().stamp;
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cmath>
+
+#include <geometry_common/TransformBuffer3D.h>
+
+#include "TransformBufferUtils.h"
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+void TransformBuffer3D::addTransform(double stamp, const TransformMatrix3D& tf_mat)
+{
+    const std::array<float, 4> q = tf_mat.quaternion();
+    addTransform(stamp, tf_mat.x(), tf_mat.y(), tf_mat.z(), q[0], q[1], q[2], q[3]);
+}
+
+void TransformBuffer3D::addTransform(double stamp, float x, float y, float z,
+                                     float qx, float qy, float qz, float qw)
+{
+    float norm = std::sqrt((qx * qx) + (qy * qy) + (qz * qz) + (qw * qw));
+    if ( norm < 1e-6f )
+    {
+        qx = qy = qz = 0.0f;
+        qw = norm = 1.0f;
+    }
+    StampedTransform stamped_tf{stamp, {{x, y, z}},
+                                {{qx/norm, qy/norm, qz/norm, qw/norm}}};
+    transform_buffer::insert(buffer_, stamped_tf, max_duration_);
+}
+
+bool TransformBuffer3D::calcTransform(double stamp, TransformMatrix3D& tf_mat) const
+{
+    const StampedTransform* before;
+    const StampedTransform* after;
+    float t;
+    if ( !transform_buffer::findInterval(buffer_, stamp, before, after, t) )
+    {
+        return false;
+    }
+    if ( before == after )
+    {
+        tf_mat.update(before->translation[0], before->translation[1],
+                      before->translation[2], before->quaternion[0],
+                      before->quaternion[1], before->quaternion[2],
+                      before->quaternion[3]);
+        return true;
+    }
+
+    std::array<float, 3> translation;
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        translation[i] = before->translation[i] +
+                         (t * (after->translation[i] - before->translation[i]));
+    }
+
+    /**
+     * source: https://en.wikipedia.org/wiki/Slerp
+     */
+    std::array<float, 4> q_after = after->quaternion;
+    float dot = 0.0f;
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        dot += before->quaternion[i] * q_after[i];
+    }
+    if ( dot < 0.0f ) // take the shorter path
+    {
+        dot = -dot;
+        for ( size_t i = 0; i < 4; i++ )
+        {
+            q_after[i] = -q_after[i];
+        }
+    }
+
+    float w_before, w_after;
+    if ( dot > 0.9995f ) // nearly identical rotations; fall back to lerp
+    {
+        w_before = 1.0f - t;
+        w_after = t;
+    }
+    else
+    {
+        const float theta = std::acos(dot);
+        const float inv_sin_theta = 1.0f / std::sin(theta);
+        w_before = std::sin((1.0f - t) * theta) * inv_sin_theta;
+        w_after = std::sin(t * theta) * inv_sin_theta;
+    }
+
+    std::array<float, 4> q;
+    float norm_sq = 0.0f;
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        q[i] = (w_before * before->quaternion[i]) + (w_after * q_after[i]);
+        norm_sq += q[i] * q[i];
+    }
+    const float inv_norm = 1.0f / std::sqrt(norm_sq);
+    tf_mat.update(translation[0], translation[1], translation[2],
+                  q[0] * inv_norm, q[1] * inv_norm, q[2] * inv_norm,
+                  q[3] * inv_norm);
+    return true;
+}
+
+bool TransformBuffer3D::deskew(
+        PointCloud3D& cloud,
+        const std::vector<float>& point_time_offsets,
+        double scan_stamp,
+        double target_stamp,
+        size_t num_of_bins) const
+{
+    return transform_buffer::deskew<TransformMatrix3D, 12>(
+            *this, cloud, point_time_offsets, scan_stamp, target_stamp,
+            num_of_bins,
+            [](const float* m, Point3D& pt)
+            {
+                const float x = pt.x;
+                const float y = pt.y;
+                const float z = pt.z;
+                pt.x = (m[0] * x) + (m[1] * y) + (m[2] * z) + m[3];
+                pt.y = (m[4] * x) + (m[5] * y) + (m[6] * z) + m[7];
+                pt.z = (m[8] * x) + (m[9] * y) + (m[10] * z) + m[11];
+            });
+}
+
+void TransformBuffer3D::clear()
+{
+    buffer_.clear();
+}
+
+double TransformBuffer3D::oldestStamp() const
+{
+    return ( buffer_.empty() ) ? 0.0 : buffer_.front().stamp;
+}
+
+double TransformBuffer3D::newestStamp() const
+{
+    return ( buffer_.empty() ) ? 0.0 : buffer_.back().stamp;
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -0,0 +1,220 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#ifndef KELO_GEOMETRY_COMMON_TRANSFORM_BUFFER_UTILS_H
+#define KELO_GEOMETRY_COMMON_TRANSFORM_BUFFER_UTILS_H
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <vector>
+
+namespace kelo
+{
+namespace geometry_common
+{
+namespace transform_buffer
+{
+
+/**
+ * Private helpers shared by TransformBuffer2D and TransformBuffer3D. Entries
+ * of a buffer are sorted by their `stamp` member.
+ */
+
+/* allows float time offsets that got rounded just outside of the buffer */
+const double STAMP_TOLERANCE = 1e-6;
+
+/**
+ * @brief Insert entry in stamp order, replacing an entry with the same stamp,
+ * and discard entries older than max_duration w.r.t. the newest one
+ */
+template <typename StampedEntry>
+void insert(std::deque<StampedEntry>& buffer, const StampedEntry& entry,
+            double max_duration)
+{
+    if ( buffer.empty() || entry.stamp > buffer.back().stamp )
+    {
+        buffer.push_back(entry);
+    }
+    else
+    {
+        typename std::deque<StampedEntry>::iterator it = std::lower_bound(
+                buffer.begin(), buffer.end(), entry.stamp,
+                [](const StampedEntry& e, double s) { return e.stamp < s; });
+        if ( it != buffer.end() && it->stamp == entry.stamp )
+        {
+            *it = entry;
+        }
+        else
+        {
+            buffer.insert(it, entry);
+        }
+    }
+
+    const double oldest_allowed_stamp = buffer.back().stamp - max_duration;
+    while ( buffer.front().stamp < oldest_allowed_stamp )
+    {
+        buffer.pop_front();
+    }
+}
+
+/**
+ * @brief Find the entries enclosing stamp. If stamp is equal to the newest
+ * stamp, before and after both point to the newest entry.
+ *
+ * @return bool false if stamp lies outside of the buffered interval
+ */
+template <typename StampedEntry>
+bool findInterval(const std::deque<StampedEntry>& buffer, double stamp,
+                  const StampedEntry*& before, const StampedEntry*& after,
+                  float& t)
+{
+    if ( buffer.empty() ||
+         stamp < buffer.front().stamp || stamp > buffer.back().stamp )
+    {
+        return false;
+    }
+
+    typename std::deque<StampedEntry>::const_iterator upper = std::upper_bound(
+            buffer.begin(), buffer.end(), stamp,
+            [](double s, const StampedEntry& e) { return s < e.stamp; });
+    if ( upper == buffer.end() ) // stamp is equal to newest stamp
+    {
+        before = after = &buffer.back();
+        t = 0.0f;
+        return true;
+    }
+    before = &(*(upper - 1));
+    after = &(*upper);
+    t = static_cast<float>((stamp - before->stamp) / (after->stamp - before->stamp));
+    return true;
+}
+
+/**
+ * @brief Motion compensate cloud with one transformation per time bin (see
+ * TransformBuffer2D::deskew)
+ *
+ * @tparam MAT_SIZE number of matrix elements copied per bin
+ * @param transform_point functor applying the flattened matrix of a bin to a
+ * point
+ */
+template <typename TransformMatrix, size_t MAT_SIZE, typename TransformBuffer,
+          typename PointCloud, typename TransformPoint>
+bool deskew(
+        const TransformBuffer& buffer,
+        PointCloud& cloud,
+        const std::vector<float>& point_time_offsets,
+        double scan_stamp,
+        double target_stamp,
+        size_t num_of_bins,
+        TransformPoint transform_point)
+{
+    if ( cloud.size() != point_time_offsets.size() )
+    {
+        return false;
+    }
+    if ( cloud.empty() )
+    {
+        return true;
+    }
+
+    /* a NaN would pass the range checks below and reach the bin index cast */
+    float min_offset = point_time_offsets.front();
+    float max_offset = point_time_offsets.front();
+    for ( const float offset : point_time_offsets )
+    {
+        if ( !std::isfinite(offset) )
+        {
+            return false;
+        }
+        min_offset = std::min(min_offset, offset);
+        max_offset = std::max(max_offset, offset);
+    }
+
+    TransformMatrix target_tf_mat;
+    if ( !buffer.calcTransform(target_stamp, target_tf_mat) ||
+         scan_stamp + min_offset < buffer.oldestStamp() - STAMP_TOLERANCE ||
+         scan_stamp + max_offset > buffer.newestStamp() + STAMP_TOLERANCE )
+    {
+        return false;
+    }
+    target_tf_mat.invert();
+
+    if ( num_of_bins == 0 || max_offset <= min_offset )
+    {
+        num_of_bins = 1;
+    }
+    const float bin_width = ( num_of_bins == 1 )
+                            ? 1.0f
+                            : (max_offset - min_offset) / num_of_bins;
+
+    /* precompute one matrix per bin, flattened for the per point loop */
+    std::vector<float> bin_mats(num_of_bins * MAT_SIZE);
+    TransformMatrix tf_mat;
+    for ( size_t i = 0; i < num_of_bins; i++ )
+    {
+        const double bin_stamp = ( num_of_bins == 1 )
+                                 ? scan_stamp + (0.5 * (min_offset + max_offset))
+                                 : scan_stamp + min_offset + ((i + 0.5) * bin_width);
+        buffer.calcTransform(std::min(std::max(bin_stamp, buffer.oldestStamp()),
+                                      buffer.newestStamp()),
+                             tf_mat);
+        tf_mat = target_tf_mat * tf_mat;
+        for ( size_t j = 0; j < MAT_SIZE; j++ )
+        {
+            bin_mats[(i*MAT_SIZE) + j] = tf_mat[j];
+        }
+    }
+
+    const float inv_bin_width = 1.0f / bin_width;
+    for ( size_t i = 0; i < cloud.size(); i++ )
+    {
+        size_t bin = static_cast<size_t>(
+                (point_time_offsets[i] - min_offset) * inv_bin_width);
+        bin = std::min(bin, num_of_bins - 1);
+        transform_point(&bin_mats[bin * MAT_SIZE], cloud[i]);
+    }
+    return true;
+}
+
+} // namespace transform_buffer
+} // namespace geometry_common
+} // namespace kelo
+#endif // KELO_GEOMETRY_COMMON_TRANSFORM_BUFFER_UTILS_H
@@ -0,0 +1,178 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <geometry_common/Utils.h>
+#include <geometry_common/TransformChain2D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+namespace
+{
+
+bool areIdentical(const TransformMatrix2D& a, const TransformMatrix2D& b)
+{
+    for ( size_t i = 0; i < 6; i++ )
+    {
+        if ( a[i] != b[i] )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+size_t TransformChain2D::append(const TransformMatrix2D& tf_mat)
+{
+    links_.push_back(tf_mat);
+    is_composed_valid_ = false;
+    return links_.size() - 1;
+}
+
+void TransformChain2D::updateLink(size_t index, const TransformMatrix2D& tf_mat)
+{
+    if ( !areIdentical(links_[index], tf_mat) )
+    {
+        links_[index] = tf_mat;
+        is_composed_valid_ = false;
+    }
+}
+
+void TransformChain2D::clear()
+{
+    links_.clear();
+    is_composed_valid_ = false;
+}
+
+const TransformMatrix2D& TransformChain2D::composed() const
+{
+    if ( !is_composed_valid_ )
+    {
+        composed_ = TransformMatrix2D();
+        for ( const TransformMatrix2D& tf_mat : links_ )
+        {
+            composed_ *= tf_mat;
+        }
+        composed_theta_ = composed_.theta();
+        is_composed_valid_ = true;
+    }
+    return composed_;
+}
+
+void TransformChain2D::transform(Point2D& point) const
+{
+    transformPoints(&point, &point, 1);
+}
+
+void TransformChain2D::transform(Pose2D& pose) const
+{
+    composed();
+    Point2D position(pose.x, pose.y);
+    transformPoints(&position, &position, 1);
+    pose.x = position.x;
+    pose.y = position.y;
+    pose.theta = Utils::clipAngle(pose.theta + composed_theta_);
+}
+
+void TransformChain2D::transform(LineSegment2D& line_segment) const
+{
+    transformPoints(&line_segment.start, &line_segment.start, 1);
+    transformPoints(&line_segment.end, &line_segment.end, 1);
+}
+
+void TransformChain2D::transform(Polyline2D& polyline) const
+{
+    transformPoints(polyline.vertices.data(), polyline.vertices.data(),
+                    polyline.vertices.size());
+}
+
+void TransformChain2D::transform(PointCloud2D& cloud) const
+{
+    transformPoints(cloud.data(), cloud.data(), cloud.size());
+}
+
+void TransformChain2D::transform(Path& pose_path) const
+{
+    /* rotation is applied as a precomputed angle offset instead of
+     * composing a matrix per pose */
+    const TransformMatrix2D& tf_mat = composed();
+    const float m0 = tf_mat[0], m1 = tf_mat[1], m2 = tf_mat[2];
+    const float m3 = tf_mat[3], m4 = tf_mat[4], m5 = tf_mat[5];
+    for ( Pose2D& pose : pose_path )
+    {
+        const float x = pose.x;
+        const float y = pose.y;
+        pose.x = (m0 * x) + (m1 * y) + m2;
+        pose.y = (m3 * x) + (m4 * y) + m5;
+        pose.theta = Utils::clipAngle(pose.theta + composed_theta_);
+    }
+}
+
+void TransformChain2D::transform(
+        const PointCloud2D& cloud,
+        PointCloud2D& transformed_cloud) const
+{
+    transformed_cloud.resize(cloud.size());
+    transformPoints(cloud.data(), transformed_cloud.data(), cloud.size());
+}
+
+void TransformChain2D::transformPoints(
+        const Point2D* input,
+        Point2D* output,
+        size_t size) const
+{
+    const TransformMatrix2D& tf_mat = composed();
+    const float m0 = tf_mat[0], m1 = tf_mat[1], m2 = tf_mat[2];
+    const float m3 = tf_mat[3], m4 = tf_mat[4], m5 = tf_mat[5];
+    for ( size_t i = 0; i < size; i++ )
+    {
+        const float x = input[i].x;
+        const float y = input[i].y;
+        output[i].x = (m0 * x) + (m1 * y) + m2;
+        output[i].y = (m3 * x) + (m4 * y) + m5;
+    }
+}
+
+} // namespace geometry_common
+} // namespace kelo
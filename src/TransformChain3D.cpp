@@ -0,0 +1,140 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <geometry_common/TransformChain3D.h>
+
+namespace kelo
+{
+namespace geometry_common
+{
+
+namespace
+{
+
+bool areIdentical(const TransformMatrix3D& a, const TransformMatrix3D& b)
+{
+    for ( size_t i = 0; i < 12; i++ )
+    {
+        if ( a[i] != b[i] )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+size_t TransformChain3D::append(const TransformMatrix3D& tf_mat)
+{
+    links_.push_back(tf_mat);
+    is_composed_valid_ = false;
+    return links_.size() - 1;
+}
+
+void TransformChain3D::updateLink(size_t index, const TransformMatrix3D& tf_mat)
+{
+    if ( !areIdentical(links_[index], tf_mat) )
+    {
+        links_[index] = tf_mat;
+        is_composed_valid_ = false;
+    }
+}
+
+void TransformChain3D::clear()
+{
+    links_.clear();
+    is_composed_valid_ = false;
+}
+
+const TransformMatrix3D& TransformChain3D::composed() const
+{
+    if ( !is_composed_valid_ )
+    {
+        composed_ = TransformMatrix3D();
+        for ( const TransformMatrix3D& tf_mat : links_ )
+        {
+            composed_ *= tf_mat;
+        }
+        is_composed_valid_ = true;
+    }
+    return composed_;
+}
+
+void TransformChain3D::transform(Point3D& point) const
+{
+    transformPoints(&point, &point, 1);
+}
+
+void TransformChain3D::transform(PointCloud3D& cloud) const
+{
+    transformPoints(cloud.data(), cloud.data(), cloud.size());
+}
+
+void TransformChain3D::transform(
+        const PointCloud3D& cloud,
+        PointCloud3D& transformed_cloud) const
+{
+    transformed_cloud.resize(cloud.size());
+    transformPoints(cloud.data(), transformed_cloud.data(), cloud.size());
+}
+
+void TransformChain3D::transformPoints(
+        const Point3D* input,
+        Point3D* output,
+        size_t size) const
+{
+    const TransformMatrix3D& tf_mat = composed();
+    const float m0 = tf_mat[0], m1 = tf_mat[1], m2 = tf_mat[2], m3 = tf_mat[3];
+    const float m4 = tf_mat[4], m5 = tf_mat[5], m6 = tf_mat[6], m7 = tf_mat[7];
+    const float m8 = tf_mat[8], m9 = tf_mat[9], m10 = tf_mat[10], m11 = tf_mat[11];
+    for ( size_t i = 0; i < size; i++ )
+    {
+        const float x = input[i].x;
+        const float y = input[i].y;
+        const float z = input[i].z;
+        output[i].x = (m0 * x) + (m1 * y) + (m2 * z) + m3;
+        output[i].y = (m4 * x) + (m5 * y) + (m6 * z) + m7;
+        output[i].z = (m8 * x) + (m9 * y) + (m10 * z) + m11;
+    }
+}
+
+} // namespace geometry_common
+} // namespace kelo
@@ -41,6 +41,7 @@
 #include <cmath>
 
 #include <geometry_common/Utils.h>
+#include <geometry_common/ThreadPool.h>
 #include <geometry_common/Pose2D.h>
 #include <geometry_common/Point2D.h>
 #include <geometry_common/Circle.h>
@@ -84,6 +85,41 @@ TransformMatrix2D::TransformMatrix2D(const TransformMatrix2D& tf_mat)
     update(tf_mat);
 }
 
+TransformMatrix2D TransformMatrix2D::initFromCosSin(
+        float x, float y, float cos_theta, float sin_theta)
+{
+    TransformMatrix2D tf_mat;
+    tf_mat.updateX(x);
+    tf_mat.updateY(y);
+    tf_mat.updateRotation(cos_theta, sin_theta);
+    return tf_mat;
+}
+
+void TransformMatrix2D::calcTransformMatrices(
+        const Path& poses,
+        std::vector<TransformMatrix2D>& tf_mats)
+{
+    std::vector<float> thetas(poses.size());
+    for ( size_t i = 0; i < poses.size(); i++ )
+    {
+        thetas[i] = poses[i].theta;
+    }
+    std::vector<float> sin_values, cos_values;
+    Utils::calcSinCos(thetas, sin_values, cos_values);
+
+    tf_mats.resize(poses.size());
+    for ( size_t i = 0; i < poses.size(); i++ )
+    {
+        std::array<float, 6>& mat = tf_mats[i].mat_;
+        mat[0] = cos_values[i];
+        mat[1] = -sin_values[i];
+        mat[2] = poses[i].x;
+        mat[3] = sin_values[i];
+        mat[4] = cos_values[i];
+        mat[5] = poses[i].y;
+    }
+}
+
 void TransformMatrix2D::update(float x, float y, float theta)
 {
     updateX(x);
@@ -138,10 +174,15 @@ void TransformMatrix2D::updateY(float y)
 
 void TransformMatrix2D::updateTheta(float theta)
 {
-    mat_[0] = std::cos(theta);
-    mat_[1] = -std::sin(theta);
-    mat_[3] = std::sin(theta);
-    mat_[4] = std::cos(theta);
+    updateRotation(std::cos(theta), std::sin(theta));
+}
+
+void TransformMatrix2D::updateRotation(float cos_theta, float sin_theta)
+{
+    mat_[0] = cos_theta;
+    mat_[1] = -sin_theta;
+    mat_[3] = sin_theta;
+    mat_[4] = cos_theta;
 }
 
 void TransformMatrix2D::updateQuaternion(float qx, float qy, float qz, float qw)
@@ -277,6 +318,30 @@ void TransformMatrix2D::transform(Path& pose_path) const
     }
 }
 
+void TransformMatrix2D::transform(PointCloud2D& cloud, const ExecutionPolicy& policy) const
+{
+    policy.parallelFor(0, cloud.size(),
+            [this, &cloud](size_t begin, size_t end)
+            {
+                for ( size_t i = begin; i < end; i++ )
+                {
+                    transform(cloud[i]);
+                }
+            });
+}
+
+void TransformMatrix2D::transform(Path& pose_path, const ExecutionPolicy& policy) const
+{
+    policy.parallelFor(0, pose_path.size(),
+            [this, &pose_path](size_t begin, size_t end)
+            {
+                for ( size_t i = begin; i < end; i++ )
+                {
+                    transform(pose_path[i]);
+                }
+            });
+}
+
 TransformMatrix2D& TransformMatrix2D::operator = (const TransformMatrix2D& other)
 {
     mat_ = other.mat_;
@@ -41,6 +41,7 @@
 #include <cmath>
 
 #include <geometry_common/Utils.h>
+#include <geometry_common/ThreadPool.h>
 #include <geometry_common/Point3D.h>
 #include <geometry_common/TransformMatrix3D.h>
 
@@ -276,6 +277,18 @@ void TransformMatrix3D::transform(PointCloud3D& cloud) const
     }
 }
 
+void TransformMatrix3D::transform(PointCloud3D& cloud, const ExecutionPolicy& policy) const
+{
+    policy.parallelFor(0, cloud.size(),
+            [this, &cloud](size_t begin, size_t end)
+            {
+                for ( size_t i = begin; i < end; i++ )
+                {
+                    transform(cloud[i]);
+                }
+            });
+}
+
 TransformMatrix3D& TransformMatrix3D::operator = (const TransformMatrix3D& other)
 {
     mat_ = other.mat_;
@@ -42,12 +42,24 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <cstdint>
 #include <cassert>
 #include <list>
 #include <deque>
+#include <set>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <queue>
+#include <functional>
 #include <sensor_msgs/point_cloud2_iterator.h>
+#include <geometry_common/BVH2D.h>
+#include <geometry_common/LineSegmentMerger.h>
 #include <geometry_common/TransformMatrix2D.h>
 #include <geometry_common/Utils.h>
+#include <geometry_common/MonotonicArena.h>
+#include <geometry_common/Instrumentation.h>
 
 namespace kelo
 {
@@ -151,52 +163,107 @@ std::vector<PointCloud2D> Utils::clusterPoints(
         float cluster_distance_threshold,
         size_t min_cluster_size)
 {
-    std::vector<PointCloud2D> clusters;
+    GEOMETRY_COMMON_PROFILE_SCOPE("Utils::clusterPoints", points.size());
+
+    const std::vector<std::vector<size_t>> index_clusters = Utils::clusterPointIndices(
+            PointArrayView2D<Point2D>(points), cluster_distance_threshold,
+            min_cluster_size);
 
-    /* populate remaining_points */
-    std::list<Point2D> remaining_points;
-    for ( const Point2D& p : points )
+    std::vector<PointCloud2D> clusters(index_clusters.size());
+    for ( size_t i = 0; i < index_clusters.size(); i++ )
     {
-        remaining_points.push_back(Point2D(p));
+        clusters[i].reserve(index_clusters[i].size());
+        for ( size_t index : index_clusters[i] )
+        {
+            clusters[i].push_back(points[index]);
+        }
+    }
+    return clusters;
+}
+
+template <typename T>
+std::vector<std::vector<size_t>> Utils::clusterPointIndices(
+        const PointArrayView2D<T>& points,
+        float cluster_distance_threshold,
+        size_t min_cluster_size)
+{
+    GEOMETRY_COMMON_PROFILE_SCOPE("Utils::clusterPointIndices", points.size());
+
+    std::vector<std::vector<size_t>> clusters;
+
+    /* populate remaining_indices (scratch memory from the active arena, if any) */
+    ArenaVector<size_t> remaining_indices(points.size());
+    for ( size_t i = 0; i < points.size(); i++ )
+    {
+        remaining_indices[i] = i;
     }
 
     float threshold_dist_sq = std::pow(cluster_distance_threshold, 2);
 
-    /* cluster remaining_points iteratively */
-    while ( !remaining_points.empty() )
+    /* cluster remaining points iteratively */
+    size_t remaining_start = 0;
+    ArenaVector<size_t> cluster;
+    while ( remaining_start < remaining_indices.size() )
     {
-        std::vector<Point2D> cluster;
-        std::list<Point2D> fringe;
-        fringe.push_back(remaining_points.front());
-        remaining_points.pop_front();
+        // the cluster itself acts as the fringe; points before fringe_index
+        // have already been expanded
+        cluster.clear();
+        cluster.push_back(remaining_indices[remaining_start]);
+        remaining_start++;
 
-        while ( !fringe.empty() )
+        for ( size_t fringe_index = 0; fringe_index < cluster.size(); fringe_index++ )
         {
-            // get first point from fringe
-            Point2D point = fringe.front();
-            fringe.pop_front();
-            cluster.push_back(point);
+            const float x = points.x(cluster[fringe_index]);
+            const float y = points.y(cluster[fringe_index]);
 
-            // iterate over remaining points
-            auto pt = remaining_points.begin();
-            while ( pt != remaining_points.end() )
+            // move close points to cluster and compact the rest in order
+            size_t write_index = remaining_start;
+            for ( size_t i = remaining_start; i < remaining_indices.size(); i++ )
             {
-                if ( point.squaredDistTo(*pt) < threshold_dist_sq )
+                const size_t index = remaining_indices[i];
+                const float dx = x - points.x(index);
+                const float dy = y - points.y(index);
+                if ( (dx * dx) + (dy * dy) < threshold_dist_sq )
                 {
-                    fringe.push_back(*pt);
-                    pt = remaining_points.erase(pt);
+                    cluster.push_back(index);
                     continue;
                 }
-                ++pt;
+                remaining_indices[write_index] = index;
+                write_index++;
             }
+            remaining_indices.resize(write_index);
         }
         if ( cluster.size() > min_cluster_size )
         {
-            clusters.push_back(cluster);
+            clusters.push_back(std::vector<size_t>(cluster.begin(), cluster.end()));
         }
     }
     return clusters;
 }
+template std::vector<std::vector<size_t>> Utils::clusterPointIndices(
+        const PointArrayView2D<Point2D>& points,
+        float cluster_distance_threshold, size_t min_cluster_size);
+template std::vector<std::vector<size_t>> Utils::clusterPointIndices(
+        const PointArrayView2D<Point3D>& points,
+        float cluster_distance_threshold, size_t min_cluster_size);
+template std::vector<std::vector<size_t>> Utils::clusterPointIndices(
+        const PointArrayView2D<Pose2D>& points,
+        float cluster_distance_threshold, size_t min_cluster_size);
+template std::vector<std::vector<size_t>> Utils::clusterPointIndices(
+        const PointArrayView2D<PackedPoint2D>& points,
+        float cluster_distance_threshold, size_t min_cluster_size);
+template std::vector<std::vector<size_t>> Utils::clusterPointIndices(
+        const PointArrayView2D<geometry_msgs::Point>& points,
+        float cluster_distance_threshold, size_t min_cluster_size);
+template std::vector<std::vector<size_t>> Utils::clusterPointIndices(
+        const PointArrayView2D<geometry_msgs::Point32>& points,
+        float cluster_distance_threshold, size_t min_cluster_size);
+template std::vector<std::vector<size_t>> Utils::clusterPointIndices(
+        const PointArrayView2D<geometry_msgs::Pose>& points,
+        float cluster_distance_threshold, size_t min_cluster_size);
+template std::vector<std::vector<size_t>> Utils::clusterPointIndices(
+        const PointArrayView2D<geometry_msgs::PoseStamped>& points,
+        float cluster_distance_threshold, size_t min_cluster_size);
 
 std::vector<PointCloud2D> Utils::clusterOrderedPoints(
         const PointCloud2D& points,
@@ -205,8 +272,8 @@ std::vector<PointCloud2D> Utils::clusterOrderedPoints(
 {
     std::vector<PointCloud2D> clusters;
 
-    /* populate remaining_points */
-    std::list<Point2D> remaining_points;
+    /* populate remaining_points (list nodes from the active arena, if any) */
+    std::list<Point2D, ArenaAllocator<Point2D>> remaining_points;
     for ( Point2D p : points )
     {
         remaining_points.push_back(Point2D(p));
@@ -281,24 +348,97 @@ std::vector<Pose2D> Utils::calcTrajectory(
         size_t num_of_poses,
         float future_time)
 {
-    std::vector<Pose2D> traj;
-    traj.reserve(num_of_poses+1);
+    std::vector<float> xs, ys, thetas;
+    Utils::calcTrajectories(std::vector<Velocity2D>(1, vel), num_of_poses,
+                            future_time, xs, ys, thetas);
 
-    float delta_t = future_time/num_of_poses;
-
-    // d = v * t
-    TransformMatrix2D vel_tf_mat(vel * delta_t);
-    TransformMatrix2D pos_mat; // identity mat
+    std::vector<Pose2D> traj;
+    traj.reserve(xs.size());
+    for ( size_t i = 0; i < xs.size(); i++ )
+    {
+        traj.push_back(Pose2D(xs[i], ys[i], thetas[i]));
+    }
+    return traj;
+}
 
-    /* add current pose (for extra safety) */
-    traj.push_back(Pose2D());
+void Utils::calcTrajectories(
+        const std::vector<Velocity2D>& vels,
+        size_t num_of_poses,
+        float future_time,
+        std::vector<float>& xs,
+        std::vector<float>& ys,
+        std::vector<float>& thetas)
+{
+    /**
+     * Each step translates by d = (vel.x, vel.y) * delta_t in the current
+     * frame and then rotates by phi = vel.theta * delta_t. Treating positions
+     * as complex numbers, the k-th pose therefore is
+     *     position_k = d * sum_{j=0}^{k-1} e^{i*j*phi}
+     *                = d * e^{i*(k-1)*phi/2} * sin(k*phi/2) / sin(phi/2)
+     *     theta_k = k * phi
+     * so all poses only need sine and cosine of multiples of phi/2, which
+     * are computed for the whole batch at once.
+     */
+    const size_t stride = num_of_poses + 1;
+    const size_t size = vels.size() * stride;
+    xs.resize(size);
+    ys.resize(size);
+    thetas.resize(size);
+    if ( size == 0 )
+    {
+        return;
+    }
 
-    for ( size_t i = 0; i < num_of_poses; i++ )
+    const float delta_t = ( num_of_poses > 0 ) ? future_time/num_of_poses : 0.0f;
+    std::vector<float> half_angles(size);
+    for ( size_t i = 0; i < vels.size(); i++ )
     {
-        pos_mat *= vel_tf_mat;
-        traj.push_back(pos_mat.asPose2D());
+        const float half_phi = 0.5f * vels[i].theta * delta_t;
+        float* half_angle = &half_angles[i * stride];
+        for ( size_t k = 0; k < stride; k++ )
+        {
+            half_angle[k] = k * half_phi;
+        }
+    }
+    std::vector<float> sin_values, cos_values;
+    Utils::calcSinCos(half_angles, sin_values, cos_values);
+
+    for ( size_t i = 0; i < vels.size(); i++ )
+    {
+        const size_t offset = i * stride;
+        const float* sin_half = &sin_values[offset];
+        const float* cos_half = &cos_values[offset];
+        const float* half_angle = &half_angles[offset];
+        float* x = &xs[offset];
+        float* y = &ys[offset];
+        float* theta = &thetas[offset];
+        const float dx = vels[i].x * delta_t;
+        const float dy = vels[i].y * delta_t;
+
+        x[0] = 0.0f;
+        y[0] = 0.0f;
+        theta[0] = 0.0f;
+        if ( num_of_poses == 0 )
+        {
+            continue;
+        }
+
+        /* sin(k*phi/2) / sin(phi/2) tends to k for a straight trajectory */
+        const bool is_straight = ( std::fabs(sin_half[1]) < 1e-20f );
+        const float inv_sin_half_phi = ( is_straight ) ? 0.0f : 1.0f / sin_half[1];
+        const float straight_weight = ( is_straight ) ? 1.0f : 0.0f;
+        for ( size_t k = 1; k < stride; k++ )
+        {
+            const float scale = (sin_half[k] * inv_sin_half_phi) +
+                                (straight_weight * k);
+            x[k] = scale * ((dx * cos_half[k-1]) - (dy * sin_half[k-1]));
+            y[k] = scale * ((dx * sin_half[k-1]) + (dy * cos_half[k-1]));
+        }
+        for ( size_t k = 1; k < stride; k++ )
+        {
+            theta[k] = Utils::clipAngle(2.0f * half_angle[k]);
+        }
     }
-    return traj;
 }
 
 float Utils::calcShortestAngle(
@@ -402,6 +542,9 @@ float Utils::fitLineRANSAC(
         float delta,
         size_t itr_limit)
 {
+    GEOMETRY_COMMON_PROFILE_SCOPE("Utils::fitLineRANSAC",
+            ( end_index > start_index ) ? end_index - start_index + 1 : 0);
+
     if ( end_index <= start_index )
     {
         m = 0.0f;
@@ -517,6 +660,8 @@ std::vector<LineSegment2D> Utils::fitLineSegmentsRANSAC(
         float delta,
         size_t itr_limit)
 {
+    GEOMETRY_COMMON_PROFILE_SCOPE("Utils::fitLineSegmentsRANSAC", pts.size());
+
     struct RegressionLineSegment
     {
         unsigned start_index, end_index;
@@ -530,7 +675,7 @@ std::vector<LineSegment2D> Utils::fitLineSegmentsRANSAC(
     }
 
     /* fill in the initial segments */
-    std::vector<RegressionLineSegment> segments(1);
+    ArenaVector<RegressionLineSegment> segments(1);
     segments[0].start_index = 0;
     segments[0].end_index = pts.size()-1;
 
@@ -544,7 +689,7 @@ std::vector<LineSegment2D> Utils::fitLineSegmentsRANSAC(
         return line_segments;
     }
 
-    std::vector<float> scores;
+    ArenaVector<float> scores;
     scores.push_back(score);
 
     while ( true )
@@ -626,6 +771,9 @@ float Utils::fitCircleRANSAC(
         float delta,
         size_t itr_limit)
 {
+    GEOMETRY_COMMON_PROFILE_SCOPE("Utils::fitCircleRANSAC",
+            ( end_index > start_index ) ? end_index - start_index + 1 : 0);
+
     if ( end_index <= start_index+1 )
     {
         circle.x = 0.0f;
@@ -802,7 +950,7 @@ std::vector<LineSegment2D> Utils::applyPiecewiseRegression(
     }
 
     /* fill in the initial segments */
-    std::vector<RegressionLineSegment> segments(pts.size() / 2);
+    ArenaVector<RegressionLineSegment> segments(pts.size() / 2);
     for ( size_t i = 0; i < segments.size(); i++ )
     {
         segments[i].start_index = 2*i;
@@ -815,7 +963,7 @@ std::vector<LineSegment2D> Utils::applyPiecewiseRegression(
     }
 
     /* errors when 2 consecutive segments are merged */
-    std::vector<float> errors(segments.size()-1);
+    ArenaVector<float> errors(segments.size()-1);
     LineSegment2D line_segment; // not used;
     for ( size_t i = 0; i < errors.size(); i++ )
     {
@@ -892,7 +1040,7 @@ std::vector<LineSegment2D> Utils::applyPiecewiseRegressionSplit(
     }
 
     /* fill in the initial segments */
-    std::vector<RegressionLineSegment> segments(1);
+    ArenaVector<RegressionLineSegment> segments(1);
     segments[0].start_index = 0;
     segments[0].end_index = pts.size()-1;
 
@@ -905,7 +1053,7 @@ std::vector<LineSegment2D> Utils::applyPiecewiseRegressionSplit(
         return line_segments;
     }
 
-    std::vector<float> errors;
+    ArenaVector<float> errors;
     errors.push_back(error);
 
     while ( true )
@@ -987,22 +1135,23 @@ void Utils::mergeCloseLines(
         return;
     }
 
-    size_t i = 0;
-
-    while ( i < line_segments.size()-1 )
+    /* compact in place instead of erasing merged segments one by one */
+    size_t last = 0;
+    for ( size_t i = 1; i < line_segments.size(); i++ )
     {
-        float linear_dist = line_segments[i].end.distTo(line_segments[i+1].start);
-        float angular_dist = Utils::calcShortestAngle(line_segments[i].angle(),
-                                                      line_segments[i+1].angle());
+        float linear_dist = line_segments[last].end.distTo(line_segments[i].start);
+        float angular_dist = Utils::calcShortestAngle(line_segments[last].angle(),
+                                                      line_segments[i].angle());
         if ( linear_dist < distance_threshold &&
              std::fabs(angular_dist) < angle_threshold )
         {
-            line_segments[i].end = line_segments[i+1].end;
-            line_segments.erase(line_segments.begin() + i + 1);
+            line_segments[last].end = line_segments[i].end;
             continue;
         }
-        i++;
+        last++;
+        line_segments[last] = line_segments[i];
     }
+    line_segments.resize(last + 1);
 }
 
 void Utils::mergeCloseLinesBF(
@@ -1010,43 +1159,8 @@ void Utils::mergeCloseLinesBF(
         float distance_threshold,
         float angle_threshold)
 {
-    if (line_segments.size() < 2)
-    {
-        return;
-    }
-
-    size_t skip_index = 1;
-
-    while ( skip_index < line_segments.size() )
-    {
-        size_t i = 0;
-        while ( i+skip_index < line_segments.size() )
-        {
-            const float angular_dist = Utils::calcShortestAngle(
-                    line_segments[i].angle(), line_segments[i+skip_index].angle());
-            if ( std::fabs(angular_dist) < angle_threshold )
-            {
-                const float linear_dist_1 = line_segments[i].end.distTo(
-                        line_segments[i+skip_index].start);
-                if ( linear_dist_1 < distance_threshold )
-                {
-                    line_segments[i].end = line_segments[i+skip_index].end;
-                    line_segments.erase(line_segments.begin() + i + skip_index);
-                    continue;
-                }
-                const float linear_dist_2 = line_segments[i+skip_index].end.distTo(
-                        line_segments[i].start);
-                if ( linear_dist_2 < distance_threshold )
-                {
-                    line_segments[i].start = line_segments[i+skip_index].start;
-                    line_segments.erase(line_segments.begin() + i + skip_index);
-                    continue;
-                }
-            }
-            i++;
-        }
-        skip_index ++;
-    }
+    LineSegmentMerger merger(distance_threshold, angle_threshold);
+    merger.mergeCloseLines(line_segments);
 }
 
 void Utils::mergeCoLinearLines(
@@ -1055,58 +1169,8 @@ void Utils::mergeCoLinearLines(
         float angle_threshold,
         float perp_dist_threshold)
 {
-    if (line_segments.size() < 2)
-    {
-        return;
-    }
-
-    while ( true )
-    {
-        bool merged_lines = false;
-        for ( size_t i = 0; i < line_segments.size(); i++ )
-        {
-            for ( size_t j = 0; j < line_segments.size(); j++ )
-            {
-                if ( i == j )
-                {
-                    continue;
-                }
-
-                const float linear_dist = line_segments[i].end.distTo(
-                        line_segments[j].start);
-                const float angular_dist = Utils::calcShortestAngle(
-                        line_segments[i].angle(), line_segments[j].angle());
-                const Point2D start_proj_pt = Utils::calcProjectedPointOnLine(
-                        line_segments[i].start, line_segments[i].end,
-                        line_segments[j].start, false);
-                const float start_perp_dist = start_proj_pt.distTo(
-                        line_segments[j].start);
-                const Point2D end_proj_pt = Utils::calcProjectedPointOnLine(
-                        line_segments[i].start, line_segments[i].end,
-                        line_segments[j].end, false);
-                const float end_perp_dist = end_proj_pt.distTo(
-                        line_segments[j].end);
-                if ( linear_dist < distance_threshold &&
-                     std::fabs(angular_dist) < angle_threshold &&
-                     start_perp_dist < perp_dist_threshold &&
-                     end_perp_dist < perp_dist_threshold )
-                {
-                    line_segments[i].end = line_segments[j].end;
-                    line_segments.erase(line_segments.begin() + j);
-                    merged_lines = true;
-                    break;
-                }
-            }
-            if ( merged_lines )
-            {
-                break;
-            }
-        }
-        if ( !merged_lines )
-        {
-            break;
-        }
-    }
+    LineSegmentMerger merger(distance_threshold, angle_threshold, perp_dist_threshold);
+    merger.mergeCoLinearLines(line_segments);
 }
 
 std::vector<LineSegment2D> Utils::fitLineSegments(
@@ -1115,6 +1179,8 @@ std::vector<LineSegment2D> Utils::fitLineSegments(
         float distance_threshold,
         float angle_threshold)
 {
+    GEOMETRY_COMMON_PROFILE_SCOPE("Utils::fitLineSegments", pts.size());
+
     std::vector<LineSegment2D> lines = Utils::applyPiecewiseRegression(
             pts, regression_error_threshold);
     Utils::mergeCloseLines(lines, distance_threshold, angle_threshold);
@@ -1155,6 +1221,65 @@ float Utils::clipAngle(
     return angle;
 }
 
+void Utils::calcSinCos(
+        const std::vector<float>& angles,
+        std::vector<float>& sin_values,
+        std::vector<float>& cos_values)
+{
+    /**
+     * source: Cephes Mathematical Library (sinf.c, cosf.c)
+     * Angle is reduced to r in [-pi/4, pi/4] w.r.t. the nearest multiple q of
+     * pi/2 using an extended precision (Cody-Waite) pi/2.
+     */
+    const float two_by_pi = 0.636619772367581343f;
+    const float pi_by_two_1 = 1.5703125f;
+    const float pi_by_two_2 = 4.837512969970703125e-4f;
+    const float pi_by_two_3 = 7.54978995489188216e-8f;
+    const float round_magic = 12582912.0f;
+    const float max_angle = 8192.0f;
+
+    const size_t size = angles.size();
+    sin_values.resize(size);
+    cos_values.resize(size);
+    const float* a = angles.data();
+    float* s = sin_values.data();
+    float* c = cos_values.data();
+    for ( size_t i = 0; i < size; i++ )
+    {
+        // round to the nearest multiple of pi/2 by adding 1.5 * 2^23, which
+        // leaves the integer in the low mantissa bits; this avoids compares
+        // and float to int conversions which would prevent vectorisation
+        const float biased = (a[i] * two_by_pi) + round_magic;
+        uint32_t quadrant;
+        std::memcpy(&quadrant, &biased, sizeof(quadrant));
+        const float q = biased - round_magic;
+        const float r = ((a[i] - (q * pi_by_two_1)) - (q * pi_by_two_2)) -
+                        (q * pi_by_two_3);
+        const float r2 = r * r;
+        const float sin_r = r + (r * r2 * (-1.6666654611e-1f + (r2 *
+                            (8.3321608736e-3f + (r2 * -1.9515295891e-4f)))));
+        const float cos_r = 1.0f - (0.5f * r2) + (r2 * r2 *
+                            (4.166664568298827e-2f + (r2 *
+                            (-1.388731625493765e-3f + (r2 * 2.443315711809948e-5f)))));
+        // select and negate per quadrant arithmetically to keep the loop free
+        // of branches
+        const float swap = static_cast<float>(quadrant & 1);
+        const float sin_sign = 1.0f - static_cast<float>(quadrant & 2);
+        const float cos_sign = 1.0f - static_cast<float>((quadrant + 1) & 2);
+        s[i] = sin_sign * (sin_r + (swap * (cos_r - sin_r)));
+        c[i] = cos_sign * (cos_r + (swap * (sin_r - cos_r)));
+    }
+
+    for ( size_t i = 0; i < size; i++ )
+    {
+        if ( !(std::fabs(a[i]) < max_angle) )
+        {
+            s[i] = std::sin(a[i]);
+            c[i] = std::cos(a[i]);
+        }
+    }
+}
+
 XYTheta Utils::clip(
         const XYTheta& value,
         const XYTheta& max_limit,
@@ -1206,18 +1331,44 @@ PointVec2D Utils::calcSplineCurvePoints(
         return curve_points;
     }
 
-    size_t order = control_points.size() - 1;
-    std::vector<unsigned int> coef = Utils::calcPascalTriangleRowCoefficients(order);
-    float offset = 1.0f / (num_of_points-1);
+    /**
+     * weights are computed per point without building (and caching) a
+     * basis matrix, which would not pay off for a single curve. Binomial
+     * coefficients are kept in double so that they do not overflow.
+     */
+    const size_t order = control_points.size() - 1;
+    std::vector<double> coefficients(order + 1);
+    coefficients[0] = 1.0;
+    for ( size_t i = 1; i <= order; i++ )
+    {
+        coefficients[i] = (coefficients[i-1] * (order + 1 - i)) / i;
+    }
+
+    std::vector<double> pow_t(order + 1);
+    std::vector<double> pow_one_minus_t(order + 1);
+    const double offset = 1.0 / (num_of_points - 1);
     curve_points.reserve(num_of_points);
-    curve_points.push_back(control_points[0]); // add start point as first curve point
-    // add n-2 curve points in middle
-    for ( size_t factor = 1; factor+1 < num_of_points; factor++ )
+    curve_points.push_back(control_points.front());
+    for ( size_t j = 1; j+1 < num_of_points; j++ )
     {
-        float t = offset * factor;
-        curve_points.push_back(Utils::calcSplineCurvePoint(control_points, coef, t));
+        const double t = offset * j;
+        pow_t[0] = pow_one_minus_t[0] = 1.0;
+        for ( size_t i = 1; i <= order; i++ )
+        {
+            pow_t[i] = pow_t[i-1] * t;
+            pow_one_minus_t[i] = pow_one_minus_t[i-1] * (1.0 - t);
+        }
+        double x = 0.0;
+        double y = 0.0;
+        for ( size_t i = 0; i <= order; i++ )
+        {
+            const double weight = coefficients[i] * pow_t[i] * pow_one_minus_t[order - i];
+            x += weight * control_points[i].x;
+            y += weight * control_points[i].y;
+        }
+        curve_points.push_back(Point2D(static_cast<float>(x), static_cast<float>(y)));
     }
-    curve_points.push_back(control_points.back()); // add end point as last curve point
+    curve_points.push_back(control_points.back());
     return curve_points;
 }
 
@@ -1248,14 +1399,11 @@ Point2D Utils::calcSplineCurvePoint(
     size_t order = control_points.size() - 1;
     for ( size_t i = 0; i < order+1; i++ )
     {
-        curve_point.x += static_cast<float>(coefficients[i])
-                       * pow(1.0f-t, order-i)
-                       * pow(t, i)
-                       * control_points[i].x;
-        curve_point.y += static_cast<float>(coefficients[i])
-                       * pow(1.0f-t, order-i)
-                       * pow(t, i)
-                       * control_points[i].y;
+        const float weight = static_cast<float>(coefficients[i])
+                           * std::pow(1.0f-t, order-i)
+                           * std::pow(t, i);
+        curve_point.x += weight * control_points[i].x;
+        curve_point.y += weight * control_points[i].y;
     }
     return curve_point;
 }
@@ -1280,6 +1428,115 @@ template sensor_msgs::PointCloud Utils::convertToROSPointCloud(
 template sensor_msgs::PointCloud Utils::convertToROSPointCloud(
         const PointCloud3D& pc, const std::string& frame);
 
+namespace
+{
+
+/**
+ * @brief Check the byte order of the host, e.g. for the is_bigendian flag of
+ * sensor_msgs::PointCloud2
+ */
+inline bool isHostBigEndian()
+{
+    const uint16_t endianness_test = 1;
+    uint8_t first_byte;
+    std::memcpy(&first_byte, &endianness_test, 1);
+    return ( first_byte == 0 );
+}
+
+inline void packXYZ(const Point2D& pt, uint8_t* dest)
+{
+    const float xyz[3] = {pt.x, pt.y, 0.0f};
+    std::memcpy(dest, xyz, sizeof(xyz));
+}
+
+inline void packXYZ(const Point3D& pt, uint8_t* dest)
+{
+    const float xyz[3] = {pt.x, pt.y, pt.z};
+    std::memcpy(dest, xyz, sizeof(xyz));
+}
+
+inline bool isNaN(const Point2D& pt)
+{
+    return ( std::isnan(pt.x) || std::isnan(pt.y) );
+}
+
+inline bool isNaN(const Point3D& pt)
+{
+    return ( std::isnan(pt.x) || std::isnan(pt.y) || std::isnan(pt.z) );
+}
+
+} // namespace
+
+template <typename T>
+bool Utils::convertToROSPointCloud2(
+        const std::vector<T>& pc,
+        sensor_msgs::PointCloud2& cloud_msg,
+        const std::string& frame,
+        const std::vector<std::string>& channel_names,
+        const std::vector<std::vector<float>>& channels)
+{
+    if ( channels.size() != channel_names.size() )
+    {
+        return false;
+    }
+    for ( const std::vector<float>& channel : channels )
+    {
+        if ( channel.size() != pc.size() )
+        {
+            return false;
+        }
+    }
+
+    const size_t num_of_fields = 3 + channels.size();
+    const size_t point_step = num_of_fields * sizeof(float);
+    static const std::string xyz_names[3] = {"x", "y", "z"};
+
+    // cloud_msg.header.stamp = ros::Time::now();
+    cloud_msg.header.frame_id = frame;
+    cloud_msg.height = 1;
+    cloud_msg.width = pc.size();
+    cloud_msg.fields.resize(num_of_fields);
+    for ( size_t i = 0; i < num_of_fields; i++ )
+    {
+        sensor_msgs::PointField& field = cloud_msg.fields[i];
+        field.name = ( i < 3 ) ? xyz_names[i] : channel_names[i-3];
+        field.offset = i * sizeof(float);
+        field.datatype = sensor_msgs::PointField::FLOAT32;
+        field.count = 1;
+    }
+    cloud_msg.is_bigendian = isHostBigEndian();
+    cloud_msg.point_step = point_step;
+    cloud_msg.row_step = point_step * pc.size();
+    cloud_msg.data.resize(cloud_msg.row_step);
+
+    bool is_dense = true;
+    uint8_t* dest = cloud_msg.data.data();
+    for ( size_t i = 0; i < pc.size(); i++, dest += point_step )
+    {
+        packXYZ(pc[i], dest);
+        is_dense = is_dense && !isNaN(pc[i]);
+    }
+    for ( size_t j = 0; j < channels.size(); j++ )
+    {
+        dest = cloud_msg.data.data() + ((3 + j) * sizeof(float));
+        const float* values = channels[j].data();
+        for ( size_t i = 0; i < pc.size(); i++, dest += point_step )
+        {
+            std::memcpy(dest, &values[i], sizeof(float));
+        }
+    }
+    cloud_msg.is_dense = is_dense;
+    return true;
+}
+template bool Utils::convertToROSPointCloud2(
+        const PointCloud2D& pc, sensor_msgs::PointCloud2& cloud_msg,
+        const std::string& frame, const std::vector<std::string>& channel_names,
+        const std::vector<std::vector<float>>& channels);
+template bool Utils::convertToROSPointCloud2(
+        const PointCloud3D& pc, sensor_msgs::PointCloud2& cloud_msg,
+        const std::string& frame, const std::vector<std::string>& channel_names,
+        const std::vector<std::vector<float>>& channels);
+
 PointCloud3D Utils::convertToPointCloud3D(
         const sensor_msgs::PointCloud& pc)
 {
@@ -1292,25 +1549,116 @@ PointCloud3D Utils::convertToPointCloud3D(
     return points;
 }
 
-PointCloud3D Utils::convertToPointCloud3D(
+namespace
+{
+
+/**
+ * @brief Find the byte offsets of x, y and z fields if all of them are single
+ * float32 values (in host byte order) that lie within a point
+ */
+bool findFloat32XYZOffsets(
+        const sensor_msgs::PointCloud2& cloud_msg,
+        uint32_t offsets[3])
+{
+    const std::string names[3] = {"x", "y", "z"};
+    bool is_found[3] = {false, false, false};
+    for ( const sensor_msgs::PointField& field : cloud_msg.fields )
+    {
+        for ( size_t i = 0; i < 3; i++ )
+        {
+            if ( field.name == names[i] )
+            {
+                if ( field.datatype != sensor_msgs::PointField::FLOAT32 ||
+                     field.count > 1 ||
+                     field.offset + sizeof(float) > cloud_msg.point_step )
+                {
+                    return false;
+                }
+                offsets[i] = field.offset;
+                is_found[i] = true;
+            }
+        }
+    }
+    return ( is_found[0] && is_found[1] && is_found[2] &&
+             cloud_msg.is_bigendian == isHostBigEndian() &&
+             cloud_msg.row_step >= cloud_msg.width * cloud_msg.point_step &&
+             cloud_msg.data.size() >= (static_cast<size_t>(cloud_msg.height - 1) *
+                                       cloud_msg.row_step) +
+                                      (cloud_msg.width * cloud_msg.point_step) );
+}
+
+void convertPointCloud2ToPointCloud3D(
         const sensor_msgs::PointCloud2& cloud_msg,
         size_t row_sub_sample_factor,
-        size_t col_sub_sample_factor)
+        size_t col_sub_sample_factor,
+        PointCloud3D& points,
+        std::vector<size_t>* indices)
 {
+    points.clear();
+    if ( indices != nullptr )
+    {
+        indices->clear();
+    }
     if ( cloud_msg.height == 0 || cloud_msg.width == 0 )
     {
-        return std::vector<Point3D>();
+        return;
     }
-    PointCloud3D points;
+    row_sub_sample_factor = std::max(row_sub_sample_factor, static_cast<size_t>(1));
+    col_sub_sample_factor = std::max(col_sub_sample_factor, static_cast<size_t>(1));
     if ( cloud_msg.height == 1 ) // unorganised cloud
     {
         row_sub_sample_factor = 1;
     }
+
+    uint32_t offsets[3];
+    if ( findFloat32XYZOffsets(cloud_msg, offsets) )
+    {
+        /* fast path: read the coordinates directly at fixed byte offsets.
+         * Points are written unconditionally and the output position is only
+         * advanced for valid points, so the loop does not branch on NaNs. */
+        const size_t num_of_rows = ((cloud_msg.height - 1) / row_sub_sample_factor) + 1;
+        const size_t num_of_cols = ((cloud_msg.width - 1) / col_sub_sample_factor) + 1;
+        points.resize(num_of_rows * num_of_cols);
+        if ( indices != nullptr )
+        {
+            indices->resize(points.size());
+        }
+        const size_t col_step = col_sub_sample_factor * cloud_msg.point_step;
+        size_t num_of_points = 0;
+        for ( size_t row = 0; row < cloud_msg.height; row += row_sub_sample_factor )
+        {
+            const uint8_t* point_data = cloud_msg.data.data() + (row * cloud_msg.row_step);
+            for ( size_t col = 0; col < cloud_msg.width;
+                  col += col_sub_sample_factor, point_data += col_step )
+            {
+                Point3D& point = points[num_of_points];
+                std::memcpy(&point.x, point_data + offsets[0], sizeof(float));
+                std::memcpy(&point.y, point_data + offsets[1], sizeof(float));
+                std::memcpy(&point.z, point_data + offsets[2], sizeof(float));
+                if ( indices != nullptr )
+                {
+                    (*indices)[num_of_points] = (row * cloud_msg.width) + col;
+                }
+                num_of_points += !(std::isnan(point.x) || std::isnan(point.y) ||
+                                   std::isnan(point.z));
+            }
+        }
+        points.resize(num_of_points);
+        if ( indices != nullptr )
+        {
+            indices->resize(num_of_points);
+        }
+        return;
+    }
+
     points.reserve((cloud_msg.height / row_sub_sample_factor) *
                    (cloud_msg.width / col_sub_sample_factor));
     size_t col = 0, row = 0;
-    size_t col_remainder = cloud_msg.width % col_sub_sample_factor;
-    size_t row_skip_factor = (cloud_msg.width * (row_sub_sample_factor-1)) + col_remainder;
+    // distance from the last visited column of a row to the first column of
+    // the next visited row
+    size_t last_col = ((cloud_msg.width - 1) / col_sub_sample_factor) * col_sub_sample_factor;
+    size_t row_skip_factor = (cloud_msg.width * (row_sub_sample_factor-1)) +
+                             (cloud_msg.width - last_col);
     sensor_msgs::PointCloud2ConstIterator<float> iter_x(cloud_msg, "x");
     sensor_msgs::PointCloud2ConstIterator<float> iter_y(cloud_msg, "y");
     sensor_msgs::PointCloud2ConstIterator<float> iter_z(cloud_msg, "z");
@@ -1319,6 +1667,10 @@ PointCloud3D Utils::convertToPointCloud3D(
         if ( !std::isnan(*iter_x) && !std::isnan(*iter_y) && !std::isnan(*iter_z) )
         {
             points.push_back(Point3D(*iter_x, *iter_y, *iter_z));
+            if ( indices != nullptr )
+            {
+                indices->push_back((row * cloud_msg.width) + col);
+            }
         }
 
         col += col_sub_sample_factor;
@@ -1335,14 +1687,38 @@ PointCloud3D Utils::convertToPointCloud3D(
         iter_y += col_sub_sample_factor;
         iter_z += col_sub_sample_factor;
     }
+}
+
+} // namespace
+
+PointCloud3D Utils::convertToPointCloud3D(
+        const sensor_msgs::PointCloud2& cloud_msg,
+        size_t row_sub_sample_factor,
+        size_t col_sub_sample_factor)
+{
+    PointCloud3D points;
+    convertPointCloud2ToPointCloud3D(cloud_msg, row_sub_sample_factor,
+                                     col_sub_sample_factor, points, nullptr);
     return points;
 }
 
+void Utils::convertToPointCloud3D(
+        const sensor_msgs::PointCloud2& cloud_msg,
+        PointCloud3D& points,
+        std::vector<size_t>& indices,
+        size_t row_sub_sample_factor,
+        size_t col_sub_sample_factor)
+{
+    convertPointCloud2ToPointCloud3D(cloud_msg, row_sub_sample_factor,
+                                     col_sub_sample_factor, points, &indices);
+}
+
 template <typename T>
 std::vector<T> Utils::convertToPointCloud(
         const sensor_msgs::LaserScan& scan)
 {
     std::vector<T> laser_pts;
+    laser_pts.reserve(scan.ranges.size());
     for ( size_t i = 0; i < scan.ranges.size(); i++ )
     {
         if ( std::isnan(scan.ranges[i]) ||
@@ -1395,6 +1771,95 @@ bool Utils::isAngleWithinBounds(
            : ( angle <= min_angle && angle >= max_angle );
 }
 
+template <typename T>
+bool Utils::isPointInPolygon(
+        const PointArrayView2D<T>& vertices,
+        const Point2D& point)
+{
+    /* 
+     * Source: https://stackoverflow.com/a/2922778/10460994
+     */
+    size_t i, j, counter = 0;
+    for ( i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++ )
+    {
+        const float curr_x = vertices.x(i), curr_y = vertices.y(i);
+        const float prev_x = vertices.x(j), prev_y = vertices.y(j);
+        if ( ((curr_y > point.y) != (prev_y > point.y)) &&
+             (point.x < (prev_x - curr_x) * (point.y - curr_y) / (prev_y - curr_y) + curr_x) )
+        {
+            counter++;
+        }
+    }
+    return ( counter % 2 == 1 );
+}
+template bool Utils::isPointInPolygon(
+        const PointArrayView2D<Point2D>& vertices, const Point2D& point);
+template bool Utils::isPointInPolygon(
+        const PointArrayView2D<Point3D>& vertices, const Point2D& point);
+template bool Utils::isPointInPolygon(
+        const PointArrayView2D<Pose2D>& vertices, const Point2D& point);
+template bool Utils::isPointInPolygon(
+        const PointArrayView2D<PackedPoint2D>& vertices, const Point2D& point);
+template bool Utils::isPointInPolygon(
+        const PointArrayView2D<geometry_msgs::Point>& vertices, const Point2D& point);
+template bool Utils::isPointInPolygon(
+        const PointArrayView2D<geometry_msgs::Point32>& vertices, const Point2D& point);
+template bool Utils::isPointInPolygon(
+        const PointArrayView2D<geometry_msgs::Pose>& vertices, const Point2D& point);
+template bool Utils::isPointInPolygon(
+        const PointArrayView2D<geometry_msgs::PoseStamped>& vertices, const Point2D& point);
+
+template <typename T>
+void Utils::calcIndicesInPolygon(
+        const PointArrayView2D<T>& vertices,
+        const PointCloud2D& points,
+        std::vector<size_t>& indices,
+        const ExecutionPolicy& policy)
+{
+    std::vector<uint8_t> is_inside(points.size());
+    policy.parallelFor(0, points.size(),
+            [&vertices, &points, &is_inside](size_t begin, size_t end)
+            {
+                for ( size_t i = begin; i < end; i++ )
+                {
+                    is_inside[i] = Utils::isPointInPolygon(vertices, points[i]);
+                }
+            });
+
+    indices.clear();
+    for ( size_t i = 0; i < is_inside.size(); i++ )
+    {
+        if ( is_inside[i] )
+        {
+            indices.push_back(i);
+        }
+    }
+}
+template void Utils::calcIndicesInPolygon(
+        const PointArrayView2D<Point2D>& vertices, const PointCloud2D& points,
+        std::vector<size_t>& indices, const ExecutionPolicy& policy);
+template void Utils::calcIndicesInPolygon(
+        const PointArrayView2D<Point3D>& vertices, const PointCloud2D& points,
+        std::vector<size_t>& indices, const ExecutionPolicy& policy);
+template void Utils::calcIndicesInPolygon(
+        const PointArrayView2D<Pose2D>& vertices, const PointCloud2D& points,
+        std::vector<size_t>& indices, const ExecutionPolicy& policy);
+template void Utils::calcIndicesInPolygon(
+        const PointArrayView2D<PackedPoint2D>& vertices, const PointCloud2D& points,
+        std::vector<size_t>& indices, const ExecutionPolicy& policy);
+template void Utils::calcIndicesInPolygon(
+        const PointArrayView2D<geometry_msgs::Point>& vertices, const PointCloud2D& points,
+        std::vector<size_t>& indices, const ExecutionPolicy& policy);
+template void Utils::calcIndicesInPolygon(
+        const PointArrayView2D<geometry_msgs::Point32>& vertices, const PointCloud2D& points,
+        std::vector<size_t>& indices, const ExecutionPolicy& policy);
+template void Utils::calcIndicesInPolygon(
+        const PointArrayView2D<geometry_msgs::Pose>& vertices, const PointCloud2D& points,
+        std::vector<size_t>& indices, const ExecutionPolicy& policy);
+template void Utils::calcIndicesInPolygon(
+        const PointArrayView2D<geometry_msgs::PoseStamped>& vertices, const PointCloud2D& points,
+        std::vector<size_t>& indices, const ExecutionPolicy& policy);
+
 PointVec2D Utils::generatePerpendicularPointsAt(
         const Pose2D& pose,
         float max_perp_dist,
@@ -1438,31 +1903,605 @@ WindingOrder Utils::calcWindingOrder(
 
 }
 
-void Utils::convertQuaternionToEuler(
-        float qx,
-        float qy,
-        float qz,
-        float qw,
-        float& roll,
-        float& pitch,
-        float& yaw)
+namespace
 {
-    /**
-     * source: https://www.euclideanspace.com/maths/geometry/rotations/conversions/quaternionToEuler/
-     */
-    float sinpitch = 2 * (qw * qy - qz * qx);
-    if ( sinpitch >= 1.0f ) // singularity at north pole
+
+/**
+ * @brief Number of segments of a chain of vertices
+ */
+inline size_t calcNumOfSegments(const PointVec2D& vertices, bool is_closed)
+{
+    if ( is_closed )
     {
-        roll = 0.0f;
-        pitch = M_PI/2;
-        yaw = 2 * std::atan2(qx, qw);
+        return vertices.size();
     }
-    else if ( sinpitch <= -1.0f ) // singularity at south pole
+    return ( vertices.size() > 1 ) ? vertices.size() - 1 : 0;
+}
+
+inline LineSegment2D calcSegment(const PointVec2D& vertices, size_t index)
+{
+    return LineSegment2D(vertices[index], vertices[(index + 1) % vertices.size()]);
+}
+
+bool doPolylinesIntersectBF(
+        const PointVec2D& vertices_a,
+        const PointVec2D& vertices_b,
+        bool is_a_closed,
+        bool is_b_closed)
+{
+    const size_t num_of_segments_a = calcNumOfSegments(vertices_a, is_a_closed);
+    const size_t num_of_segments_b = calcNumOfSegments(vertices_b, is_b_closed);
+    for ( size_t i = 0; i < num_of_segments_b; i++ )
     {
-        roll = 0.0f;
-        pitch = -M_PI/2;
-        yaw = -2 * std::atan2(qx, qw);
-    }
+        const LineSegment2D segment_b = calcSegment(vertices_b, i);
+        for ( size_t j = 0; j < num_of_segments_a; j++ )
+        {
+            if ( calcSegment(vertices_a, j).intersects(segment_b) )
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool hasNonZeroLengthSegment(const PointVec2D& vertices)
+{
+    for ( size_t i = 1; i < vertices.size(); i++ )
+    {
+        if ( vertices[i].x != vertices[0].x || vertices[i].y != vertices[0].y )
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Segment used by the sweep line with its endpoints ordered
+ * lexicographically (left/bottom endpoint first)
+ */
+struct SweepSegment
+{
+    Point2D left, right;
+    size_t chain;
+    size_t index;
+};
+
+inline bool isLexicographicallySmaller(const Point2D& a, const Point2D& b)
+{
+    return ( a.x < b.x || (a.x == b.x && a.y < b.y) );
+}
+
+inline double calcOrientation(const Point2D& a, const Point2D& b, const Point2D& c)
+{
+    return (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y)
+         - (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - a.x);
+}
+
+/**
+ * @brief Order of segments along the sweep line (from bottom to top). The
+ * position of the segment which entered later is compared against the line
+ * of the other segment, which is valid as long as no two segments in the
+ * sweep line cross each other.
+ */
+struct SweepSegmentComparator
+{
+    const std::vector<SweepSegment>* segments;
+
+    bool operator () (size_t id_a, size_t id_b) const
+    {
+        if ( id_a == id_b )
+        {
+            return false;
+        }
+        const SweepSegment& a = (*segments)[id_a];
+        const SweepSegment& b = (*segments)[id_b];
+        if ( !isLexicographicallySmaller(b.left, a.left) )
+        {
+            double orientation = calcOrientation(a.left, a.right, b.left);
+            if ( orientation == 0 )
+            {
+                orientation = calcOrientation(a.left, a.right, b.right);
+            }
+            if ( orientation != 0 )
+            {
+                return ( orientation > 0 );
+            }
+        }
+        else
+        {
+            double orientation = calcOrientation(b.left, b.right, a.left);
+            if ( orientation == 0 )
+            {
+                orientation = calcOrientation(b.left, b.right, a.right);
+            }
+            if ( orientation != 0 )
+            {
+                return ( orientation < 0 );
+            }
+        }
+        return ( id_a < id_b );
+    }
+};
+
+enum class SweepIntersection
+{
+    NONE,
+    SAME_CHAIN,
+    DIFFERENT_CHAINS
+};
+
+/**
+ * @brief Run a Shamos-Hoey sweep over the segments of both chains until the
+ * first intersection is found.
+ */
+SweepIntersection findFirstIntersection(
+        const PointVec2D& vertices_a,
+        const PointVec2D& vertices_b,
+        bool is_a_closed,
+        bool is_b_closed)
+{
+    const PointVec2D* chains[2] = {&vertices_a, &vertices_b};
+    const bool is_closed[2] = {is_a_closed, is_b_closed};
+    size_t num_of_segments[2];
+
+    std::vector<SweepSegment> segments;
+    segments.reserve(calcNumOfSegments(vertices_a, is_a_closed) +
+                     calcNumOfSegments(vertices_b, is_b_closed));
+    for ( size_t chain = 0; chain < 2; chain++ )
+    {
+        const PointVec2D& vertices = *chains[chain];
+        num_of_segments[chain] = calcNumOfSegments(vertices, is_closed[chain]);
+        for ( size_t i = 0; i < num_of_segments[chain]; i++ )
+        {
+            const Point2D& start = vertices[i];
+            const Point2D& end = vertices[(i + 1) % vertices.size()];
+            if ( start.x == end.x && start.y == end.y )
+            {
+                continue; // zero length segments are covered by their neighbours
+            }
+            SweepSegment segment;
+            segment.left = ( isLexicographicallySmaller(start, end) ) ? start : end;
+            segment.right = ( isLexicographicallySmaller(start, end) ) ? end : start;
+            segment.chain = chain;
+            segment.index = i;
+            segments.push_back(segment);
+        }
+    }
+
+    // events are sorted by x, then left endpoints before right endpoints and
+    // finally by y
+    std::vector<std::pair<size_t, bool>> events; // (segment id, is left)
+    events.reserve(2 * segments.size());
+    for ( size_t i = 0; i < segments.size(); i++ )
+    {
+        events.push_back(std::make_pair(i, true));
+        events.push_back(std::make_pair(i, false));
+    }
+    std::sort(events.begin(), events.end(),
+              [&segments](const std::pair<size_t, bool>& e1,
+                          const std::pair<size_t, bool>& e2)
+              {
+                  const Point2D& p1 = ( e1.second ) ? segments[e1.first].left
+                                                    : segments[e1.first].right;
+                  const Point2D& p2 = ( e2.second ) ? segments[e2.first].left
+                                                    : segments[e2.first].right;
+                  if ( p1.x != p2.x )
+                  {
+                      return ( p1.x < p2.x );
+                  }
+                  if ( e1.second != e2.second )
+                  {
+                      return e1.second;
+                  }
+                  if ( p1.y != p2.y )
+                  {
+                      return ( p1.y < p2.y );
+                  }
+                  return ( e1.first < e2.first );
+              });
+
+    auto checkPair = [&](size_t id_a, size_t id_b)
+    {
+        const SweepSegment& a = segments[id_a];
+        const SweepSegment& b = segments[id_b];
+        if ( a.chain == b.chain )
+        {
+            const size_t n = num_of_segments[a.chain];
+            const size_t diff = ( a.index > b.index ) ? a.index - b.index
+                                                      : b.index - a.index;
+            const bool are_adjacent = ( diff == 1 ||
+                                        (is_closed[a.chain] && n > 2 && diff == n - 1) );
+            if ( are_adjacent )
+            {
+                // adjacent segments share a vertex; they only overlap further
+                // if they are collinear and point in opposite directions
+                const Point2D vec_a = a.right - a.left;
+                const Point2D vec_b = b.right - b.left;
+                const bool is_overlapping = (
+                        calcOrientation(Point2D(), vec_a, vec_b) == 0 &&
+                        ( (a.left.x == b.left.x && a.left.y == b.left.y) ||
+                          (a.right.x == b.right.x && a.right.y == b.right.y) ) );
+                return ( is_overlapping ) ? SweepIntersection::SAME_CHAIN
+                                          : SweepIntersection::NONE;
+            }
+        }
+
+        if ( !LineSegment2D(a.left, a.right).intersects(LineSegment2D(b.left, b.right)) )
+        {
+            return SweepIntersection::NONE;
+        }
+        return ( a.chain == b.chain ) ? SweepIntersection::SAME_CHAIN
+                                      : SweepIntersection::DIFFERENT_CHAINS;
+    };
+
+    SweepSegmentComparator comparator;
+    comparator.segments = &segments;
+    std::set<size_t, SweepSegmentComparator> sweep_line(comparator);
+    std::vector<std::set<size_t, SweepSegmentComparator>::iterator> positions(
+            segments.size(), sweep_line.end());
+
+    for ( const std::pair<size_t, bool>& event : events )
+    {
+        const size_t id = event.first;
+        SweepIntersection intersection = SweepIntersection::NONE;
+        if ( event.second )
+        {
+            auto it = sweep_line.insert(id).first;
+            positions[id] = it;
+            auto next = std::next(it);
+            if ( next != sweep_line.end() )
+            {
+                intersection = checkPair(id, *next);
+            }
+            if ( intersection == SweepIntersection::NONE && it != sweep_line.begin() )
+            {
+                intersection = checkPair(*std::prev(it), id);
+            }
+        }
+        else
+        {
+            auto it = positions[id];
+            auto next = std::next(it);
+            if ( it != sweep_line.begin() && next != sweep_line.end() )
+            {
+                intersection = checkPair(*std::prev(it), *next);
+            }
+            sweep_line.erase(it);
+        }
+
+        if ( intersection != SweepIntersection::NONE )
+        {
+            return intersection;
+        }
+    }
+    return SweepIntersection::NONE;
+}
+
+} // namespace
+
+bool Utils::doPolylinesIntersect(
+        const PointVec2D& vertices_a,
+        const PointVec2D& vertices_b,
+        bool is_a_closed,
+        bool is_b_closed)
+{
+    // sweep line has a larger constant factor; use it only when the number
+    // of pairwise tests becomes significant
+    const size_t num_of_segments_a = calcNumOfSegments(vertices_a, is_a_closed);
+    const size_t num_of_segments_b = calcNumOfSegments(vertices_b, is_b_closed);
+    if ( num_of_segments_a * num_of_segments_b <= 256 ||
+         !hasNonZeroLengthSegment(vertices_a) ||
+         !hasNonZeroLengthSegment(vertices_b) )
+    {
+        return doPolylinesIntersectBF(vertices_a, vertices_b, is_a_closed, is_b_closed);
+    }
+
+    switch ( findFirstIntersection(vertices_a, vertices_b, is_a_closed, is_b_closed) )
+    {
+        case SweepIntersection::DIFFERENT_CHAINS:
+            return true;
+        case SweepIntersection::SAME_CHAIN:
+            // the order along the sweep line is not valid beyond a self
+            // intersection of one of the chains
+            return doPolylinesIntersectBF(vertices_a, vertices_b, is_a_closed, is_b_closed);
+        case SweepIntersection::NONE:
+        default:
+            return false;
+    }
+}
+
+void Utils::calcPolylineIntersections(
+        const PointVec2D& vertices_a,
+        const PointVec2D& vertices_b,
+        std::vector<std::pair<size_t, size_t>>& segment_ids,
+        PointVec2D& intersection_pts,
+        bool is_a_closed,
+        bool is_b_closed)
+{
+    segment_ids.clear();
+    intersection_pts.clear();
+
+    const size_t num_of_segments_a = calcNumOfSegments(vertices_a, is_a_closed);
+    const size_t num_of_segments_b = calcNumOfSegments(vertices_b, is_b_closed);
+    const bool is_a_indexed = ( num_of_segments_a >= num_of_segments_b );
+    const PointVec2D& indexed_vertices = ( is_a_indexed ) ? vertices_a : vertices_b;
+    const PointVec2D& query_vertices = ( is_a_indexed ) ? vertices_b : vertices_a;
+    const size_t num_of_indexed_segments = ( is_a_indexed ) ? num_of_segments_a
+                                                            : num_of_segments_b;
+    const size_t num_of_query_segments = ( is_a_indexed ) ? num_of_segments_b
+                                                          : num_of_segments_a;
+
+    std::vector<LineSegment2D> indexed_segments;
+    indexed_segments.reserve(num_of_indexed_segments);
+    for ( size_t i = 0; i < num_of_indexed_segments; i++ )
+    {
+        indexed_segments.push_back(calcSegment(indexed_vertices, i));
+    }
+    const BVH2D<LineSegment2D> bvh(indexed_segments);
+
+    std::vector<std::pair<std::pair<size_t, size_t>, Point2D>> intersections;
+    std::vector<size_t> candidates;
+    for ( size_t i = 0; i < num_of_query_segments; i++ )
+    {
+        const LineSegment2D query_segment = calcSegment(query_vertices, i);
+        bvh.calcIndicesOverlapping(Box2D({query_segment.start, query_segment.end}),
+                                   candidates);
+        for ( size_t j : candidates )
+        {
+            Point2D intersection_pt;
+            if ( indexed_segments[j].calcIntersectionPointWith(query_segment,
+                                                               intersection_pt) )
+            {
+                intersections.push_back(std::make_pair(
+                            ( is_a_indexed ) ? std::make_pair(j, i) : std::make_pair(i, j),
+                            intersection_pt));
+            }
+        }
+    }
+
+    std::sort(intersections.begin(), intersections.end(),
+              [](const std::pair<std::pair<size_t, size_t>, Point2D>& a,
+                 const std::pair<std::pair<size_t, size_t>, Point2D>& b)
+              {
+                  return ( a.first < b.first );
+              });
+    segment_ids.reserve(intersections.size());
+    intersection_pts.reserve(intersections.size());
+    for ( const auto& intersection : intersections )
+    {
+        segment_ids.push_back(intersection.first);
+        intersection_pts.push_back(intersection.second);
+    }
+}
+
+namespace
+{
+
+template <typename T>
+float calcSquaredDistToSegment(const T& start, const T& end, const T& point)
+{
+    const float dx = end.x - start.x;
+    const float dy = end.y - start.y;
+    const float px = point.x - start.x;
+    const float py = point.y - start.y;
+    const float squared_length = (dx * dx) + (dy * dy);
+    float t = ( squared_length > 0.0f )
+              ? ((px * dx) + (py * dy)) / squared_length
+              : 0.0f;
+    t = std::min(std::max(t, 0.0f), 1.0f);
+    const float diff_x = px - (t * dx);
+    const float diff_y = py - (t * dy);
+    return (diff_x * diff_x) + (diff_y * diff_y);
+}
+
+template <typename T>
+float calcTriangleArea(const T& a, const T& b, const T& c)
+{
+    return 0.5f * std::fabs(((b.x - a.x) * (c.y - a.y)) -
+                            ((c.x - a.x) * (b.y - a.y)));
+}
+
+} // namespace
+
+template <typename T>
+std::vector<T> Utils::simplifyDouglasPeucker(
+        const std::vector<T>& points,
+        float tolerance,
+        bool is_closed)
+{
+    const size_t n = points.size();
+    if ( n < 3 || (is_closed && n < 4) )
+    {
+        return points;
+    }
+
+    /* a closed chain is split into two open chains between the first vertex
+     * and the vertex farthest from it; index n refers to the first vertex */
+    std::vector<char> is_kept(n + 1, false);
+    std::vector<std::pair<size_t, size_t>> stack;
+    is_kept[0] = true;
+    if ( is_closed )
+    {
+        size_t farthest = 1;
+        float max_squared_dist = 0.0f;
+        for ( size_t i = 1; i < n; i++ )
+        {
+            const float squared_dist = std::pow(points[i].x - points[0].x, 2) +
+                                       std::pow(points[i].y - points[0].y, 2);
+            if ( squared_dist > max_squared_dist )
+            {
+                max_squared_dist = squared_dist;
+                farthest = i;
+            }
+        }
+        is_kept[farthest] = true;
+        stack.push_back(std::make_pair(0, farthest));
+        stack.push_back(std::make_pair(farthest, n));
+    }
+    else
+    {
+        is_kept[n-1] = true;
+        stack.push_back(std::make_pair(0, n-1));
+    }
+
+    const float squared_tolerance = tolerance * tolerance;
+    while ( !stack.empty() )
+    {
+        const size_t first = stack.back().first;
+        const size_t last = stack.back().second;
+        stack.pop_back();
+
+        const T& start = points[first];
+        const T& end = points[last % n];
+        size_t farthest = first;
+        float max_squared_dist = squared_tolerance;
+        for ( size_t i = first + 1; i < last; i++ )
+        {
+            const float squared_dist = calcSquaredDistToSegment(start, end, points[i]);
+            if ( squared_dist > max_squared_dist )
+            {
+                max_squared_dist = squared_dist;
+                farthest = i;
+            }
+        }
+        if ( farthest != first )
+        {
+            is_kept[farthest] = true;
+            stack.push_back(std::make_pair(first, farthest));
+            stack.push_back(std::make_pair(farthest, last));
+        }
+    }
+
+    std::vector<T> simplified_points;
+    for ( size_t i = 0; i < n; i++ )
+    {
+        if ( is_kept[i] )
+        {
+            simplified_points.push_back(points[i]);
+        }
+    }
+    return ( is_closed && simplified_points.size() < 3 )
+           ? points
+           : simplified_points;
+}
+
+template std::vector<Point2D> Utils::simplifyDouglasPeucker(
+        const std::vector<Point2D>& points, float tolerance, bool is_closed);
+template std::vector<Pose2D> Utils::simplifyDouglasPeucker(
+        const std::vector<Pose2D>& points, float tolerance, bool is_closed);
+
+template <typename T>
+std::vector<T> Utils::simplifyVisvalingamWhyatt(
+        const std::vector<T>& points,
+        float area_tolerance,
+        bool is_closed)
+{
+    const size_t n = points.size();
+    const size_t min_num_of_points = ( is_closed ) ? 3 : 2;
+    if ( n <= min_num_of_points )
+    {
+        return points;
+    }
+
+    /* doubly linked list over the vertices; end points of open chains are
+     * never inserted into the heap */
+    std::vector<size_t> prev(n), next(n);
+    std::vector<float> areas(n, std::numeric_limits<float>::max());
+    std::vector<char> is_removed(n, false);
+    using HeapEntry = std::pair<float, size_t>;
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>,
+                        std::greater<HeapEntry>> heap;
+    for ( size_t i = 0; i < n; i++ )
+    {
+        prev[i] = ( i > 0 ) ? i-1 : n-1;
+        next[i] = ( i+1 < n ) ? i+1 : 0;
+        if ( is_closed || (i > 0 && i+1 < n) )
+        {
+            areas[i] = calcTriangleArea(points[prev[i]], points[i], points[next[i]]);
+            heap.push(HeapEntry(areas[i], i));
+        }
+    }
+
+    size_t num_of_points = n;
+    while ( !heap.empty() && num_of_points > min_num_of_points )
+    {
+        const HeapEntry entry = heap.top();
+        heap.pop();
+        const size_t i = entry.second;
+        if ( is_removed[i] || entry.first != areas[i] ) // outdated entry
+        {
+            continue;
+        }
+        if ( entry.first >= area_tolerance )
+        {
+            break;
+        }
+
+        is_removed[i] = true;
+        num_of_points--;
+        next[prev[i]] = next[i];
+        prev[next[i]] = prev[i];
+
+        /* neighbours get at least the area of the removed vertex so that
+         * vertices are removed in order of their effective area */
+        const size_t neighbours[2] = {prev[i], next[i]};
+        for ( size_t neighbour : neighbours )
+        {
+            if ( !is_closed && (neighbour == 0 || neighbour == n-1) )
+            {
+                continue;
+            }
+            areas[neighbour] = std::max(entry.first, calcTriangleArea(
+                        points[prev[neighbour]], points[neighbour],
+                        points[next[neighbour]]));
+            heap.push(HeapEntry(areas[neighbour], neighbour));
+        }
+    }
+
+    std::vector<T> simplified_points;
+    simplified_points.reserve(num_of_points);
+    for ( size_t i = 0; i < n; i++ )
+    {
+        if ( !is_removed[i] )
+        {
+            simplified_points.push_back(points[i]);
+        }
+    }
+    return simplified_points;
+}
+
+template std::vector<Point2D> Utils::simplifyVisvalingamWhyatt(
+        const std::vector<Point2D>& points, float area_tolerance, bool is_closed);
+template std::vector<Pose2D> Utils::simplifyVisvalingamWhyatt(
+        const std::vector<Pose2D>& points, float area_tolerance, bool is_closed);
+
+void Utils::convertQuaternionToEuler(
+        float qx,
+        float qy,
+        float qz,
+        float qw,
+        float& roll,
+        float& pitch,
+        float& yaw)
+{
+    /**
+     * source: https://www.euclideanspace.com/maths/geometry/rotations/conversions/quaternionToEuler/
+     */
+    float sinpitch = 2 * (qw * qy - qz * qx);
+    if ( sinpitch >= 1.0f ) // singularity at north pole
+    {
+        roll = 0.0f;
+        pitch = M_PI/2;
+        yaw = 2 * std::atan2(qx, qw);
+    }
+    else if ( sinpitch <= -1.0f ) // singularity at south pole
+    {
+        roll = 0.0f;
+        pitch = -M_PI/2;
+        yaw = -2 * std::atan2(qx, qw);
+    }
     else
     {
         roll = std::atan2(2 * (qx*qw + qy*qz), 1 - (2 * (qx*qx + qy*qy)));
@@ -1471,6 +2510,68 @@ void Utils::convertQuaternionToEuler(
     }
 }
 
+uint16_t Utils::convertToFloat16(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = (bits >> 16) & 0x8000u;
+    const uint32_t abs_bits = bits & 0x7fffffffu;
+
+    if ( abs_bits >= 0x7f800000u ) // inf or NaN (keep NaN quiet)
+    {
+        return sign | 0x7c00u | (( abs_bits > 0x7f800000u ) ? 0x0200u : 0u);
+    }
+    if ( abs_bits >= 0x477ff000u ) // rounds to more than 65504
+    {
+        return sign | 0x7c00u;
+    }
+    if ( abs_bits < 0x38800000u ) // subnormal half
+    {
+        if ( abs_bits < 0x33000000u ) // less than half of smallest subnormal
+        {
+            return sign;
+        }
+        const uint32_t exponent = abs_bits >> 23;
+        const uint32_t mantissa = (abs_bits & 0x7fffffu) | 0x800000u;
+        const uint32_t shift = 126 - exponent;
+        uint32_t half_bits = mantissa >> shift;
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        const uint32_t halfway = 1u << (shift - 1);
+        if ( remainder > halfway || ( remainder == halfway && (half_bits & 1u) ) )
+        {
+            half_bits++;
+        }
+        return sign | half_bits;
+    }
+
+    /* normal half: rebias exponent from 127 to 15 and drop 13 mantissa bits */
+    uint32_t half_bits = (abs_bits - 0x38000000u) >> 13;
+    const uint32_t remainder = abs_bits & 0x1fffu;
+    if ( remainder > 0x1000u || ( remainder == 0x1000u && (half_bits & 1u) ) )
+    {
+        half_bits++;
+    }
+    return sign | half_bits;
+}
+
+float Utils::convertFromFloat16(uint16_t bits)
+{
+    const uint32_t sign = static_cast<uint32_t>(bits & 0x8000u) << 16;
+    const uint32_t exponent = (bits >> 10) & 0x1fu;
+    const uint32_t mantissa = bits & 0x3ffu;
+    if ( exponent == 0 ) // zero or subnormal
+    {
+        const float value = std::ldexp(static_cast<float>(mantissa), -24);
+        return ( sign != 0 ) ? -value : value;
+    }
+    uint32_t float_bits = ( exponent == 0x1fu )
+                          ? sign | 0x7f800000u | (mantissa << 13)
+                          : sign | ((exponent + 112) << 23) | (mantissa << 13);
+    float value;
+    std::memcpy(&value, &float_bits, sizeof(value));
+    return value;
+}
+
 void Utils::convertEulerToQuaternion(
         float roll,
         float pitch,
@@ -1501,41 +2602,156 @@ nav_msgs::Path Utils::convertToROSPath(
         const std::string& frame)
 {
     nav_msgs::Path path_msg;
-    path_msg.header.frame_id = frame;
-    path_msg.poses.clear();
+    Utils::convertToROSPath(trajectory, path_msg, frame);
+    return path_msg;
+}
 
-    for ( Pose2D pose : trajectory )
-    {
-        path_msg.poses.push_back(pose.asPoseStamped(frame));
+void Utils::convertToROSPath(
+        const std::vector<Pose2D>& trajectory,
+        nav_msgs::Path& path_msg,
+        const std::string& frame)
+{
+    path_msg.header.frame_id = frame;
+    path_msg.poses.resize(trajectory.size());
+    for ( size_t i = 0; i < trajectory.size(); i++ )
+    {
+        geometry_msgs::PoseStamped& pose_msg = path_msg.poses[i];
+        pose_msg.header = path_msg.header;
+        pose_msg.pose.position.x = trajectory[i].x;
+        pose_msg.pose.position.y = trajectory[i].y;
+        pose_msg.pose.position.z = 0.0f;
+        /* rotation only about Z axis */
+        const float half_theta = trajectory[i].theta * 0.5f;
+        pose_msg.pose.orientation.x = 0.0f;
+        pose_msg.pose.orientation.y = 0.0f;
+        pose_msg.pose.orientation.z = std::sin(half_theta);
+        pose_msg.pose.orientation.w = std::cos(half_theta);
     }
-    return path_msg;
 }
 
-visualization_msgs::Marker Utils::convertGeometricPathToMarker(
-        const Path& geometric_path,
+namespace
+{
+
+void initMarker(
+        visualization_msgs::Marker& marker,
+        int32_t type,
         const std::string& frame,
         float red,
         float green,
         float blue,
         float alpha,
-        float line_width)
+        float scale)
 {
-    visualization_msgs::Marker marker;
-    marker.type = visualization_msgs::Marker::LINE_STRIP;
+    marker.type = type;
     marker.header.frame_id = frame;
     marker.color.r = red;
     marker.color.g = green;
     marker.color.b = blue;
     marker.color.a = alpha;
-    marker.scale.x = line_width;
+    marker.scale.x = scale;
     marker.pose.orientation.w = 1.0f;
-    marker.points.reserve(geometric_path.size());
+}
+
+inline void assignPoint(const Point2D& pt, geometry_msgs::Point& point_msg)
+{
+    point_msg.x = pt.x;
+    point_msg.y = pt.y;
+    point_msg.z = 0.0f;
+}
+
+inline void assignPoint(const Point3D& pt, geometry_msgs::Point& point_msg)
+{
+    point_msg.x = pt.x;
+    point_msg.y = pt.y;
+    point_msg.z = pt.z;
+}
+
+inline void assignPoint(const Pose2D& pose, geometry_msgs::Point& point_msg)
+{
+    point_msg.x = pose.x;
+    point_msg.y = pose.y;
+    point_msg.z = 0.0f;
+}
+
+} // namespace
+
+visualization_msgs::Marker Utils::convertGeometricPathToMarker(
+        const Path& geometric_path,
+        const std::string& frame,
+        float red,
+        float green,
+        float blue,
+        float alpha,
+        float line_width)
+{
+    visualization_msgs::Marker marker;
+    Utils::convertGeometricPathToMarker(geometric_path, marker, frame, red,
+                                        green, blue, alpha, line_width);
+    return marker;
+}
+
+void Utils::convertGeometricPathToMarker(
+        const Path& geometric_path,
+        visualization_msgs::Marker& marker,
+        const std::string& frame,
+        float red,
+        float green,
+        float blue,
+        float alpha,
+        float line_width)
+{
+    initMarker(marker, visualization_msgs::Marker::LINE_STRIP, frame,
+               red, green, blue, alpha, line_width);
+    marker.points.resize(geometric_path.size());
     for ( size_t i = 0; i < geometric_path.size(); i++ )
     {
-        marker.points.push_back(geometric_path[i].position().asPoint());
+        assignPoint(geometric_path[i], marker.points[i]);
+    }
+}
+
+template <typename T>
+void Utils::convertPolylinesToMarker(
+        const std::vector<std::vector<T>>& polylines,
+        visualization_msgs::Marker& marker,
+        const std::string& frame,
+        float red,
+        float green,
+        float blue,
+        float alpha,
+        float line_width)
+{
+    initMarker(marker, visualization_msgs::Marker::LINE_LIST, frame,
+               red, green, blue, alpha, line_width);
+    size_t num_of_segments = 0;
+    for ( const std::vector<T>& polyline : polylines )
+    {
+        num_of_segments += ( polyline.size() < 2 ) ? 0 : polyline.size() - 1;
+    }
+    marker.points.resize(2 * num_of_segments);
+
+    size_t index = 0;
+    for ( const std::vector<T>& polyline : polylines )
+    {
+        for ( size_t i = 1; i < polyline.size(); i++ )
+        {
+            assignPoint(polyline[i-1], marker.points[index]);
+            assignPoint(polyline[i], marker.points[index+1]);
+            index += 2;
+        }
     }
-    return marker;
 }
+template void Utils::convertPolylinesToMarker(
+        const std::vector<PointVec2D>& polylines,
+        visualization_msgs::Marker& marker, const std::string& frame,
+        float red, float green, float blue, float alpha, float line_width);
+template void Utils::convertPolylinesToMarker(
+        const std::vector<PointVec3D>& polylines,
+        visualization_msgs::Marker& marker, const std::string& frame,
+        float red, float green, float blue, float alpha, float line_width);
+template void Utils::convertPolylinesToMarker(
+        const std::vector<Path>& polylines,
+        visualization_msgs::Marker& marker, const std::string& frame,
+        float red, float green, float blue, float alpha, float line_width);
 
 template <typename T>
 visualization_msgs::Marker Utils::convertPointCloudToMarker(
@@ -1548,20 +2764,8 @@ visualization_msgs::Marker Utils::convertPointCloudToMarker(
         float alpha)
 {
     visualization_msgs::Marker cloud_marker;
-    cloud_marker.type = visualization_msgs::Marker::POINTS;
-    cloud_marker.pose.orientation.w = 1.0f;
-    cloud_marker.scale.x = diameter;
-    cloud_marker.scale.y = diameter;
-    cloud_marker.color.r = red;
-    cloud_marker.color.g = green;
-    cloud_marker.color.b = blue;
-    cloud_marker.color.a = alpha;
-    cloud_marker.header.frame_id = frame;
-    cloud_marker.points.reserve(cloud.size());
-    for ( const T& pt : cloud )
-    {
-        cloud_marker.points.push_back(pt.asPoint());
-    }
+    Utils::convertPointCloudToMarker(cloud, cloud_marker, frame, diameter,
+                                     red, green, blue, alpha);
     return cloud_marker;
 }
 template visualization_msgs::Marker Utils::convertPointCloudToMarker(
@@ -1571,6 +2775,35 @@ template visualization_msgs::Marker Utils::convertPointCloudToMarker(
         const PointCloud3D& cloud, const std::string& frame,
         float diameter, float red, float green, float blue, float alpha);
 
+template <typename T>
+void Utils::convertPointCloudToMarker(
+        const std::vector<T>& cloud,
+        visualization_msgs::Marker& marker,
+        const std::string& frame,
+        float diameter,
+        float red,
+        float green,
+        float blue,
+        float alpha)
+{
+    initMarker(marker, visualization_msgs::Marker::POINTS, frame,
+               red, green, blue, alpha, diameter);
+    marker.scale.y = diameter;
+    marker.points.resize(cloud.size());
+    for ( size_t i = 0; i < cloud.size(); i++ )
+    {
+        assignPoint(cloud[i], marker.points[i]);
+    }
+}
+template void Utils::convertPointCloudToMarker(
+        const PointCloud2D& cloud, visualization_msgs::Marker& marker,
+        const std::string& frame, float diameter,
+        float red, float green, float blue, float alpha);
+template void Utils::convertPointCloudToMarker(
+        const PointCloud3D& cloud, visualization_msgs::Marker& marker,
+        const std::string& frame, float diameter,
+        float red, float green, float blue, float alpha);
+
 visualization_msgs::Marker Utils::convertStringToMarker(
         const std::string& string_label,
         const std::string& frame,
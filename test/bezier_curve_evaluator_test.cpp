@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <geometry_common/BezierCurveEvaluator.h>
+#include <geometry_common/Utils.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::PointVec2D;
+using kelo::geometry_common::Utils;
+using kelo::geometry_common::BezierCurveEvaluator;
+
+TEST(BezierCurveEvaluatorTest, calcCurvePoints)
+{
+    BezierCurveEvaluator evaluator;
+    PointVec2D curve_points;
+    evaluator.calcCurvePoints(PointVec2D{Point2D(1.0f, 1.0f)}, 10, curve_points);
+    EXPECT_TRUE(curve_points.empty());
+
+    for ( size_t order = 1; order < 8; order++ )
+    {
+        PointVec2D control_points;
+        for ( size_t i = 0; i <= order; i++ )
+        {
+            control_points.push_back(Point2D(i, (i % 2 == 0) ? 0.0f : 2.0f));
+        }
+        const size_t num_of_points = 21;
+        std::vector<unsigned int> coefficients =
+            Utils::calcPascalTriangleRowCoefficients(order);
+
+        evaluator.calcCurvePoints(control_points, num_of_points, curve_points);
+        ASSERT_EQ(curve_points.size(), num_of_points);
+        EXPECT_EQ(curve_points.front(), control_points.front());
+        EXPECT_EQ(curve_points.back(), control_points.back());
+        for ( size_t j = 0; j < num_of_points; j++ )
+        {
+            const float t = static_cast<float>(j) / (num_of_points - 1);
+            EXPECT_EQ(curve_points[j],
+                      Utils::calcSplineCurvePoint(control_points, coefficients, t));
+        }
+
+        /* uncached single curve evaluation gives the same curve */
+        const PointVec2D utils_curve_points =
+            Utils::calcSplineCurvePoints(control_points, num_of_points);
+        ASSERT_EQ(utils_curve_points.size(), num_of_points);
+        for ( size_t j = 0; j < num_of_points; j++ )
+        {
+            EXPECT_EQ(utils_curve_points[j], curve_points[j]);
+        }
+    }
+}
+
+TEST(BezierCurveEvaluatorTest, highOrderAndBatch)
+{
+    /* order 60 would overflow pascal triangle coefficients */
+    PointVec2D control_points;
+    for ( size_t i = 0; i <= 60; i++ )
+    {
+        control_points.push_back(Point2D(i, 1.0f));
+    }
+    BezierCurveEvaluator evaluator;
+    std::vector<PointVec2D> curves;
+    evaluator.calcCurvePoints(
+            std::vector<PointVec2D>{control_points,
+                                    PointVec2D{Point2D(0.0f, 0.0f), Point2D(2.0f, 2.0f)}},
+            5, curves);
+    ASSERT_EQ(curves.size(), 2u);
+    ASSERT_EQ(curves[0].size(), 5u);
+    for ( size_t j = 0; j < 5; j++ )
+    {
+        // evenly spaced control points on a line lead to linear interpolation
+        EXPECT_EQ(curves[0][j], Point2D(j * 15.0f, 1.0f));
+        EXPECT_EQ(curves[1][j], Point2D(j * 0.5f, j * 0.5f));
+    }
+
+    const std::vector<float>& basis = evaluator.basis(60, 5);
+    ASSERT_EQ(basis.size(), 5u * 61u);
+    for ( size_t j = 0; j < 5; j++ )
+    {
+        float sum = 0.0f;
+        for ( size_t i = 0; i < 61; i++ )
+        {
+            sum += basis[(j * 61) + i];
+        }
+        EXPECT_NEAR(sum, 1.0f, 1e-5f);
+    }
+}
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <sstream>
+
+#include <geometry_common/BinaryReader.h>
+#include <geometry_common/BinaryWriter.h>
+#include <geometry_common/Utils.h>
+
+using kelo::geometry_common::BinaryReader;
+using kelo::geometry_common::BinaryWriter;
+using kelo::geometry_common::Box2D;
+using kelo::geometry_common::Circle;
+using kelo::geometry_common::CloudEncoding;
+using kelo::geometry_common::LineSegment2D;
+using kelo::geometry_common::Path;
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::PointCloud2D;
+using kelo::geometry_common::PointCloud3D;
+using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::PolygonWithHoles2D;
+using kelo::geometry_common::Pose2D;
+using kelo::geometry_common::TransformMatrix3D;
+using kelo::geometry_common::Utils;
+
+TEST(BinarySerialisationTest, float16)
+{
+    const float values[] = {0.0f, 1.0f, -2.5f, 65504.0f, 6.1035156e-05f,
+                            5.9604645e-08f, 0.1f, 1234.5f};
+    for ( float value : values )
+    {
+        const float converted = Utils::convertFromFloat16(Utils::convertToFloat16(value));
+        EXPECT_NEAR(converted, value, std::fabs(value) * 1e-3f);
+    }
+    EXPECT_EQ(Utils::convertToFloat16(1.0f), 0x3c00u);
+    EXPECT_EQ(Utils::convertToFloat16(-2.0f), 0xc000u);
+    EXPECT_EQ(Utils::convertToFloat16(1e6f), 0x7c00u);
+    EXPECT_EQ(Utils::convertToFloat16(1e-9f), 0u);
+    EXPECT_TRUE(std::isnan(Utils::convertFromFloat16(Utils::convertToFloat16(
+                    std::numeric_limits<float>::quiet_NaN()))));
+
+    /* every finite half value converts back to itself */
+    for ( uint32_t bits = 0; bits < 0x7c00u; bits++ )
+    {
+        ASSERT_EQ(Utils::convertToFloat16(Utils::convertFromFloat16(bits)), bits);
+    }
+}
+
+TEST(BinarySerialisationTest, roundTrip)
+{
+    const Pose2D pose(1.0f, -2.0f, 0.5f);
+    const Circle circle(3.0f, 4.0f, 0.25f);
+    const LineSegment2D line_segment(Point2D(0.0f, 1.0f), Point2D(2.0f, 3.0f));
+    const Box2D box(-1.0f, 1.0f, -2.0f, 2.0f);
+    const Path path{Pose2D(0.0f, 0.0f, 0.0f), Pose2D(1.0f, 0.5f, 0.3f)};
+    PolygonWithHoles2D region(Polygon2D({Point2D(0.0f, 0.0f), Point2D(4.0f, 0.0f),
+                                         Point2D(4.0f, 4.0f), Point2D(0.0f, 4.0f)}),
+                              {Polygon2D({Point2D(1.0f, 1.0f), Point2D(2.0f, 1.0f),
+                                          Point2D(2.0f, 2.0f)})});
+    const TransformMatrix3D tf_mat(1.0f, 2.0f, 3.0f, 0.1f, -0.2f, 0.3f);
+
+    std::stringstream stream;
+    BinaryWriter writer(stream);
+    EXPECT_TRUE(writer.writeHeader());
+    writer.write(pose);
+    writer.write(circle);
+    writer.write(line_segment);
+    writer.write(box);
+    writer.write(path);
+    writer.write(region);
+    writer.write(tf_mat);
+    EXPECT_TRUE(writer.good());
+
+    BinaryReader reader(stream);
+    Pose2D read_pose;
+    Circle read_circle;
+    LineSegment2D read_line_segment;
+    Box2D read_box;
+    Path read_path;
+    PolygonWithHoles2D read_region;
+    TransformMatrix3D read_tf_mat;
+    ASSERT_TRUE(reader.readHeader());
+    EXPECT_EQ(reader.version(), BinaryWriter::VERSION);
+    EXPECT_TRUE(reader.read(read_pose));
+    EXPECT_TRUE(reader.read(read_circle));
+    EXPECT_TRUE(reader.read(read_line_segment));
+    EXPECT_TRUE(reader.read(read_box));
+    EXPECT_TRUE(reader.read(read_path));
+    EXPECT_TRUE(reader.read(read_region));
+    EXPECT_TRUE(reader.read(read_tf_mat));
+    EXPECT_EQ(reader.bytesRead(), writer.bytesWritten());
+
+    EXPECT_EQ(read_pose, pose);
+    EXPECT_EQ(read_circle, circle);
+    EXPECT_FLOAT_EQ(read_circle.r, circle.r);
+    EXPECT_EQ(read_line_segment, line_segment);
+    EXPECT_FLOAT_EQ(read_box.max_y, box.max_y);
+    EXPECT_EQ(read_path, path);
+    EXPECT_EQ(read_region.boundary, region.boundary);
+    ASSERT_EQ(read_region.holes.size(), 1u);
+    EXPECT_EQ(read_region.holes[0], region.holes[0]);
+    EXPECT_NEAR(read_tf_mat.roll(), tf_mat.roll(), 1e-5f);
+    EXPECT_NEAR(read_tf_mat.yaw(), tf_mat.yaw(), 1e-5f);
+    EXPECT_NEAR(read_tf_mat.z(), tf_mat.z(), 1e-5f);
+
+    /* reading past the end fails */
+    EXPECT_FALSE(reader.read(read_pose));
+    EXPECT_FALSE(reader.good());
+}
+
+TEST(BinarySerialisationTest, cloudEncodings)
+{
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> dist(-20.0f, 20.0f);
+    PointCloud3D cloud(3000);
+    for ( Point3D& point : cloud )
+    {
+        point = Point3D(dist(gen), dist(gen), dist(gen) * 0.1f);
+    }
+
+    const float resolution = 0.001f;
+    std::vector<uint8_t> buffer;
+    BinaryWriter writer(buffer);
+    writer.write(cloud);
+    const size_t float32_size = buffer.size();
+    writer.write(cloud, CloudEncoding::FLOAT16);
+    const size_t float16_size = buffer.size() - float32_size;
+    writer.write(cloud, CloudEncoding::QUANTISED_INT16, resolution);
+    const size_t quantised_size = buffer.size() - float32_size - float16_size;
+    EXPECT_EQ(float32_size, 5 + (cloud.size() * 12));
+    EXPECT_EQ(float16_size, 5 + (cloud.size() * 6));
+    EXPECT_EQ(quantised_size, 5 + 16 + (cloud.size() * 6));
+    /* range of 40 does not fit in 65536 steps of 0.0001 */
+    writer.write(cloud, CloudEncoding::QUANTISED_INT16, 0.0001f);
+    EXPECT_EQ(buffer.size(), (2 * float32_size) + float16_size + quantised_size);
+
+    BinaryReader reader(buffer);
+    PointCloud3D float32_cloud, float16_cloud, quantised_cloud, fallback_cloud;
+    ASSERT_TRUE(reader.read(float32_cloud));
+    ASSERT_TRUE(reader.read(float16_cloud));
+    ASSERT_TRUE(reader.read(quantised_cloud));
+    ASSERT_TRUE(reader.read(fallback_cloud));
+    ASSERT_EQ(float32_cloud.size(), cloud.size());
+    ASSERT_EQ(float16_cloud.size(), cloud.size());
+    ASSERT_EQ(quantised_cloud.size(), cloud.size());
+    for ( size_t i = 0; i < cloud.size(); i++ )
+    {
+        EXPECT_FLOAT_EQ(float32_cloud[i].x, cloud[i].x);
+        EXPECT_FLOAT_EQ(fallback_cloud[i].z, cloud[i].z);
+        EXPECT_NEAR(float16_cloud[i].x, cloud[i].x, 0.01f);
+        EXPECT_NEAR(float16_cloud[i].z, cloud[i].z, 0.001f);
+        EXPECT_NEAR(quantised_cloud[i].y, cloud[i].y, resolution);
+        EXPECT_NEAR(quantised_cloud[i].z, cloud[i].z, resolution);
+    }
+
+    /* truncated buffer is rejected without allocating */
+    PointCloud2D cloud_2d(100, Point2D(1.0f, 2.0f));
+    std::vector<uint8_t> buffer_2d;
+    BinaryWriter writer_2d(buffer_2d);
+    writer_2d.write(cloud_2d);
+    BinaryReader truncated_reader(buffer_2d.data(), buffer_2d.size() - 1);
+    PointCloud2D read_cloud_2d;
+    EXPECT_FALSE(truncated_reader.read(read_cloud_2d));
+    EXPECT_TRUE(read_cloud_2d.empty());
+    BinaryReader reader_2d(buffer_2d);
+    EXPECT_TRUE(reader_2d.read(read_cloud_2d));
+    EXPECT_EQ(read_cloud_2d, cloud_2d);
+}
+
+TEST(BinarySerialisationTest, corruptedStreamSize)
+{
+    /* header, FLOAT32 tag and a huge point count without any points */
+    std::stringstream header_stream;
+    BinaryWriter header_writer(header_stream);
+    EXPECT_TRUE(header_writer.writeHeader());
+    const std::string header = header_stream.str();
+    const std::string huge_count("\xf0\xff\xff\x0f", 4);
+
+    std::stringstream cloud_stream(header + std::string(1, '\x01') + huge_count);
+    BinaryReader cloud_reader(cloud_stream);
+    EXPECT_TRUE(cloud_reader.readHeader());
+    PointCloud2D cloud;
+    EXPECT_FALSE(cloud_reader.read(cloud));
+    EXPECT_FALSE(cloud_reader.good());
+
+    std::stringstream polygons_stream(header + huge_count);
+    BinaryReader polygons_reader(polygons_stream);
+    EXPECT_TRUE(polygons_reader.readHeader());
+    std::vector<Polygon2D> polygons;
+    EXPECT_FALSE(polygons_reader.read(polygons));
+    EXPECT_FALSE(polygons_reader.good());
+}
+
+TEST(BinarySerialisationTest, corruptedBufferSize)
+{
+    std::vector<uint8_t> buffer;
+    BinaryWriter writer(buffer);
+    EXPECT_TRUE(writer.write(std::vector<Circle>(2, Circle(1.0f, 2.0f, 3.0f))));
+    EXPECT_TRUE(writer.write(Circle(4.0f, 5.0f, 6.0f)));
+
+    /* count of the vector exceeds the remaining buffer */
+    buffer[0] = 0xff;
+    buffer[1] = 0xff;
+    BinaryReader reader(buffer);
+    std::vector<Circle> circles;
+    EXPECT_FALSE(reader.read(circles));
+    EXPECT_FALSE(reader.good());
+
+    /* the payload of the rejected vector must not be decoded */
+    Circle circle;
+    EXPECT_FALSE(reader.read(circle));
+    EXPECT_EQ(reader.bytesRead(), 4u);
+}
+
+TEST(BinarySerialisationTest, manyCloudsInOneBuffer)
+{
+    const PointCloud2D cloud(10, Point2D(1.0f, 2.0f));
+    const size_t num_of_clouds = 20000;
+    std::vector<uint8_t> buffer;
+    BinaryWriter writer(buffer);
+
+    /* buffer must keep growing geometrically */
+    size_t num_of_reallocations = 0;
+    const uint8_t* data = buffer.data();
+    for ( size_t i = 0; i < num_of_clouds; i++ )
+    {
+        writer.write(cloud);
+        if ( buffer.data() != data )
+        {
+            data = buffer.data();
+            num_of_reallocations++;
+        }
+    }
+    EXPECT_TRUE(writer.good());
+    EXPECT_LT(num_of_reallocations, 64u);
+
+    BinaryReader reader(buffer);
+    PointCloud2D read_cloud;
+    for ( size_t i = 0; i < num_of_clouds; i++ )
+    {
+        ASSERT_TRUE(reader.read(read_cloud));
+        ASSERT_EQ(read_cloud, cloud);
+    }
+    EXPECT_EQ(reader.bytesRead(), buffer.size());
+}
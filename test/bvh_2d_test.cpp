@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <geometry_common/BVH2D.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::LineSegment2D;
+using kelo::geometry_common::BVH2D;
+
+std::vector<Polygon2D> createRandomTriangles(size_t num_of_triangles)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> offset(-2.0f, 2.0f);
+    std::vector<Polygon2D> triangles;
+    for ( size_t i = 0; i < num_of_triangles; i++ )
+    {
+        Point2D center(position(generator), position(generator));
+        triangles.push_back(Polygon2D(
+        {
+            center + Point2D(offset(generator), offset(generator)),
+            center + Point2D(offset(generator), offset(generator)),
+            center + Point2D(offset(generator), offset(generator))
+        }));
+    }
+    return triangles;
+}
+
+TEST(BVH2DTest, containsPoint)
+{
+    std::vector<Polygon2D> triangles = createRandomTriangles(500);
+    BVH2D<Polygon2D> bvh(triangles);
+    ASSERT_EQ(bvh.size(), triangles.size());
+    EXPECT_EQ(bvh[7], triangles[7]);
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> position(-55.0f, 55.0f);
+    std::vector<size_t> indices;
+    for ( size_t i = 0; i < 1000; i++ )
+    {
+        Point2D pt(position(generator), position(generator));
+        std::vector<size_t> expected_indices;
+        for ( size_t j = 0; j < triangles.size(); j++ )
+        {
+            if ( triangles[j].containsPoint(pt) )
+            {
+                expected_indices.push_back(j);
+            }
+        }
+        bvh.calcIndicesContaining(pt, indices);
+        std::sort(indices.begin(), indices.end());
+        EXPECT_EQ(indices, expected_indices);
+        EXPECT_EQ(bvh.containsPoint(pt), !expected_indices.empty());
+    }
+}
+
+TEST(BVH2DTest, intersects)
+{
+    std::vector<Polygon2D> triangles = createRandomTriangles(500);
+    BVH2D<Polygon2D> bvh(triangles);
+
+    std::mt19937 generator(9);
+    std::uniform_real_distribution<float> position(-55.0f, 55.0f);
+    std::vector<size_t> indices;
+    for ( size_t i = 0; i < 200; i++ )
+    {
+        LineSegment2D segment(position(generator), position(generator),
+                              position(generator), position(generator));
+        std::vector<size_t> expected_indices;
+        for ( size_t j = 0; j < triangles.size(); j++ )
+        {
+            if ( triangles[j].intersects(segment) )
+            {
+                expected_indices.push_back(j);
+            }
+        }
+        bvh.calcIndicesIntersecting(segment, indices);
+        std::sort(indices.begin(), indices.end());
+        EXPECT_EQ(indices, expected_indices);
+        EXPECT_EQ(bvh.intersects(segment), !expected_indices.empty());
+    }
+}
+
+TEST(BVH2DTest, calcNearest)
+{
+    std::vector<LineSegment2D> segments;
+    for ( const Polygon2D& triangle : createRandomTriangles(300) )
+    {
+        segments.push_back(LineSegment2D(triangle[0], triangle[1]));
+    }
+    BVH2D<LineSegment2D> bvh(segments, 2);
+
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+    for ( size_t i = 0; i < 500; i++ )
+    {
+        Point2D pt(position(generator), position(generator));
+        float expected_dist = std::numeric_limits<float>::max();
+        for ( const LineSegment2D& segment : segments )
+        {
+            expected_dist = std::min(expected_dist, segment.minDistTo(pt));
+        }
+        size_t index;
+        float dist;
+        ASSERT_TRUE(bvh.calcNearest(pt, index, dist));
+        EXPECT_NEAR(dist, expected_dist, 1e-5f);
+        EXPECT_NEAR(segments[index].minDistTo(pt), expected_dist, 1e-5f);
+    }
+
+    BVH2D<LineSegment2D> empty_bvh;
+    size_t index;
+    float dist;
+    EXPECT_FALSE(empty_bvh.calcNearest(Point2D(), index, dist));
+
+    /* non empty hierarchy of shapes without vertices */
+    BVH2D<Polygon2D> empty_shapes_bvh(std::vector<Polygon2D>(3));
+    EXPECT_FALSE(empty_shapes_bvh.calcNearest(Point2D(), index, dist));
+    EXPECT_FALSE(empty_bvh.containsPoint(Point2D()));
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <geometry_common/CachedPolygon2D.h>
+
+using kelo::geometry_common::Box2D;
+using kelo::geometry_common::CachedPolygon2D;
+using kelo::geometry_common::LineSegment2D;
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::WindingOrder;
+
+TEST(CachedPolygon2DTest, derivedQuantities)
+{
+    Polygon2D square(
+    {
+        Point2D(0.0f, 0.0f),
+        Point2D(2.0f, 0.0f),
+        Point2D(2.0f, 2.0f),
+        Point2D(0.0f, 2.0f)
+    });
+    CachedPolygon2D cached(square);
+    EXPECT_EQ(cached.boundingBox(), Box2D(0.0f, 2.0f, 0.0f, 2.0f));
+    EXPECT_FLOAT_EQ(cached.area(), 4.0f);
+    EXPECT_EQ(cached.centroid(), Point2D(1.0f, 1.0f));
+    EXPECT_EQ(cached.meanPoint(), Point2D(1.0f, 1.0f));
+    EXPECT_EQ(cached.windingOrder(), WindingOrder::COUNTER_CLOCKWISE);
+    EXPECT_TRUE(cached.isConvex());
+
+    /* modifying a vertex invalidates the cached values */
+    cached.setVertex(2, Point2D(0.5f, 0.5f));
+    EXPECT_EQ(cached.boundingBox(), Box2D(0.0f, 2.0f, 0.0f, 2.0f));
+    EXPECT_FLOAT_EQ(cached.area(), cached.polygon().area());
+    EXPECT_FALSE(cached.isConvex());
+
+    cached.setVertex(0, Point2D(-4.0f, 0.0f));
+    EXPECT_EQ(cached.boundingBox(), Box2D(-4.0f, 2.0f, 0.0f, 2.0f));
+    EXPECT_FLOAT_EQ(cached.area(), cached.polygon().area());
+
+    cached.updatePolygon(Polygon2D({Point2D(0.0f, 0.0f), Point2D(0.0f, 3.0f),
+                                    Point2D(3.0f, 0.0f)}));
+    EXPECT_EQ(cached.windingOrder(), WindingOrder::CLOCKWISE);
+    EXPECT_FLOAT_EQ(cached.area(), -4.5f);
+    EXPECT_EQ(cached.centroid(), Point2D(1.0f, 1.0f));
+}
+
+TEST(CachedPolygon2DTest, queriesMatchPolygon)
+{
+    Polygon2D star;
+    for ( size_t i = 0; i < 10; i++ )
+    {
+        float radius = ( i % 2 == 0 ) ? 3.0f : 1.0f;
+        star.vertices.push_back(Point2D::initFromRadialCoord(radius, i * M_PI / 5));
+    }
+    CachedPolygon2D cached(star);
+
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<float> position(-5.0f, 5.0f);
+    for ( size_t i = 0; i < 1000; i++ )
+    {
+        Point2D pt(position(generator), position(generator));
+        EXPECT_EQ(cached.containsPoint(pt), star.containsPoint(pt));
+
+        LineSegment2D segment(pt, Point2D(position(generator), position(generator)));
+        EXPECT_EQ(cached.intersects(segment), star.intersects(segment));
+    }
+}
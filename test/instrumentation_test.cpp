@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <gtest/gtest.h>
+#include <geometry_common/Instrumentation.h>
+#include <geometry_common/Polygon2D.h>
+
+using kelo::geometry_common::Instrumentation;
+using kelo::geometry_common::ProbeSnapshot;
+using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::Point2D;
+
+namespace
+{
+
+const ProbeSnapshot* findSnapshot(
+        const std::vector<ProbeSnapshot>& snapshots,
+        const std::string& name)
+{
+    for ( const ProbeSnapshot& snapshot : snapshots )
+    {
+        if ( snapshot.name == name )
+        {
+            return &snapshot;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+TEST(InstrumentationTest, bucketIndex)
+{
+    size_t prev_index = 0;
+    for ( uint64_t latency = 0; latency < 100000; latency += 7 )
+    {
+        const size_t index = Instrumentation::calcBucketIndex(latency);
+        ASSERT_LT(index, Instrumentation::NUM_OF_BUCKETS);
+        EXPECT_GE(index, prev_index);
+        EXPECT_LE(latency, Instrumentation::calcBucketUpperBound(index));
+        if ( index > 0 )
+        {
+            EXPECT_GT(latency, Instrumentation::calcBucketUpperBound(index - 1));
+        }
+        prev_index = index;
+    }
+    EXPECT_EQ(Instrumentation::calcBucketIndex(5), 5u);
+    EXPECT_EQ(Instrumentation::calcBucketIndex(UINT64_MAX),
+              Instrumentation::NUM_OF_BUCKETS - 1);
+    EXPECT_EQ(Instrumentation::calcBucketUpperBound(Instrumentation::NUM_OF_BUCKETS - 1),
+              UINT64_MAX);
+}
+
+TEST(InstrumentationTest, recordAndSnapshot)
+{
+    const size_t probe_id = Instrumentation::registerProbe("InstrumentationTest::record");
+    EXPECT_EQ(Instrumentation::registerProbe("InstrumentationTest::record"), probe_id);
+    EXPECT_LT(probe_id, Instrumentation::MAX_NUM_OF_PROBES);
+
+    /* 4 threads record latencies 1us, 2us, ..., 100us */
+    std::vector<std::thread> threads;
+    for ( size_t t = 0; t < 4; t++ )
+    {
+        threads.push_back(std::thread([probe_id, t]()
+                    {
+                        for ( size_t i = t; i < 100; i += 4 )
+                        {
+                            Instrumentation::record(probe_id, (i + 1) * 1000, 10);
+                        }
+                    }));
+    }
+    for ( std::thread& thread : threads )
+    {
+        thread.join();
+    }
+
+    const std::vector<ProbeSnapshot> snapshots = Instrumentation::takeSnapshot();
+    const ProbeSnapshot* snapshot = findSnapshot(snapshots, "InstrumentationTest::record");
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->num_of_calls, 100u);
+    EXPECT_EQ(snapshot->num_of_elements, 1000u);
+    EXPECT_EQ(snapshot->max_latency_ns, 100000u);
+    EXPECT_NEAR(snapshot->calcMeanLatency(), 50500.0f, 1.0f);
+    EXPECT_GE(snapshot->calcPercentileLatency(50.0f), 50000u);
+    EXPECT_LE(snapshot->calcPercentileLatency(50.0f), 50000u * 1.125f);
+    EXPECT_EQ(snapshot->calcPercentileLatency(100.0f), 100000u);
+
+    const std::vector<std::pair<std::string, std::string>> key_values =
+        Instrumentation::convertToKeyValues({*snapshot});
+    EXPECT_EQ(key_values.size(), 6u);
+    EXPECT_EQ(key_values[0].first, "InstrumentationTest::record/calls");
+    EXPECT_EQ(key_values[0].second, "100");
+
+    /* invalid probes are ignored */
+    Instrumentation::record(Instrumentation::MAX_NUM_OF_PROBES, 1000, 1);
+}
+
+TEST(InstrumentationTest, shortLivedThreads)
+{
+    const size_t probe_id = Instrumentation::registerProbe("InstrumentationTest::threads");
+
+    /* measurements of exited threads are kept */
+    for ( size_t i = 0; i < 200; i++ )
+    {
+        std::thread([probe_id, i]()
+                {
+                    Instrumentation::record(probe_id, (i + 1) * 1000, 1);
+                }).join();
+    }
+    Instrumentation::record(probe_id, 1000, 1);
+
+    const std::vector<ProbeSnapshot> snapshots = Instrumentation::takeSnapshot();
+    const ProbeSnapshot* snapshot = findSnapshot(snapshots, "InstrumentationTest::threads");
+    ASSERT_NE(snapshot, nullptr);
+    EXPECT_EQ(snapshot->num_of_calls, 201u);
+    EXPECT_EQ(snapshot->num_of_elements, 201u);
+    EXPECT_EQ(snapshot->max_latency_ns, 200000u);
+}
+
+TEST(InstrumentationTest, libraryProbes)
+{
+    Polygon2D polygon({Point2D(0.0f, 0.0f), Point2D(1.0f, 0.0f), Point2D(1.0f, 1.0f)});
+    EXPECT_TRUE(polygon.containsPoint(Point2D(0.8f, 0.2f)));
+
+    const std::vector<ProbeSnapshot> snapshots = Instrumentation::takeSnapshot();
+    const ProbeSnapshot* snapshot = findSnapshot(snapshots, "Polygon2D::containsPoint");
+    if ( Instrumentation::isEnabled() )
+    {
+        ASSERT_NE(snapshot, nullptr);
+        EXPECT_GE(snapshot->num_of_calls, 1u);
+        EXPECT_GE(snapshot->num_of_elements, 3u);
+    }
+    else
+    {
+        EXPECT_EQ(snapshot, nullptr);
+    }
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <geometry_common/KDTree.h>
+#include <geometry_common/Utils.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::PointCloud2D;
+using kelo::geometry_common::PointCloud3D;
+using kelo::geometry_common::KDTree2D;
+using kelo::geometry_common::KDTree3D;
+
+PointCloud2D createRandomCloud2D(size_t num_of_points, std::mt19937& generator)
+{
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    PointCloud2D cloud;
+    for ( size_t i = 0; i < num_of_points; i++ )
+    {
+        cloud.push_back(Point2D(position(generator), position(generator)));
+    }
+    return cloud;
+}
+
+std::vector<float> calcSortedSquaredDists(const PointCloud2D& cloud, const Point2D& pt)
+{
+    std::vector<float> squared_dists;
+    for ( const Point2D& p : cloud )
+    {
+        squared_dists.push_back(std::pow(p.x - pt.x, 2) + std::pow(p.y - pt.y, 2));
+    }
+    std::sort(squared_dists.begin(), squared_dists.end());
+    return squared_dists;
+}
+
+TEST(KDTreeTest, nearestNeighbour2D)
+{
+    std::mt19937 generator(1);
+    PointCloud2D cloud = createRandomCloud2D(2000, generator);
+    /* duplicates and points sharing a coordinate */
+    cloud.push_back(cloud[0]);
+    cloud.push_back(Point2D(cloud[1].x, 3.0f));
+    KDTree2D tree(cloud);
+    ASSERT_EQ(tree.size(), cloud.size());
+    for ( size_t i = 0; i < cloud.size(); i++ )
+    {
+        EXPECT_EQ(tree[i], cloud[i]);
+    }
+
+    PointCloud2D queries = createRandomCloud2D(500, generator);
+    for ( const Point2D& query : queries )
+    {
+        size_t index;
+        float squared_dist;
+        ASSERT_TRUE(tree.calcNearestNeighbour(query, index, squared_dist));
+        EXPECT_FLOAT_EQ(squared_dist, calcSortedSquaredDists(cloud, query)[0]);
+        EXPECT_FLOAT_EQ(squared_dist, std::pow(cloud[index].x - query.x, 2) +
+                                      std::pow(cloud[index].y - query.y, 2));
+    }
+
+    std::vector<size_t> indices;
+    std::vector<float> squared_dists;
+    ASSERT_TRUE(tree.calcNearestNeighbours(queries, indices, squared_dists));
+    ASSERT_EQ(indices.size(), queries.size());
+    for ( size_t i = 0; i < queries.size(); i++ )
+    {
+        EXPECT_FLOAT_EQ(squared_dists[i], calcSortedSquaredDists(cloud, queries[i])[0]);
+    }
+
+    KDTree2D empty_tree;
+    size_t index;
+    float squared_dist;
+    EXPECT_FALSE(empty_tree.calcNearestNeighbour(Point2D(), index, squared_dist));
+}
+
+TEST(KDTreeTest, kNearestAndRadius2D)
+{
+    std::mt19937 generator(2);
+    PointCloud2D cloud = createRandomCloud2D(1000, generator);
+    KDTree2D tree(cloud, 4);
+
+    std::vector<size_t> indices;
+    std::vector<float> squared_dists;
+    for ( const Point2D& query : createRandomCloud2D(100, generator) )
+    {
+        std::vector<float> expected = calcSortedSquaredDists(cloud, query);
+
+        tree.calcKNearestNeighbours(query, 10, indices, squared_dists);
+        ASSERT_EQ(indices.size(), 10u);
+        for ( size_t i = 0; i < 10; i++ )
+        {
+            EXPECT_FLOAT_EQ(squared_dists[i], expected[i]);
+        }
+
+        tree.calcNeighboursWithinRadius(query, 1.5f, indices);
+        size_t expected_count = std::upper_bound(expected.begin(), expected.end(),
+                                                 1.5f * 1.5f) - expected.begin();
+        EXPECT_EQ(indices.size(), expected_count);
+        for ( size_t index : indices )
+        {
+            EXPECT_LE(cloud[index].distTo(query), 1.5f + 1e-4f);
+        }
+    }
+
+    /* more neighbours requested than available */
+    tree.calcKNearestNeighbours(Point2D(), 2000, indices, squared_dists);
+    EXPECT_EQ(indices.size(), cloud.size());
+    EXPECT_TRUE(std::is_sorted(squared_dists.begin(), squared_dists.end()));
+}
+
+TEST(KDTreeTest, nearestNeighbour3D)
+{
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> position(-5.0f, 5.0f);
+    PointCloud3D cloud;
+    for ( size_t i = 0; i < 1000; i++ )
+    {
+        cloud.push_back(Point3D(position(generator), position(generator),
+                                position(generator)));
+    }
+    KDTree3D tree(cloud);
+
+    for ( size_t i = 0; i < 200; i++ )
+    {
+        Point3D query(position(generator), position(generator), position(generator));
+        size_t index;
+        float squared_dist;
+        ASSERT_TRUE(tree.calcNearestNeighbour(query, index, squared_dist));
+        EXPECT_EQ(cloud[index], kelo::geometry_common::Utils::calcClosestPoint(cloud, query));
+    }
+}
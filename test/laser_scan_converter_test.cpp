@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include <geometry_common/LaserScanConverter.h>
+#include <geometry_common/Utils.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::PointCloud2D;
+using kelo::geometry_common::PointCloud3D;
+using kelo::geometry_common::Utils;
+using kelo::geometry_common::LaserScanConverter;
+
+TEST(LaserScanConverterTest, convert)
+{
+    sensor_msgs::LaserScan scan;
+    scan.angle_min = -2.0f;
+    scan.angle_increment = 0.01f;
+    scan.range_min = 0.05f;
+    scan.range_max = 20.0f;
+    for ( size_t i = 0; i < 400; i++ )
+    {
+        scan.ranges.push_back(0.5f + (i * 0.05f));
+    }
+    scan.ranges[3] = std::numeric_limits<float>::quiet_NaN();
+    scan.ranges[4] = std::numeric_limits<float>::infinity();
+    scan.ranges[5] = 0.01f;
+
+    LaserScanConverter converter;
+    PointCloud2D cloud;
+    PointCloud3D cloud_3d;
+    std::vector<float> xs, ys;
+    std::vector<size_t> beam_indices;
+    for ( size_t iteration = 0; iteration < 2; iteration++ )
+    {
+        PointCloud2D expected_cloud = Utils::convertToPointCloud<Point2D>(scan);
+        converter.convert(scan, cloud);
+        converter.convert(scan, cloud_3d);
+        converter.convert(scan, xs, ys, beam_indices);
+        ASSERT_EQ(cloud.size(), expected_cloud.size());
+        ASSERT_EQ(cloud_3d.size(), expected_cloud.size());
+        ASSERT_EQ(xs.size(), expected_cloud.size());
+        for ( size_t i = 0; i < cloud.size(); i++ )
+        {
+            EXPECT_EQ(cloud[i], expected_cloud[i]);
+            EXPECT_EQ(cloud_3d[i], Point3D(expected_cloud[i].x, expected_cloud[i].y, 0.0f));
+            EXPECT_EQ(Point2D(xs[i], ys[i]), expected_cloud[i]);
+            const float angle = scan.angle_min + (beam_indices[i] * scan.angle_increment);
+            EXPECT_NEAR(Utils::calcShortestAngle(angle, expected_cloud[i].angle()),
+                        0.0f, 1e-4f);
+        }
+
+        /* beam directions have to be updated */
+        scan.angle_min = 1.0f;
+        scan.ranges.resize(300);
+    }
+    EXPECT_EQ(beam_indices.front(), 0u);
+    EXPECT_EQ(beam_indices[3], 6u);
+}
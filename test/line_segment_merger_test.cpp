@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <geometry_common/LineSegmentMerger.h>
+#include <geometry_common/Utils.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::LineSegment2D;
+using kelo::geometry_common::LineSegmentMerger;
+using kelo::geometry_common::Utils;
+
+/* quadratic reference implementation of mergeCloseLinesBF */
+void mergeCloseLinesReference(std::vector<LineSegment2D>& line_segments,
+                              float distance_threshold, float angle_threshold)
+{
+    for ( size_t skip_index = 1; skip_index < line_segments.size(); skip_index++ )
+    {
+        size_t i = 0;
+        while ( i + skip_index < line_segments.size() )
+        {
+            LineSegment2D& a = line_segments[i];
+            const LineSegment2D& b = line_segments[i+skip_index];
+            if ( std::fabs(Utils::calcShortestAngle(a.angle(), b.angle())) < angle_threshold )
+            {
+                if ( a.end.distTo(b.start) < distance_threshold )
+                {
+                    a.end = b.end;
+                    line_segments.erase(line_segments.begin() + i + skip_index);
+                    continue;
+                }
+                if ( b.end.distTo(a.start) < distance_threshold )
+                {
+                    a.start = b.start;
+                    line_segments.erase(line_segments.begin() + i + skip_index);
+                    continue;
+                }
+            }
+            i++;
+        }
+    }
+}
+
+/* quadratic reference implementation of mergeCoLinearLines */
+void mergeCoLinearLinesReference(std::vector<LineSegment2D>& line_segments,
+                                 float distance_threshold, float angle_threshold,
+                                 float perp_dist_threshold)
+{
+    bool merged_lines = true;
+    while ( merged_lines )
+    {
+        merged_lines = false;
+        for ( size_t i = 0; i < line_segments.size() && !merged_lines; i++ )
+        {
+            for ( size_t j = 0; j < line_segments.size(); j++ )
+            {
+                const LineSegment2D& a = line_segments[i];
+                const LineSegment2D& b = line_segments[j];
+                if ( i != j &&
+                     a.end.distTo(b.start) < distance_threshold &&
+                     std::fabs(Utils::calcShortestAngle(a.angle(), b.angle())) < angle_threshold &&
+                     Utils::calcProjectedPointOnLine(a.start, a.end, b.start, false).distTo(b.start) < perp_dist_threshold &&
+                     Utils::calcProjectedPointOnLine(a.start, a.end, b.end, false).distTo(b.end) < perp_dist_threshold )
+                {
+                    line_segments[i].end = b.end;
+                    line_segments.erase(line_segments.begin() + j);
+                    merged_lines = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/* noisy polylines cut into segments and shuffled */
+std::vector<LineSegment2D> createRandomWalls(size_t num_of_segments, std::mt19937& generator)
+{
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    std::vector<LineSegment2D> segments;
+    Point2D start;
+    float angle = 0.0f;
+    for ( size_t i = 0; i < num_of_segments; i++ )
+    {
+        if ( i % 20 == 0 )
+        {
+            start = Point2D(5.0f * noise(generator), 5.0f * noise(generator));
+            angle = M_PI * noise(generator);
+        }
+        angle += 0.15f * noise(generator);
+        Point2D end = start + Point2D::initFromRadialCoord(0.1f + 0.3f * std::fabs(noise(generator)), angle);
+        segments.push_back(LineSegment2D(start, end));
+        start = end + Point2D(0.1f * noise(generator), 0.1f * noise(generator));
+    }
+    std::shuffle(segments.begin(), segments.end(), generator);
+    return segments;
+}
+
+void expectEqual(const std::vector<LineSegment2D>& a, const std::vector<LineSegment2D>& b)
+{
+    ASSERT_EQ(a.size(), b.size());
+    for ( size_t i = 0; i < a.size(); i++ )
+    {
+        EXPECT_EQ(a[i].start.x, b[i].start.x);
+        EXPECT_EQ(a[i].start.y, b[i].start.y);
+        EXPECT_EQ(a[i].end.x, b[i].end.x);
+        EXPECT_EQ(a[i].end.y, b[i].end.y);
+    }
+}
+
+TEST(LineSegmentMergerTest, mergeCloseLines)
+{
+    std::mt19937 generator(3);
+    LineSegmentMerger merger(0.2f, 0.2f);
+    for ( size_t i = 0; i < 50; i++ )
+    {
+        std::vector<LineSegment2D> segments = createRandomWalls(2 + i * 4, generator);
+        std::vector<LineSegment2D> expected = segments;
+        mergeCloseLinesReference(expected, 0.2f, 0.2f);
+        merger.mergeCloseLines(segments);
+        expectEqual(segments, expected);
+    }
+}
+
+TEST(LineSegmentMergerTest, mergeCoLinearLines)
+{
+    std::mt19937 generator(4);
+    for ( size_t i = 0; i < 50; i++ )
+    {
+        std::vector<LineSegment2D> segments = createRandomWalls(2 + i * 4, generator);
+        std::vector<LineSegment2D> expected = segments;
+        mergeCoLinearLinesReference(expected, 0.2f, 0.3f, 0.1f);
+        Utils::mergeCoLinearLines(segments, 0.2f, 0.3f, 0.1f);
+        expectEqual(segments, expected);
+    }
+
+    /* collinear chain given in reverse order */
+    std::vector<LineSegment2D> chain;
+    for ( size_t i = 5; i > 0; i-- )
+    {
+        chain.push_back(LineSegment2D(Point2D(i - 1, 0.0f), Point2D(i, 0.0f)));
+    }
+    Utils::mergeCoLinearLines(chain);
+    ASSERT_EQ(chain.size(), 1u);
+    EXPECT_EQ(chain[0].start, Point2D(0.0f, 0.0f));
+    EXPECT_EQ(chain[0].end, Point2D(5.0f, 0.0f));
+}
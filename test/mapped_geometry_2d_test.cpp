@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include <geometry_common/BVH2D.h>
+#include <geometry_common/MappedGeometry2D.h>
+
+using kelo::geometry_common::Box2D;
+using kelo::geometry_common::BVH2D;
+using kelo::geometry_common::LineSegment2D;
+using kelo::geometry_common::MappedGeometry2D;
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::Polyline2D;
+
+class MappedGeometry2DTest : public ::testing::Test
+{
+    protected:
+        std::vector<Polygon2D> polygons_;
+        std::vector<Polyline2D> polylines_;
+        std::vector<LineSegment2D> line_segments_;
+        std::string file_path_{"mapped_geometry_2d_test.bin"};
+
+        void SetUp() override
+        {
+            std::mt19937 gen(7);
+            std::uniform_real_distribution<float> pos(-50.0f, 50.0f);
+            std::uniform_real_distribution<float> size(0.5f, 3.0f);
+            for ( size_t i = 0; i < 200; i++ )
+            {
+                const float x = pos(gen), y = pos(gen);
+                const float w = size(gen), h = size(gen);
+                polygons_.push_back(Polygon2D({Point2D(x, y), Point2D(x + w, y),
+                                               Point2D(x + w, y + h),
+                                               Point2D(x, y + h)}));
+                polylines_.push_back(Polyline2D({Point2D(y, x), Point2D(y + w, x),
+                                                 Point2D(y + w, x + h)}));
+                line_segments_.push_back(LineSegment2D(Point2D(x, -y),
+                                                       Point2D(x + h, -y - w)));
+            }
+        }
+
+        void TearDown() override
+        {
+            std::remove(file_path_.c_str());
+        }
+};
+
+TEST_F(MappedGeometry2DTest, roundTrip)
+{
+    ASSERT_TRUE(MappedGeometry2D::write(file_path_, polygons_, polylines_,
+                                        line_segments_));
+    MappedGeometry2D geometry;
+    ASSERT_TRUE(geometry.open(file_path_));
+    EXPECT_TRUE(geometry.isOpen());
+    ASSERT_EQ(geometry.numOfPolygons(), polygons_.size());
+    ASSERT_EQ(geometry.numOfPolylines(), polylines_.size());
+    ASSERT_EQ(geometry.numOfLineSegments(), line_segments_.size());
+    for ( size_t i = 0; i < polygons_.size(); i++ )
+    {
+        const MappedGeometry2D::VertexView polygon = geometry.polygon(i);
+        ASSERT_EQ(polygon.size(), polygons_[i].vertices.size());
+        EXPECT_EQ(polygon[2], polygons_[i].vertices[2]);
+        EXPECT_EQ(geometry.polyline(i)[1], polylines_[i].vertices[1]);
+        EXPECT_EQ(geometry.lineSegment(i), line_segments_[i]);
+    }
+}
+
+TEST_F(MappedGeometry2DTest, queries)
+{
+    ASSERT_TRUE(MappedGeometry2D::write(file_path_, polygons_, polylines_,
+                                        line_segments_));
+    MappedGeometry2D geometry;
+    ASSERT_TRUE(geometry.open(file_path_));
+
+    const BVH2D<Polygon2D> polygon_bvh(polygons_);
+    const BVH2D<Polyline2D> polyline_bvh(polylines_);
+    const BVH2D<LineSegment2D> line_segment_bvh(line_segments_);
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> pos(-55.0f, 55.0f);
+    std::vector<size_t> indices, expected_indices;
+    std::vector<size_t> polyline_indices, line_segment_indices;
+    for ( size_t i = 0; i < 200; i++ )
+    {
+        const Point2D point(pos(gen), pos(gen));
+        geometry.calcPolygonsContaining(point, indices);
+        polygon_bvh.calcIndicesContaining(point, expected_indices);
+        std::sort(indices.begin(), indices.end());
+        std::sort(expected_indices.begin(), expected_indices.end());
+        EXPECT_EQ(indices, expected_indices);
+
+        const LineSegment2D line_segment(point, Point2D(pos(gen), pos(gen)) * 0.1f);
+        EXPECT_EQ(geometry.intersects(line_segment),
+                  polygon_bvh.intersects(line_segment) ||
+                  polyline_bvh.intersects(line_segment) ||
+                  line_segment_bvh.intersects(line_segment));
+
+        const Box2D box(point.x, point.x + 5.0f, point.y, point.y + 5.0f);
+        geometry.calcIndicesOverlapping(box, indices, polyline_indices,
+                                        line_segment_indices);
+        polygon_bvh.calcIndicesOverlapping(box, expected_indices);
+        EXPECT_EQ(indices.size(), expected_indices.size());
+        line_segment_bvh.calcIndicesOverlapping(box, expected_indices);
+        EXPECT_EQ(line_segment_indices.size(), expected_indices.size());
+    }
+}
+
+TEST_F(MappedGeometry2DTest, invalidFiles)
+{
+    MappedGeometry2D geometry;
+    EXPECT_FALSE(geometry.open("non_existent_file.bin"));
+    EXPECT_FALSE(geometry.isOpen());
+
+    ASSERT_TRUE(MappedGeometry2D::write(file_path_, polygons_));
+    std::string content;
+    {
+        std::ifstream file(file_path_, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file),
+                       std::istreambuf_iterator<char>());
+    }
+
+    /* truncated file */
+    {
+        std::ofstream file(file_path_, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), content.size() - 4);
+    }
+    EXPECT_FALSE(geometry.open(file_path_));
+
+    /* corrupted node referring to itself */
+    std::string corrupted_content = content;
+    const size_t nodes_offset = *reinterpret_cast<const uint32_t*>(&content[12 + 20]);
+    const uint32_t self_index = 0;
+    std::memcpy(&corrupted_content[nodes_offset + 16], &self_index, sizeof(self_index));
+    std::memset(&corrupted_content[nodes_offset + 20], 0, sizeof(uint32_t));
+    {
+        std::ofstream file(file_path_, std::ios::binary | std::ios::trunc);
+        file.write(corrupted_content.data(), corrupted_content.size());
+    }
+    EXPECT_FALSE(geometry.open(file_path_));
+
+    {
+        std::ofstream file(file_path_, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), content.size());
+    }
+    EXPECT_TRUE(geometry.open(file_path_));
+
+    /* line segment record without vertices */
+    {
+        ASSERT_TRUE(MappedGeometry2D::write(file_path_, {}, {}, line_segments_));
+        std::ifstream file(file_path_, std::ios::binary);
+        corrupted_content.assign(std::istreambuf_iterator<char>(file),
+                                 std::istreambuf_iterator<char>());
+    }
+    const size_t line_segments_section = 12 + (2 * 28);
+    const uint32_t shapes_offset = *reinterpret_cast<const uint32_t*>(
+            &corrupted_content[line_segments_section + 4]);
+    const uint32_t num_of_points = *reinterpret_cast<const uint32_t*>(
+            &corrupted_content[line_segments_section + 8]);
+    const uint32_t empty_record[2] = {num_of_points, 0};
+    std::memcpy(&corrupted_content[shapes_offset], empty_record, sizeof(empty_record));
+    {
+        std::ofstream file(file_path_, std::ios::binary | std::ios::trunc);
+        file.write(corrupted_content.data(), corrupted_content.size());
+    }
+    EXPECT_FALSE(geometry.open(file_path_));
+    EXPECT_FALSE(MappedGeometry2D::write(file_path_, {Polygon2D()}));
+
+    {
+        std::ofstream file(file_path_, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), content.size());
+    }
+    EXPECT_TRUE(geometry.open(file_path_));
+    EXPECT_EQ(geometry.numOfPolygons(), polygons_.size());
+    EXPECT_EQ(geometry.numOfLineSegments(), 0u);
+    geometry.close();
+    EXPECT_FALSE(geometry.isOpen());
+    EXPECT_EQ(geometry.numOfPolygons(), 0u);
+}
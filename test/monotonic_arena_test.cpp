@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <cstdint>
+#include <random>
+#include <gtest/gtest.h>
+#include <geometry_common/MonotonicArena.h>
+#include <geometry_common/Polygon2D.h>
+#include <geometry_common/Utils.h>
+
+using kelo::geometry_common::MonotonicArena;
+using kelo::geometry_common::ArenaScope;
+using kelo::geometry_common::ArenaAllocator;
+using kelo::geometry_common::ArenaVector;
+using kelo::geometry_common::Utils;
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::PointCloud2D;
+using kelo::geometry_common::PointArrayView2D;
+using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::LineSegment2D;
+
+TEST(MonotonicArenaTest, allocate)
+{
+    MonotonicArena arena(128);
+    EXPECT_EQ(arena.bytesReserved(), 0u);
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    void* c = arena.allocate(16, 16);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(b) % 8, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(c) % 16, 0u);
+    EXPECT_LT(static_cast<char*>(a), static_cast<char*>(b));
+    EXPECT_EQ(arena.bytesReserved(), 128u);
+
+    /* exceeding the first block adds a larger one */
+    void* d = arena.allocate(1000);
+    EXPECT_NE(d, nullptr);
+    EXPECT_GE(arena.bytesReserved(), 128u + 1000u);
+    EXPECT_GE(arena.bytesUsed(), 3u + 8u + 16u + 1000u);
+
+    /* reset merges all blocks into one */
+    const size_t reserved = arena.bytesReserved();
+    arena.reset();
+    EXPECT_EQ(arena.bytesUsed(), 0u);
+    EXPECT_EQ(arena.bytesReserved(), reserved);
+    arena.allocate(1000);
+    arena.allocate(100);
+    EXPECT_EQ(arena.bytesReserved(), reserved);
+
+    arena.release();
+    EXPECT_EQ(arena.bytesReserved(), 0u);
+}
+
+TEST(MonotonicArenaTest, scope)
+{
+    EXPECT_EQ(MonotonicArena::current(), nullptr);
+    MonotonicArena outer_arena, inner_arena;
+    {
+        ArenaScope outer_scope(outer_arena);
+        EXPECT_EQ(MonotonicArena::current(), &outer_arena);
+        {
+            ArenaScope inner_scope(inner_arena);
+            EXPECT_EQ(MonotonicArena::current(), &inner_arena);
+            ArenaVector<int> values;
+            EXPECT_EQ(values.get_allocator().arena(), &inner_arena);
+            for ( int i = 0; i < 100; i++ )
+            {
+                values.push_back(i);
+            }
+            EXPECT_EQ(values[99], 99);
+            EXPECT_GE(inner_arena.bytesUsed(), 100 * sizeof(int));
+        }
+        EXPECT_EQ(MonotonicArena::current(), &outer_arena);
+    }
+    EXPECT_EQ(MonotonicArena::current(), nullptr);
+
+    /* without arena the allocator falls back to the heap */
+    ArenaVector<int> heap_values(10, 1);
+    EXPECT_EQ(heap_values.get_allocator().arena(), nullptr);
+    EXPECT_EQ(heap_values[9], 1);
+}
+
+TEST(MonotonicArenaTest, algorithmsInScope)
+{
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> dist(-5.0f, 5.0f);
+    PointCloud2D points;
+    for ( size_t i = 0; i < 200; i++ )
+    {
+        points.push_back(Point2D(dist(gen), dist(gen)));
+    }
+    PointCloud2D ordered_points;
+    for ( size_t i = 0; i < 50; i++ )
+    {
+        ordered_points.push_back(Point2D(0.1f * i, ( i < 25 ) ? 0.0f : 0.1f * (i - 25)));
+    }
+    Polygon2D polygon_a({Point2D(0.0f, 0.0f), Point2D(1.0f, 0.0f), Point2D(1.0f, 1.0f)});
+    Polygon2D polygon_b({Point2D(2.0f, 0.0f), Point2D(3.0f, 1.0f), Point2D(2.0f, 2.0f)});
+
+    const std::vector<std::vector<size_t>> expected_clusters = Utils::clusterPointIndices(
+            PointArrayView2D<Point2D>(points), 0.8f, 2);
+    const std::vector<PointCloud2D> expected_ordered_clusters =
+        Utils::clusterOrderedPoints(ordered_points, 0.2f, 2);
+    const std::vector<LineSegment2D> expected_segments =
+        Utils::applyPiecewiseRegression(ordered_points, 0.1f);
+    const Polygon2D expected_hull = Polygon2D::calcConvexHullOfPolygons(polygon_a, polygon_b);
+
+    MonotonicArena arena(256);
+    for ( size_t cycle = 0; cycle < 3; cycle++ )
+    {
+        ArenaScope scope(arena);
+        EXPECT_EQ(Utils::clusterPointIndices(PointArrayView2D<Point2D>(points), 0.8f, 2),
+                  expected_clusters);
+        const std::vector<PointCloud2D> ordered_clusters =
+            Utils::clusterOrderedPoints(ordered_points, 0.2f, 2);
+        ASSERT_EQ(ordered_clusters.size(), expected_ordered_clusters.size());
+        for ( size_t i = 0; i < ordered_clusters.size(); i++ )
+        {
+            EXPECT_EQ(ordered_clusters[i], expected_ordered_clusters[i]);
+        }
+        EXPECT_EQ(Utils::applyPiecewiseRegression(ordered_points, 0.1f), expected_segments);
+        EXPECT_EQ(Polygon2D::calcConvexHullOfPolygons(polygon_a, polygon_b).vertices,
+                  expected_hull.vertices);
+        EXPECT_GT(arena.bytesUsed(), 0u);
+        arena.reset();
+    }
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <geometry_common/PathIndex2D.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Pose2D;
+using kelo::geometry_common::Path;
+using kelo::geometry_common::Polyline2D;
+using kelo::geometry_common::LineSegment2D;
+using kelo::geometry_common::PathIndex2D;
+using kelo::geometry_common::PathProjection2D;
+
+TEST(PathIndex2DTest, calcPoseAt)
+{
+    Path path{Pose2D(0.0f, 0.0f, 0.0f), Pose2D(2.0f, 0.0f, 0.0f),
+              Pose2D(2.0f, 0.0f, M_PI/2), Pose2D(2.0f, 3.0f, M_PI/2)};
+    PathIndex2D path_index(path);
+    EXPECT_EQ(path_index.size(), 4u);
+    EXPECT_FLOAT_EQ(path_index.length(), 5.0f);
+
+    Pose2D pose;
+    EXPECT_TRUE(path_index.calcPoseAt(1.0f, pose));
+    EXPECT_EQ(pose, Pose2D(1.0f, 0.0f, 0.0f));
+    EXPECT_TRUE(path_index.calcPoseAt(3.5f, pose));
+    EXPECT_EQ(pose, Pose2D(2.0f, 1.5f, M_PI/2));
+    EXPECT_TRUE(path_index.calcPoseAt(-1.0f, pose));
+    EXPECT_EQ(pose, path.front());
+    EXPECT_TRUE(path_index.calcPoseAt(10.0f, pose));
+    EXPECT_EQ(pose, path.back());
+
+    Polyline2D polyline;
+    polyline.vertices = {Point2D(0.0f, 0.0f), Point2D(0.0f, 2.0f), Point2D(-2.0f, 2.0f)};
+    path_index.build(polyline);
+    EXPECT_TRUE(path_index.calcPoseAt(1.0f, pose));
+    EXPECT_EQ(pose, Pose2D(0.0f, 1.0f, M_PI/2));
+    EXPECT_TRUE(path_index.calcPoseAt(2.5f, pose));
+    EXPECT_EQ(pose, Pose2D(-0.5f, 2.0f, M_PI));
+
+    Point2D point;
+    path_index.build(Path());
+    EXPECT_FALSE(path_index.calcPointAt(0.0f, point));
+    PathProjection2D projection;
+    EXPECT_FALSE(path_index.calcProjection(point, projection));
+}
+
+TEST(PathIndex2DTest, calcProjection)
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> step_dist(-0.5f, 0.5f);
+    Path path{Pose2D()};
+    for ( size_t i = 0; i < 2000; i++ )
+    {
+        path.push_back(Pose2D(path.back().x + 0.1f + std::fabs(step_dist(gen)),
+                              path.back().y + step_dist(gen), 0.0f));
+    }
+    PathIndex2D path_index(path);
+
+    std::uniform_real_distribution<float> x_dist(0.0f, path.back().x);
+    std::uniform_real_distribution<float> y_dist(-10.0f, 10.0f);
+    for ( size_t i = 0; i < 200; i++ )
+    {
+        const Point2D point(x_dist(gen), y_dist(gen));
+        float expected_dist = std::numeric_limits<float>::max();
+        for ( size_t j = 0; j+1 < path.size(); j++ )
+        {
+            expected_dist = std::min(expected_dist, LineSegment2D(
+                        Point2D(path[j].x, path[j].y),
+                        Point2D(path[j+1].x, path[j+1].y)).minDistTo(point));
+        }
+        PathProjection2D projection;
+        EXPECT_TRUE(path_index.calcProjection(point, projection));
+        EXPECT_NEAR(projection.dist, expected_dist, 1e-4f);
+        EXPECT_NEAR(projection.dist, projection.point.distTo(point), 1e-4f);
+        Point2D point_at_arc_length;
+        EXPECT_TRUE(path_index.calcPointAt(projection.arc_length, point_at_arc_length));
+        EXPECT_EQ(point_at_arc_length, projection.point);
+    }
+
+    /* track a robot driving along the path with warm started projections */
+    PathProjection2D projection;
+    EXPECT_TRUE(path_index.calcProjection(Point2D(0.0f, 0.5f), projection));
+    for ( float arc_length = 0.0f; arc_length < path_index.length(); arc_length += 0.05f )
+    {
+        Pose2D pose;
+        path_index.calcPoseAt(arc_length, pose);
+        const Point2D robot(pose.x, pose.y + 0.01f);
+        PathProjection2D local_projection, global_projection;
+        EXPECT_TRUE(path_index.calcProjection(robot, projection, 1.0f, 0.5f,
+                                              local_projection));
+        EXPECT_TRUE(path_index.calcProjection(robot, global_projection));
+        EXPECT_NEAR(local_projection.dist, global_projection.dist, 1e-4f);
+        projection = local_projection;
+    }
+}
+
+TEST(PathIndex2DTest, resample)
+{
+    Path path{Pose2D(0.0f, 0.0f, 0.0f), Pose2D(1.0f, 0.0f, 0.0f),
+              Pose2D(1.0f, 0.0f, 0.0f), Pose2D(1.0f, 1.05f, M_PI/2)};
+    PathIndex2D path_index(path);
+    Path resampled_path;
+    path_index.resample(0.25f, resampled_path);
+    ASSERT_EQ(resampled_path.size(), 10u);
+    for ( size_t i = 0; i+1 < resampled_path.size(); i++ )
+    {
+        Pose2D expected_pose;
+        path_index.calcPoseAt(i * 0.25f, expected_pose);
+        EXPECT_EQ(resampled_path[i], expected_pose);
+    }
+    EXPECT_EQ(resampled_path[4], Pose2D(1.0f, 0.0f, 0.0f));
+    EXPECT_EQ(resampled_path.back(), path.back());
+}
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <geometry_msgs/Polygon.h>
+#include <geometry_msgs/PoseStamped.h>
+
+#include <geometry_common/PointArrayView2D.h>
+#include <geometry_common/Polygon2D.h>
+#include <geometry_common/Utils.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::Pose2D;
+using kelo::geometry_common::PackedPoint2D;
+using kelo::geometry_common::PointCloud2D;
+using kelo::geometry_common::PointArrayView2D;
+using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::Utils;
+
+TEST(PointArrayView2DTest, access)
+{
+    nav_msgs::Path path;
+    for ( size_t i = 0; i < 5; i++ )
+    {
+        geometry_msgs::PoseStamped pose;
+        pose.pose.position.x = i;
+        pose.pose.position.y = -2.0 * i;
+        path.poses.push_back(pose);
+    }
+    PointArrayView2D<geometry_msgs::PoseStamped> view(path.poses);
+    ASSERT_EQ(view.size(), path.poses.size());
+    EXPECT_FALSE(view.empty());
+    EXPECT_EQ(view.data(), path.poses.data());
+    EXPECT_FLOAT_EQ(view.x(3), 3.0f);
+    EXPECT_FLOAT_EQ(view.y(3), -6.0f);
+    EXPECT_EQ(view[4], Point2D(4.0f, -8.0f));
+    EXPECT_TRUE(PointArrayView2D<Point2D>().empty());
+}
+
+TEST(PointArrayView2DTest, isPointInPolygon)
+{
+    geometry_msgs::Polygon polygon_msg;
+    Polygon2D polygon;
+    const float xs[5] = {0.0f, 2.0f, 2.0f, 1.0f, 0.0f};
+    const float ys[5] = {0.0f, 0.0f, 2.0f, 1.0f, 2.0f};
+    for ( size_t i = 0; i < 5; i++ )
+    {
+        geometry_msgs::Point32 pt;
+        pt.x = xs[i];
+        pt.y = ys[i];
+        polygon_msg.points.push_back(pt);
+        polygon.vertices.push_back(Point2D(xs[i], ys[i]));
+    }
+
+    PointArrayView2D<geometry_msgs::Point32> view(polygon_msg.points);
+    for ( float x = -0.55f; x < 2.5f; x += 0.1f )
+    {
+        for ( float y = -0.55f; y < 2.5f; y += 0.1f )
+        {
+            EXPECT_EQ(Utils::isPointInPolygon(view, Point2D(x, y)),
+                      polygon.containsPoint(Point2D(x, y)));
+        }
+    }
+    EXPECT_TRUE(Utils::isPointInPolygon(view, Point2D(0.2f, 1.5f)));
+    EXPECT_FALSE(Utils::isPointInPolygon(view, Point2D(1.0f, 1.5f)));
+}
+
+TEST(PointArrayView2DTest, clusterPointIndices)
+{
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dist(-5.0f, 5.0f);
+    sensor_msgs::PointCloud cloud_msg;
+    PointCloud2D points;
+    for ( size_t i = 0; i < 300; i++ )
+    {
+        geometry_msgs::Point32 pt;
+        pt.x = dist(gen);
+        pt.y = dist(gen);
+        cloud_msg.points.push_back(pt);
+        points.push_back(Point2D(pt));
+    }
+
+    const std::vector<PointCloud2D> clusters = Utils::clusterPoints(points, 0.5f, 3);
+    const std::vector<std::vector<size_t>> index_clusters = Utils::clusterPointIndices(
+            PointArrayView2D<geometry_msgs::Point32>(cloud_msg.points), 0.5f, 3);
+    ASSERT_GT(clusters.size(), 1u);
+    ASSERT_EQ(index_clusters.size(), clusters.size());
+    for ( size_t i = 0; i < clusters.size(); i++ )
+    {
+        ASSERT_EQ(index_clusters[i].size(), clusters[i].size());
+        for ( size_t j = 0; j < clusters[i].size(); j++ )
+        {
+            EXPECT_EQ(points[index_clusters[i][j]], clusters[i][j]);
+        }
+    }
+}
+
+namespace
+{
+
+template <typename T>
+void expectSameResults(
+        const std::vector<T>& elements,
+        const PointCloud2D& points)
+{
+    const PointArrayView2D<T> view(elements);
+    const PointArrayView2D<Point2D> reference_view(points);
+    EXPECT_EQ(Utils::clusterPointIndices(view, 1.5f, 1),
+              Utils::clusterPointIndices(reference_view, 1.5f, 1));
+    EXPECT_EQ(Utils::isPointInPolygon(view, Point2D(0.2f, 0.1f)),
+              Utils::isPointInPolygon(reference_view, Point2D(0.2f, 0.1f)));
+    std::vector<size_t> indices, reference_indices;
+    Utils::calcIndicesInPolygon(view, points, indices);
+    Utils::calcIndicesInPolygon(reference_view, points, reference_indices);
+    EXPECT_EQ(indices, reference_indices);
+}
+
+} // namespace
+
+TEST(PointArrayView2DTest, allElementTypes)
+{
+    /* every documented element type is available for every algorithm */
+    const PointCloud2D points{Point2D(0.0f, 0.0f), Point2D(1.0f, 0.0f),
+                              Point2D(1.0f, 1.0f), Point2D(0.0f, 1.0f)};
+    std::vector<Point3D> points_3d;
+    std::vector<Pose2D> poses_2d;
+    std::vector<PackedPoint2D> packed_points;
+    std::vector<geometry_msgs::Point> point_msgs;
+    std::vector<geometry_msgs::Point32> point32_msgs;
+    std::vector<geometry_msgs::Pose> pose_msgs;
+    std::vector<geometry_msgs::PoseStamped> pose_stamped_msgs;
+    for ( const Point2D& pt : points )
+    {
+        points_3d.push_back(Point3D(pt.x, pt.y, 2.0f));
+        poses_2d.push_back(Pose2D(pt.x, pt.y, 0.5f));
+        packed_points.push_back(PackedPoint2D{pt.x, pt.y});
+        point_msgs.push_back(pt.asPoint());
+        point32_msgs.push_back(pt.asPoint32());
+        geometry_msgs::PoseStamped pose_stamped_msg;
+        pose_stamped_msg.pose.position = pt.asPoint();
+        pose_msgs.push_back(pose_stamped_msg.pose);
+        pose_stamped_msgs.push_back(pose_stamped_msg);
+    }
+
+    expectSameResults(points, points);
+    expectSameResults(points_3d, points);
+    expectSameResults(poses_2d, points);
+    expectSameResults(packed_points, points);
+    expectSameResults(point_msgs, points);
+    expectSameResults(point32_msgs, points);
+    expectSameResults(pose_msgs, points);
+    expectSameResults(pose_stamped_msgs, points);
+}
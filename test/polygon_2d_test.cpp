@@ -1,11 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <vector>
 
 #include <geometry_common/Polygon2D.h>
 
 using kelo::geometry_common::Point2D;
 using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::WindingOrder;
 
 TEST(Polygon2DTest, isConvex)
 {
@@ -87,6 +89,101 @@ TEST(Polygon2DTest, isApproximatelyConvex)
     EXPECT_EQ(concave_polygon.isApproximatelyConvex(), false);
 }
 
+TEST(Polygon2DTest, calcConvexity)
+{
+    WindingOrder winding_order;
+    Polygon2D circle;
+    for ( size_t i = 0; i < 1000; i++ )
+    {
+        circle.vertices.push_back(Point2D::initFromRadialCoord(5.0f, i * 2 * M_PI / 1000));
+    }
+    EXPECT_TRUE(circle.calcConvexity(winding_order));
+    EXPECT_EQ(winding_order, WindingOrder::COUNTER_CLOCKWISE);
+
+    std::reverse(circle.vertices.begin(), circle.vertices.end());
+    EXPECT_TRUE(circle.calcConvexity(winding_order));
+    EXPECT_EQ(winding_order, WindingOrder::CLOCKWISE);
+
+    /* small dent is only ignored with tolerance */
+    circle[500] = circle[500] * 0.9999f;
+    EXPECT_FALSE(circle.calcConvexity(winding_order));
+    EXPECT_TRUE(circle.calcConvexity(winding_order, 0.05f));
+
+    /* collinear vertices along an edge */
+    Polygon2D rectangle(
+    {
+        Point2D(0.0f, 0.0f),
+        Point2D(1.0f, 0.0f),
+        Point2D(2.0f, 0.0f),
+        Point2D(2.0f, 1.0f),
+        Point2D(0.0f, 1.0f)
+    });
+    EXPECT_TRUE(rectangle.calcConvexity(winding_order));
+    EXPECT_EQ(winding_order, WindingOrder::COUNTER_CLOCKWISE);
+
+    /* pentagram turns consistently but intersects itself */
+    Polygon2D pentagram;
+    for ( size_t i = 0; i < 5; i++ )
+    {
+        pentagram.vertices.push_back(Point2D::initFromRadialCoord(1.0f, i * 4 * M_PI / 5));
+    }
+    EXPECT_FALSE(pentagram.calcConvexity(winding_order));
+    EXPECT_FALSE(pentagram.isApproximatelyConvex());
+
+    /* spike going back along the previous edge */
+    Polygon2D spike(
+    {
+        Point2D(0.0f, 0.0f),
+        Point2D(2.0f, 0.0f),
+        Point2D(1.0f, 0.0f),
+        Point2D(1.0f, 1.0f)
+    });
+    EXPECT_FALSE(spike.isConvex());
+    EXPECT_FALSE(spike.isApproximatelyConvex());
+}
+
+TEST(Polygon2DTest, closedRingConvexity)
+{
+    WindingOrder winding_order;
+    Polygon2D closed_square(
+    {
+        Point2D(0.0f, 0.0f),
+        Point2D(1.0f, 0.0f),
+        Point2D(1.0f, 1.0f),
+        Point2D(0.0f, 1.0f),
+        Point2D(0.0f, 0.0f)     // first vertex repeated at the end
+    });
+    EXPECT_TRUE(closed_square.isConvex());
+    EXPECT_TRUE(closed_square.isApproximatelyConvex());
+    EXPECT_TRUE(closed_square.isApproximatelyConvex(0.0f));
+    EXPECT_TRUE(closed_square.calcConvexity(winding_order));
+    EXPECT_EQ(winding_order, WindingOrder::COUNTER_CLOCKWISE);
+
+    Polygon2D closed_concave(
+    {
+        Point2D(0.0f, 0.0f),
+        Point2D(2.0f, 0.0f),
+        Point2D(1.0f, 0.5f),
+        Point2D(2.0f, 2.0f),
+        Point2D(0.0f, 2.0f),
+        Point2D(0.0f, 0.0f)
+    });
+    EXPECT_FALSE(closed_concave.isConvex());
+    EXPECT_FALSE(closed_concave.isApproximatelyConvex());
+
+    /* interior repeats are ignored by isApproximatelyConvex for any tolerance */
+    Polygon2D repeated_points_polygon(
+    {
+        Point2D(0.0f, 0.0f),
+        Point2D(1.0f, 0.0f),
+        Point2D(1.0f, 0.0f),
+        Point2D(1.0f, 1.0f),
+        Point2D(0.0f, 1.0f)
+    });
+    EXPECT_FALSE(repeated_points_polygon.isConvex());
+    EXPECT_TRUE(repeated_points_polygon.isApproximatelyConvex(0.0f));
+}
+
 TEST(Polygon2DTest, calcConvexHullOfPolygons)
 {
     Polygon2D polygon_a(
@@ -145,3 +242,76 @@ TEST(Polygon2DTest, calcInflatedPolygon)
     EXPECT_EQ(inflated_polygon2[2], Point2D( 4.073f,  4.121f));
     EXPECT_EQ(inflated_polygon2[3], Point2D(-0.1f,  3.078f));
 }
+
+TEST(Polygon2DTest, centroid)
+{
+    /* extra collinear vertices shift the mean point but not the centroid */
+    Polygon2D polygon(
+    {
+        Point2D(0.0f, 0.0f),
+        Point2D(1.0f, 0.0f),
+        Point2D(2.0f, 0.0f),
+        Point2D(3.0f, 0.0f),
+        Point2D(4.0f, 0.0f),
+        Point2D(4.0f, 2.0f),
+        Point2D(0.0f, 2.0f)
+    });
+    EXPECT_EQ(polygon.centroid(), Point2D(2.0f, 1.0f));
+    EXPECT_NE(polygon.meanPoint(), Point2D(2.0f, 1.0f));
+
+    /* independent of winding order */
+    std::reverse(polygon.vertices.begin(), polygon.vertices.end());
+    EXPECT_EQ(polygon.centroid(), Point2D(2.0f, 1.0f));
+
+    /* L shaped polygon */
+    Polygon2D l_polygon(
+    {
+        Point2D(0.0f, 0.0f),
+        Point2D(2.0f, 0.0f),
+        Point2D(2.0f, 1.0f),
+        Point2D(1.0f, 1.0f),
+        Point2D(1.0f, 2.0f),
+        Point2D(0.0f, 2.0f)
+    });
+    EXPECT_EQ(l_polygon.centroid(), Point2D(5.0f/6, 5.0f/6));
+
+    /* degenerate polygon falls back to mean point */
+    Polygon2D line({Point2D(0.0f, 0.0f), Point2D(2.0f, 2.0f), Point2D(4.0f, 4.0f)});
+    EXPECT_EQ(line.centroid(), Point2D(2.0f, 2.0f));
+}
+
+TEST(Polygon2DTest, simplify)
+{
+    /* square with redundant vertices on each edge, starting mid edge */
+    Polygon2D polygon;
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        polygon.vertices.push_back(Point2D(i * 0.5f, 0.001f * (i % 2)));
+    }
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        polygon.vertices.push_back(Point2D(2.0f, i * 0.5f));
+    }
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        polygon.vertices.push_back(Point2D(2.0f - (i * 0.5f), 2.0f));
+    }
+    for ( size_t i = 0; i < 4; i++ )
+    {
+        polygon.vertices.push_back(Point2D(0.0f, 2.0f - (i * 0.5f)));
+    }
+    std::rotate(polygon.vertices.begin(), polygon.vertices.begin() + 2,
+                polygon.vertices.end());
+    const float area = polygon.area();
+
+    polygon.simplify(0.01f);
+    EXPECT_EQ(polygon.size(), 5u); // the start vertex is always kept
+    EXPECT_NEAR(polygon.area(), area, 1e-3f);
+    EXPECT_EQ(polygon[0], Point2D(1.0f, 0.0f));
+    EXPECT_EQ(polygon[1], Point2D(2.0f, 0.0f));
+    EXPECT_EQ(polygon[4], Point2D(0.0f, 0.0f));
+
+    Polygon2D triangle({Point2D(0.0f, 0.0f), Point2D(1.0f, 0.0f), Point2D(0.0f, 1.0f)});
+    triangle.simplify(10.0f);
+    EXPECT_EQ(triangle.size(), 3u);
+}
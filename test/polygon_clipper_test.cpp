@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <geometry_common/PolygonClipper.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::PolygonWithHoles2D;
+using kelo::geometry_common::PolygonClipper;
+
+Polygon2D createSquare(float min_x, float min_y, float size)
+{
+    return Polygon2D(
+    {
+        Point2D(min_x, min_y),
+        Point2D(min_x + size, min_y),
+        Point2D(min_x + size, min_y + size),
+        Point2D(min_x, min_y + size)
+    });
+}
+
+float calcTotalArea(const std::vector<PolygonWithHoles2D>& polygons)
+{
+    float area = 0.0f;
+    for ( const PolygonWithHoles2D& polygon : polygons )
+    {
+        area += polygon.area();
+    }
+    return area;
+}
+
+TEST(PolygonClipperTest, overlappingSquares)
+{
+    Polygon2D square_a = createSquare(0.0f, 0.0f, 2.0f);
+    Polygon2D square_b = createSquare(1.0f, 1.0f, 2.0f);
+
+    std::vector<PolygonWithHoles2D> intersection =
+        PolygonClipper::calcIntersection(square_a, square_b);
+    ASSERT_EQ(intersection.size(), 1u);
+    EXPECT_EQ(intersection[0].boundary.size(), 4u);
+    EXPECT_NEAR(intersection[0].boundary.area(), 1.0f, 1e-5f)
+        << "Boundary is expected to be counter clockwise";
+    EXPECT_TRUE(intersection[0].containsPoint(Point2D(1.5f, 1.5f)));
+    EXPECT_FALSE(intersection[0].containsPoint(Point2D(0.5f, 0.5f)));
+
+    std::vector<PolygonWithHoles2D> polygon_union =
+        PolygonClipper::calcUnion(square_a, square_b);
+    ASSERT_EQ(polygon_union.size(), 1u);
+    EXPECT_EQ(polygon_union[0].boundary.size(), 8u);
+    EXPECT_NEAR(calcTotalArea(polygon_union), 7.0f, 1e-5f);
+
+    std::vector<PolygonWithHoles2D> difference =
+        PolygonClipper::calcDifference(square_a, square_b);
+    ASSERT_EQ(difference.size(), 1u);
+    EXPECT_NEAR(calcTotalArea(difference), 3.0f, 1e-5f);
+    EXPECT_FALSE(difference[0].containsPoint(Point2D(1.5f, 1.5f)));
+    EXPECT_TRUE(difference[0].containsPoint(Point2D(0.5f, 0.5f)));
+
+    std::vector<PolygonWithHoles2D> polygon_xor =
+        PolygonClipper::calcXor(square_a, square_b);
+    EXPECT_EQ(polygon_xor.size(), 2u);
+    EXPECT_NEAR(calcTotalArea(polygon_xor), 6.0f, 1e-5f);
+}
+
+TEST(PolygonClipperTest, holes)
+{
+    Polygon2D outer = createSquare(0.0f, 0.0f, 4.0f);
+    Polygon2D inner = createSquare(1.0f, 1.0f, 2.0f);
+    inner.reverse(); // winding order of input must not matter
+
+    std::vector<PolygonWithHoles2D> difference =
+        PolygonClipper::calcDifference(outer, inner);
+    ASSERT_EQ(difference.size(), 1u);
+    ASSERT_EQ(difference[0].holes.size(), 1u);
+    EXPECT_LT(difference[0].holes[0].area(), 0.0f)
+        << "Hole is expected to be clockwise";
+    EXPECT_NEAR(difference[0].area(), 12.0f, 1e-5f);
+    EXPECT_FALSE(difference[0].containsPoint(Point2D(2.0f, 2.0f)));
+    EXPECT_TRUE(difference[0].containsPoint(Point2D(0.5f, 2.0f)));
+
+    /* filling the hole again gives back the outer square */
+    std::vector<PolygonWithHoles2D> filled = PolygonClipper::calcBooleanOperation(
+            difference, {PolygonWithHoles2D(inner)},
+            kelo::geometry_common::BooleanOperation::UNION);
+    ASSERT_EQ(filled.size(), 1u);
+    EXPECT_TRUE(filled[0].holes.empty());
+    EXPECT_NEAR(filled[0].area(), 16.0f, 1e-5f);
+}
+
+TEST(PolygonClipperTest, disjointAndTouching)
+{
+    Polygon2D square_a = createSquare(0.0f, 0.0f, 1.0f);
+    Polygon2D square_b = createSquare(5.0f, 0.0f, 1.0f);
+    EXPECT_TRUE(PolygonClipper::calcIntersection(square_a, square_b).empty());
+    EXPECT_EQ(PolygonClipper::calcUnion(square_a, square_b).size(), 2u);
+
+    /* squares sharing an edge are merged into a single rectangle */
+    Polygon2D square_c = createSquare(1.0f, 0.0f, 1.0f);
+    std::vector<PolygonWithHoles2D> polygon_union =
+        PolygonClipper::calcUnion(square_a, square_c);
+    ASSERT_EQ(polygon_union.size(), 1u);
+    EXPECT_EQ(polygon_union[0].boundary.size(), 4u);
+    EXPECT_NEAR(polygon_union[0].area(), 2.0f, 1e-5f);
+}
+
+TEST(PolygonClipperTest, partiallySharedEdge)
+{
+    /* the left edge of square_b lies within the right edge of square_a */
+    Polygon2D square_a = createSquare(0.0f, 0.0f, 2.0f);
+    Polygon2D square_b = createSquare(2.0f, 0.5f, 1.0f);
+
+    std::vector<PolygonWithHoles2D> polygon_union =
+        PolygonClipper::calcUnion(square_a, square_b);
+    ASSERT_EQ(polygon_union.size(), 1u);
+    EXPECT_TRUE(polygon_union[0].holes.empty());
+    EXPECT_NEAR(polygon_union[0].area(), 5.0f, 1e-5f);
+
+    std::vector<PolygonWithHoles2D> difference =
+        PolygonClipper::calcDifference(square_a, square_b);
+    ASSERT_EQ(difference.size(), 1u);
+    EXPECT_NEAR(difference[0].area(), 4.0f, 1e-5f);
+
+    EXPECT_NEAR(calcTotalArea(PolygonClipper::calcIntersection(square_a, square_b)),
+                0.0f, 1e-5f);
+}
+
+TEST(PolygonClipperTest, unionOfMany)
+{
+    /* a row of overlapping squares and one separate square */
+    std::vector<Polygon2D> squares;
+    for ( size_t i = 0; i < 20; i++ )
+    {
+        squares.push_back(createSquare(0.5f * i, 0.0f, 1.0f));
+    }
+    squares.push_back(createSquare(100.0f, 100.0f, 1.0f));
+
+    std::vector<PolygonWithHoles2D> polygon_union = PolygonClipper::calcUnion(squares);
+    ASSERT_EQ(polygon_union.size(), 2u);
+    EXPECT_EQ(polygon_union[0].boundary.size(), 4u);
+    EXPECT_NEAR(calcTotalArea(polygon_union), 10.5f + 1.0f, 1e-4f);
+}
+
+TEST(PolygonClipperTest, unionOfTouchingRings)
+{
+    /* b shares the vertex (13, 17) with c and has a vertex on an edge of a,
+     * so intermediate unions have rings touching each other */
+    Polygon2D polygon_a = createSquare(7.0f, 17.0f, 3.0f);
+    Polygon2D polygon_b(
+    {
+        Point2D(17.0f, 19.0f), Point2D(14.0f, 20.0f), Point2D(13.0f, 23.0f),
+        Point2D(11.0f, 20.0f), Point2D(10.0f, 18.0f), Point2D(13.0f, 17.0f),
+        Point2D(14.0f, 18.0f)
+    });
+    Polygon2D polygon_c = createSquare(13.0f, 14.0f, 3.0f);
+
+    std::vector<PolygonWithHoles2D> polygon_union = PolygonClipper::calcUnion(
+            std::vector<Polygon2D>{polygon_a, polygon_b, polygon_c});
+    EXPECT_NEAR(calcTotalArea(polygon_union), 34.5f, 1e-4f);
+
+    polygon_union = PolygonClipper::calcBooleanOperation(
+            PolygonClipper::calcUnion(polygon_a, polygon_b),
+            {PolygonWithHoles2D(polygon_c)},
+            kelo::geometry_common::BooleanOperation::UNION);
+    EXPECT_NEAR(calcTotalArea(polygon_union), 34.5f, 1e-4f);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <geometry_common/RayCaster2D.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Pose2D;
+using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::LineSegment2D;
+using kelo::geometry_common::RayCaster2D;
+
+float calcRangeBF(const std::vector<LineSegment2D>& segments,
+                  const std::vector<Polygon2D>& polygons,
+                  const Pose2D& pose, float angle, float range_max)
+{
+    const Point2D start(pose.x, pose.y);
+    const LineSegment2D ray(start, start + Point2D::initFromRadialCoord(
+                range_max, pose.theta + angle));
+    float range = std::numeric_limits<float>::infinity();
+    Point2D pt;
+    for ( const LineSegment2D& segment : segments )
+    {
+        if ( segment.calcIntersectionPointWith(ray, pt) )
+        {
+            range = std::min(range, start.distTo(pt));
+        }
+    }
+    for ( const Polygon2D& polygon : polygons )
+    {
+        if ( polygon.calcClosestIntersectionPointWith(ray, pt) )
+        {
+            range = std::min(range, start.distTo(pt));
+        }
+    }
+    return range;
+}
+
+TEST(RayCaster2DTest, calcRanges)
+{
+    std::mt19937 generator(9);
+    std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+    std::vector<LineSegment2D> segments;
+    std::vector<Polygon2D> polygons;
+    for ( size_t i = 0; i < 100; i++ )
+    {
+        Point2D center(position(generator), position(generator));
+        segments.push_back(LineSegment2D(center, center + Point2D(offset(generator),
+                                                                  offset(generator))));
+        center = Point2D(position(generator), position(generator));
+        polygons.push_back(Polygon2D(
+        {
+            center + Point2D(offset(generator), offset(generator)),
+            center + Point2D(offset(generator), offset(generator)),
+            center + Point2D(offset(generator), offset(generator))
+        }));
+    }
+    RayCaster2D ray_caster(segments, polygons);
+    EXPECT_EQ(ray_caster.size(), 400u);
+
+    std::vector<float> ranges;
+    for ( size_t i = 0; i < 20; i++ )
+    {
+        Pose2D pose(position(generator), position(generator), 3 * offset(generator));
+        const float angle_min = -2.5f;
+        const float angle_increment = 0.01f;
+        const float range_max = ( i % 2 == 0 ) ? 8.0f : 30.0f;
+        ray_caster.calcRanges(pose, angle_min, 2.5f, angle_increment, range_max, ranges);
+        ASSERT_EQ(ranges.size(), 501u);
+        for ( size_t j = 0; j < ranges.size(); j++ )
+        {
+            const float angle = angle_min + j * angle_increment;
+            const float expected = calcRangeBF(segments, polygons, pose, angle, range_max);
+            if ( std::isinf(expected) )
+            {
+                EXPECT_TRUE(std::isinf(ranges[j])) << ranges[j];
+            }
+            else
+            {
+                EXPECT_NEAR(ranges[j], expected, 1e-3f);
+            }
+            const float range = ray_caster.calcRange(pose, angle, range_max);
+            EXPECT_TRUE(( std::isinf(range) && std::isinf(ranges[j]) ) ||
+                        std::fabs(range - ranges[j]) < 1e-3f);
+        }
+    }
+}
+
+TEST(RayCaster2DTest, fullCircle)
+{
+    /* sensor in the middle of a square room */
+    RayCaster2D ray_caster({}, {Polygon2D({Point2D(-2.0f, -2.0f), Point2D(2.0f, -2.0f),
+                                           Point2D(2.0f, 2.0f), Point2D(-2.0f, 2.0f)})});
+    std::vector<float> ranges;
+    ray_caster.calcRanges(Pose2D(0.0f, 0.0f, M_PI/4), -M_PI, M_PI, M_PI/4, 10.0f, ranges);
+    ASSERT_EQ(ranges.size(), 9u);
+    for ( size_t i = 0; i < ranges.size(); i++ )
+    {
+        EXPECT_NEAR(ranges[i], ( i % 2 == 0 ) ? 2.0f * std::sqrt(2.0f) : 2.0f, 1e-4f);
+    }
+
+    /* walls beyond range_max */
+    ray_caster.calcRanges(Pose2D(), -M_PI, M_PI, M_PI/4, 1.0f, ranges);
+    for ( float range : ranges )
+    {
+        EXPECT_TRUE(std::isinf(range));
+    }
+}
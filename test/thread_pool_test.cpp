@@ -0,0 +1,209 @@
+/******************************************************************************
+ * Copyright (c) 2022
+ * KELO Robotics GmbH
+ *
+ * Author:
+ * Dharmin Bakaraniya
+ * Sushant Chavan
+ *
+ *
+ * This software is published under a dual-license: GNU Lesser General Public
+ * License LGPL 2.1 and BSD license. The dual-license implies that users of this
+ * code may choose which terms they prefer.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ * * Neither the name of Locomotec nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License LGPL as
+ * published by the Free Software Foundation, either version 2.1 of the
+ * License, or (at your option) any later version or the BSD license.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License LGPL and the BSD license for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License LGPL and BSD license along with this program.
+ *
+ ******************************************************************************/
+
+#include <atomic>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <geometry_common/ThreadPool.h>
+#include <geometry_common/TransformMatrix2D.h>
+#include <geometry_common/TransformMatrix3D.h>
+#include <geometry_common/Utils.h>
+
+using kelo::geometry_common::ThreadPool;
+using kelo::geometry_common::ExecutionPolicy;
+using kelo::geometry_common::TransformMatrix2D;
+using kelo::geometry_common::TransformMatrix3D;
+using kelo::geometry_common::Utils;
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::PointCloud2D;
+using kelo::geometry_common::PointCloud3D;
+using kelo::geometry_common::PointVec2D;
+using kelo::geometry_common::PointArrayView2D;
+
+TEST(ThreadPoolTest, parallelForCoversRangeOnce)
+{
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.numOfThreads(), 3u);
+    std::vector<std::atomic<int>> counts(10007);
+    for ( std::atomic<int>& count : counts )
+    {
+        count = 0;
+    }
+    pool.parallelFor(0, counts.size(), 16,
+            [&counts](size_t begin, size_t end)
+            {
+                for ( size_t i = begin; i < end; i++ )
+                {
+                    counts[i]++;
+                }
+            });
+    for ( size_t i = 0; i < counts.size(); i++ )
+    {
+        EXPECT_EQ(counts[i], 1) << "index " << i;
+    }
+}
+
+TEST(ThreadPoolTest, nestedParallelFor)
+{
+    ThreadPool pool(2);
+    std::atomic<size_t> sum(0);
+    pool.parallelFor(0, 8, 1,
+            [&pool, &sum](size_t begin, size_t end)
+            {
+                for ( size_t i = begin; i < end; i++ )
+                {
+                    pool.parallelFor(0, 100, 10,
+                            [&sum](size_t inner_begin, size_t inner_end)
+                            {
+                                sum += inner_end - inner_begin;
+                            });
+                }
+            });
+    EXPECT_EQ(sum, 800u);
+}
+
+TEST(ThreadPoolTest, exceptionIsRethrown)
+{
+    ThreadPool pool(2);
+    EXPECT_THROW(pool.parallelFor(0, 1000, 10,
+            [](size_t begin, size_t end)
+            {
+                if ( begin <= 500 && 500 < end )
+                {
+                    throw std::runtime_error("chunk failed");
+                }
+            }), std::runtime_error);
+
+    /* pool is still usable afterwards */
+    std::atomic<size_t> num_of_indices(0);
+    pool.parallelFor(0, 1000, 10,
+            [&num_of_indices](size_t begin, size_t end)
+            {
+                num_of_indices += end - begin;
+            });
+    EXPECT_EQ(num_of_indices, 1000u);
+}
+
+TEST(ThreadPoolTest, withoutWorkers)
+{
+    ThreadPool pool(0);
+    EXPECT_EQ(pool.numOfThreads(), 0u);
+    bool is_run = false;
+    pool.submit([&is_run]() { is_run = true; });
+    EXPECT_TRUE(is_run);
+
+    size_t num_of_indices = 0;
+    pool.parallelFor(5, 105, 7,
+            [&num_of_indices](size_t begin, size_t end)
+            {
+                num_of_indices += end - begin;
+            });
+    EXPECT_EQ(num_of_indices, 100u);
+}
+
+TEST(ThreadPoolTest, transformWithExecutionPolicy)
+{
+    ThreadPool pool(3);
+    ExecutionPolicy policy(&pool, 64);
+    EXPECT_TRUE(policy.isParallel());
+    EXPECT_FALSE(ExecutionPolicy().isParallel());
+
+    PointCloud2D cloud_2d;
+    PointCloud3D cloud_3d;
+    for ( size_t i = 0; i < 1000; i++ )
+    {
+        cloud_2d.push_back(Point2D(0.01f * i, -0.02f * i));
+        cloud_3d.push_back(Point3D(0.01f * i, -0.02f * i, 0.005f * i));
+    }
+
+    TransformMatrix2D tf_2d(1.0f, -2.0f, 0.7f);
+    PointCloud2D expected_cloud_2d = cloud_2d;
+    tf_2d.transform(expected_cloud_2d);
+    tf_2d.transform(cloud_2d, policy);
+    ASSERT_EQ(cloud_2d.size(), expected_cloud_2d.size());
+    for ( size_t i = 0; i < cloud_2d.size(); i++ )
+    {
+        EXPECT_EQ(cloud_2d[i], expected_cloud_2d[i]);
+    }
+
+    TransformMatrix3D tf_3d(1.0f, 2.0f, 3.0f, 0.1f, 0.2f, 0.3f);
+    PointCloud3D expected_cloud_3d = cloud_3d;
+    tf_3d.transform(expected_cloud_3d);
+    tf_3d.transform(cloud_3d, policy);
+    ASSERT_EQ(cloud_3d.size(), expected_cloud_3d.size());
+    for ( size_t i = 0; i < cloud_3d.size(); i++ )
+    {
+        EXPECT_EQ(cloud_3d[i], expected_cloud_3d[i]);
+    }
+}
+
+TEST(ThreadPoolTest, calcIndicesInPolygon)
+{
+    ThreadPool pool(3);
+    PointVec2D vertices{Point2D(0.0f, 0.0f), Point2D(2.0f, 0.0f),
+                        Point2D(2.0f, 2.0f), Point2D(0.0f, 2.0f)};
+    PointArrayView2D<Point2D> view(vertices);
+
+    PointCloud2D points;
+    for ( float x = -1.05f; x < 3.0f; x += 0.1f )
+    {
+        for ( float y = -1.05f; y < 3.0f; y += 0.1f )
+        {
+            points.push_back(Point2D(x, y));
+        }
+    }
+
+    std::vector<size_t> expected_indices;
+    for ( size_t i = 0; i < points.size(); i++ )
+    {
+        if ( Utils::isPointInPolygon(view, points[i]) )
+        {
+            expected_indices.push_back(i);
+        }
+    }
+    ASSERT_FALSE(expected_indices.empty());
+
+    std::vector<size_t> indices;
+    Utils::calcIndicesInPolygon(view, points, indices);
+    EXPECT_EQ(indices, expected_indices);
+    Utils::calcIndicesInPolygon(view, points, indices, ExecutionPolicy(&pool, 32));
+    EXPECT_EQ(indices, expected_indices);
+}
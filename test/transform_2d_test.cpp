@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+
+#include <geometry_common/TransformMatrix2D.h>
+#include <geometry_common/SinCosTable.h>
+#include <geometry_common/Pose2D.h>
+
+using kelo::geometry_common::Pose2D;
+using kelo::geometry_common::Path;
+using kelo::geometry_common::TransformMatrix2D;
+using kelo::geometry_common::SinCosTable;
+
+TEST(TransformMatrix2DTest, initFromCosSin)
+{
+    EXPECT_EQ(TransformMatrix2D(), TransformMatrix2D(0.0f, 0.0f, 0.0f));
+    EXPECT_EQ(TransformMatrix2D::initFromCosSin(1.0f, -2.0f, std::cos(0.7f), std::sin(0.7f)),
+              TransformMatrix2D(1.0f, -2.0f, 0.7f));
+
+    TransformMatrix2D tf_mat(1.0f, 2.0f, 0.0f);
+    tf_mat.updateRotation(0.0f, -1.0f);
+    EXPECT_EQ(tf_mat, TransformMatrix2D(1.0f, 2.0f, -M_PI/2));
+}
+
+TEST(TransformMatrix2DTest, calcTransformMatrices)
+{
+    Path poses;
+    for ( size_t i = 0; i < 100; i++ )
+    {
+        poses.push_back(Pose2D(i * 0.1f, -(i * 0.2f), (i * 0.13f) - 6.0f));
+    }
+    std::vector<TransformMatrix2D> tf_mats(3);
+    TransformMatrix2D::calcTransformMatrices(poses, tf_mats);
+    ASSERT_EQ(tf_mats.size(), poses.size());
+    for ( size_t i = 0; i < poses.size(); i++ )
+    {
+        TransformMatrix2D expected_tf_mat(poses[i]);
+        for ( size_t j = 0; j < 6; j++ )
+        {
+            EXPECT_NEAR(tf_mats[i][j], expected_tf_mat[j], 1e-6f);
+        }
+    }
+}
+
+TEST(SinCosTableTest, calcSinCos)
+{
+    SinCosTable table;
+    EXPECT_LT(table.maxError(), 1e-6f);
+    float max_error = 0.0f;
+    for ( float angle = -20.0f; angle < 20.0f; angle += 0.0013f )
+    {
+        float sin_value, cos_value;
+        table.calcSinCos(angle, sin_value, cos_value);
+        max_error = std::max(max_error, std::fabs(sin_value - std::sin(angle)));
+        max_error = std::max(max_error, std::fabs(cos_value - std::cos(angle)));
+    }
+    EXPECT_LE(max_error, table.maxError());
+
+    SinCosTable coarse_table(64);
+    EXPECT_GT(coarse_table.maxError(), table.maxError());
+    float sin_value, cos_value;
+    coarse_table.calcSinCos(M_PI/2, sin_value, cos_value);
+    EXPECT_NEAR(sin_value, 1.0f, coarse_table.maxError());
+    EXPECT_NEAR(cos_value, 0.0f, coarse_table.maxError());
+    EXPECT_EQ(coarse_table.calcTransformMatrix(1.0f, 2.0f, M_PI/2),
+              TransformMatrix2D(1.0f, 2.0f, M_PI/2));
+
+    /* bound holds against exact values at fine resolution as well */
+    for ( size_t resolution : {64, 4096, 65536} )
+    {
+        SinCosTable fine_table(resolution);
+        double fine_max_error = 0.0;
+        for ( size_t i = 0; i < 1000000; i++ )
+        {
+            const float angle = -M_PI + (i * 2.0 * M_PI / 1000000);
+            fine_table.calcSinCos(angle, sin_value, cos_value);
+            fine_max_error = std::max(fine_max_error, std::fabs(sin_value - std::sin(double(angle))));
+            fine_max_error = std::max(fine_max_error, std::fabs(cos_value - std::cos(double(angle))));
+        }
+        EXPECT_LE(fine_max_error, fine_table.maxError()) << "resolution " << resolution;
+    }
+
+    table.calcSinCos(std::numeric_limits<float>::quiet_NaN(), sin_value, cos_value);
+    EXPECT_TRUE(std::isnan(sin_value));
+    EXPECT_TRUE(std::isnan(cos_value));
+    table.calcSinCos(std::numeric_limits<float>::infinity(), sin_value, cos_value);
+    EXPECT_TRUE(std::isnan(sin_value));
+    EXPECT_TRUE(std::isnan(cos_value));
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+
+#include <geometry_common/TransformBuffer2D.h>
+#include <geometry_common/TransformBuffer3D.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::Pose2D;
+using kelo::geometry_common::PointCloud2D;
+using kelo::geometry_common::PointCloud3D;
+using kelo::geometry_common::TransformMatrix2D;
+using kelo::geometry_common::TransformMatrix3D;
+using kelo::geometry_common::TransformBuffer2D;
+using kelo::geometry_common::TransformBuffer3D;
+
+TEST(TransformBuffer2DTest, calcPose)
+{
+    TransformBuffer2D buffer(1.0);
+    Pose2D pose;
+    EXPECT_FALSE(buffer.calcPose(0.0, pose));
+
+    buffer.addPose(10.0, Pose2D(0.0f, 0.0f, 3.0f));
+    buffer.addPose(10.4, Pose2D(2.0f, 1.0f, -3.0f)); // wraps around pi
+    buffer.addPose(10.2, Pose2D(1.0f, 0.0f, 3.1f)); // out of order
+    EXPECT_EQ(buffer.size(), 3u);
+
+    EXPECT_TRUE(buffer.calcPose(10.1, pose));
+    EXPECT_EQ(pose, Pose2D(0.5f, 0.0f, 3.05f));
+    EXPECT_TRUE(buffer.calcPose(10.4, pose));
+    EXPECT_EQ(pose, Pose2D(2.0f, 1.0f, -3.0f));
+    EXPECT_TRUE(buffer.calcPose(10.3, pose));
+    EXPECT_NEAR(pose.x, 1.5f, 1e-3f);
+    EXPECT_NEAR(pose.y, 0.5f, 1e-3f);
+    EXPECT_NEAR(pose.theta, 3.1f + (0.5f * (2*M_PI - 6.1f)) - 2*M_PI, 1e-3f);
+    EXPECT_FALSE(buffer.calcPose(10.5, pose)); // no extrapolation
+    EXPECT_FALSE(buffer.calcPose(9.9, pose));
+
+    buffer.addPose(11.1, Pose2D(3.0f, 1.0f, 0.0f));
+    EXPECT_EQ(buffer.size(), 3u);
+    EXPECT_DOUBLE_EQ(buffer.oldestStamp(), 10.2);
+    EXPECT_DOUBLE_EQ(buffer.newestStamp(), 11.1);
+}
+
+TEST(TransformBuffer2DTest, deskew)
+{
+    /* robot rotates with 1 rad/s and moves forward with 1 m/s */
+    TransformBuffer2D buffer;
+    for ( size_t i = 0; i <= 10; i++ )
+    {
+        const double t = i * 0.01;
+        buffer.addPose(100.0 + t, Pose2D(t, 0.0f, t));
+    }
+
+    PointCloud2D cloud;
+    std::vector<float> time_offsets;
+    PointCloud2D expected_cloud;
+    TransformMatrix2D target_tf_mat;
+    ASSERT_TRUE(buffer.calcTransform(100.1, target_tf_mat));
+    target_tf_mat.invert();
+    for ( size_t i = 0; i < 1000; i++ )
+    {
+        const float t = i * 1e-4f;
+        const Point2D pt = Point2D::initFromRadialCoord(5.0f, i * 0.006f);
+        TransformMatrix2D tf_mat;
+        ASSERT_TRUE(buffer.calcTransform(100.0 + t, tf_mat));
+        cloud.push_back(pt);
+        time_offsets.push_back(t);
+        expected_cloud.push_back(target_tf_mat * tf_mat * pt);
+    }
+
+    EXPECT_TRUE(buffer.deskew(cloud, time_offsets, 100.0, 100.1, 128));
+    for ( size_t i = 0; i < cloud.size(); i++ )
+    {
+        EXPECT_NEAR(cloud[i].x, expected_cloud[i].x, 5e-3f);
+        EXPECT_NEAR(cloud[i].y, expected_cloud[i].y, 5e-3f);
+    }
+
+    PointCloud2D unchanged_cloud(cloud);
+    EXPECT_FALSE(buffer.deskew(cloud, time_offsets, 100.0, 100.2));
+    EXPECT_FALSE(buffer.deskew(cloud, time_offsets, 99.95, 100.1));
+    time_offsets[500] = std::numeric_limits<float>::quiet_NaN();
+    EXPECT_FALSE(buffer.deskew(cloud, time_offsets, 100.0, 100.1));
+    for ( size_t i = 0; i < cloud.size(); i++ )
+    {
+        EXPECT_EQ(cloud[i], unchanged_cloud[i]);
+    }
+}
+
+TEST(TransformBuffer3DTest, calcTransform)
+{
+    TransformBuffer3D buffer;
+    buffer.addTransform(1.0, TransformMatrix3D(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f));
+    buffer.addTransform(2.0, TransformMatrix3D(2.0f, -2.0f, 4.0f, 0.0f, 0.0f, M_PI/2));
+
+    TransformMatrix3D tf_mat;
+    EXPECT_TRUE(buffer.calcTransform(1.5, tf_mat));
+    EXPECT_EQ(tf_mat, TransformMatrix3D(1.0f, -1.0f, 2.0f, 0.0f, 0.0f, M_PI/4));
+    EXPECT_TRUE(buffer.calcTransform(1.25, tf_mat));
+    EXPECT_EQ(tf_mat, TransformMatrix3D(0.5f, -0.5f, 1.0f, 0.0f, 0.0f, M_PI/8));
+    EXPECT_FALSE(buffer.calcTransform(2.5, tf_mat));
+
+    /* quaternions with opposite signs represent the same rotation */
+    buffer.clear();
+    buffer.addTransform(0.0, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+    buffer.addTransform(1.0, 0.0f, 0.0f, 0.0f,
+                        -std::sin(0.25f), 0.0f, 0.0f, -std::cos(0.25f));
+    EXPECT_TRUE(buffer.calcTransform(0.5, tf_mat));
+    EXPECT_EQ(tf_mat, TransformMatrix3D(0.0f, 0.0f, 0.0f, 0.25f, 0.0f, 0.0f));
+}
+
+TEST(TransformBuffer3DTest, deskew)
+{
+    TransformBuffer3D buffer;
+    buffer.addTransform(0.0, TransformMatrix3D(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f));
+    buffer.addTransform(0.1, TransformMatrix3D(0.2f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f));
+
+    PointCloud3D cloud{Point3D(1.0f, 0.0f, 0.5f), Point3D(1.0f, 0.0f, 0.5f)};
+    std::vector<float> time_offsets{0.0f, 0.1f};
+    EXPECT_TRUE(buffer.deskew(cloud, time_offsets, 0.0, 0.1, 2));
+    EXPECT_EQ(cloud[0], Point3D(0.85f, 0.0f, 0.5f));
+    EXPECT_EQ(cloud[1], Point3D(0.95f, 0.0f, 0.5f));
+
+    /* non finite time offsets are rejected without modifying the cloud */
+    const PointCloud3D unchanged_cloud(cloud);
+    time_offsets[1] = std::numeric_limits<float>::quiet_NaN();
+    EXPECT_FALSE(buffer.deskew(cloud, time_offsets, 0.0, 0.1, 2));
+    time_offsets[0] = time_offsets[1];
+    EXPECT_FALSE(buffer.deskew(cloud, time_offsets, 0.0, 0.1, 2));
+    EXPECT_EQ(cloud[0], unchanged_cloud[0]);
+    EXPECT_EQ(cloud[1], unchanged_cloud[1]);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <geometry_common/TransformChain2D.h>
+#include <geometry_common/TransformChain3D.h>
+
+using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::Pose2D;
+using kelo::geometry_common::Path;
+using kelo::geometry_common::PointCloud2D;
+using kelo::geometry_common::PointCloud3D;
+using kelo::geometry_common::Polygon2D;
+using kelo::geometry_common::TransformMatrix2D;
+using kelo::geometry_common::TransformMatrix3D;
+using kelo::geometry_common::TransformChain2D;
+using kelo::geometry_common::TransformChain3D;
+
+TEST(TransformChain2DTest, matchesStepwiseTransformation)
+{
+    TransformMatrix2D map_T_odom(1.0f, 2.0f, 0.5f);
+    TransformMatrix2D odom_T_base(-3.0f, 0.5f, 2.8f);
+    TransformMatrix2D base_T_sensor(0.2f, 0.0f, -1.0f);
+    TransformChain2D chain({map_T_odom, odom_T_base});
+    EXPECT_EQ(chain.append(base_T_sensor), 2u);
+
+    PointCloud2D cloud, expected_cloud;
+    Path path, expected_path;
+    for ( size_t i = 0; i < 100; i++ )
+    {
+        cloud.push_back(Point2D(0.1f * i, std::sin(0.1f * i)));
+        path.push_back(Pose2D(0.1f * i, -0.2f * i, 0.05f * i));
+    }
+    expected_cloud = cloud;
+    base_T_sensor.transform(expected_cloud);
+    odom_T_base.transform(expected_cloud);
+    map_T_odom.transform(expected_cloud);
+    expected_path = path;
+    base_T_sensor.transform(expected_path);
+    odom_T_base.transform(expected_path);
+    map_T_odom.transform(expected_path);
+
+    PointCloud2D transformed_cloud;
+    chain.transform(cloud, transformed_cloud);
+    chain.transform(cloud);
+    chain.transform(path);
+    ASSERT_EQ(transformed_cloud.size(), expected_cloud.size());
+    for ( size_t i = 0; i < cloud.size(); i++ )
+    {
+        EXPECT_EQ(cloud[i], expected_cloud[i]);
+        EXPECT_EQ(transformed_cloud[i], expected_cloud[i]);
+        EXPECT_EQ(path[i], expected_path[i]);
+    }
+
+    Polygon2D polygon({Point2D(0.0f, 0.0f), Point2D(1.0f, 0.0f), Point2D(0.0f, 1.0f)});
+    Polygon2D expected_polygon = map_T_odom * odom_T_base * base_T_sensor * polygon;
+    chain.transform(polygon);
+    for ( size_t i = 0; i < polygon.size(); i++ )
+    {
+        EXPECT_EQ(polygon[i], expected_polygon[i]);
+    }
+}
+
+TEST(TransformChain2DTest, updateLink)
+{
+    TransformChain2D chain;
+    EXPECT_EQ(chain.composed(), TransformMatrix2D());
+
+    chain.append(TransformMatrix2D(1.0f, 0.0f, 0.0f));
+    chain.append(TransformMatrix2D(0.0f, 1.0f, M_PI/2));
+    Point2D pt(1.0f, 0.0f);
+    chain.transform(pt);
+    EXPECT_EQ(pt, Point2D(1.0f, 2.0f));
+
+    chain.updateLink(0, TransformMatrix2D(-1.0f, 0.0f, 0.0f));
+    pt = Point2D(1.0f, 0.0f);
+    chain.transform(pt);
+    EXPECT_EQ(pt, Point2D(-1.0f, 2.0f));
+    EXPECT_EQ(chain.composed(), TransformMatrix2D(-1.0f, 1.0f, M_PI/2));
+}
+
+TEST(TransformChain3DTest, matchesStepwiseTransformation)
+{
+    TransformMatrix3D tf1(1.0f, 2.0f, 3.0f, 0.1f, 0.2f, 0.3f);
+    TransformMatrix3D tf2(-1.0f, 0.5f, 0.0f, -0.3f, 0.0f, 1.2f);
+    TransformChain3D chain({tf1, tf2});
+
+    PointCloud3D cloud;
+    for ( size_t i = 0; i < 50; i++ )
+    {
+        cloud.push_back(Point3D(0.1f * i, -0.3f * i, 0.01f * i * i));
+    }
+    PointCloud3D expected_cloud(cloud);
+    tf2.transform(expected_cloud);
+    tf1.transform(expected_cloud);
+
+    chain.transform(cloud);
+    for ( size_t i = 0; i < cloud.size(); i++ )
+    {
+        EXPECT_EQ(cloud[i], expected_cloud[i]);
+    }
+
+    chain.updateLink(1, TransformMatrix3D());
+    EXPECT_EQ(chain.composed(), tf1);
+}
@@ -1,12 +1,24 @@
 #include <gtest/gtest.h>
 
+#include <cstring>
+#include <limits>
+#include <random>
 #include <vector>
 
+#include <sensor_msgs/point_cloud2_iterator.h>
+
 #include <geometry_common/Utils.h>
+#include <geometry_common/TransformMatrix2D.h>
 
 using kelo::geometry_common::Point2D;
+using kelo::geometry_common::Point3D;
+using kelo::geometry_common::PointCloud2D;
+using kelo::geometry_common::PointCloud3D;
 using kelo::geometry_common::PointVec2D;
 using kelo::geometry_common::LineSegment2D;
+using kelo::geometry_common::Pose2D;
+using kelo::geometry_common::Velocity2D;
+using kelo::geometry_common::TransformMatrix2D;
 using kelo::geometry_common::Utils;
 using kelo::geometry_common::WindingOrder;
 
@@ -35,6 +47,299 @@ TEST(UtilsTest, clipAngle)
     EXPECT_NEAR(Utils::clipAngle(-10.0f*M_PI), 0.0f, 1e-3f);
 }
 
+TEST(UtilsTest, calcSinCos)
+{
+    std::vector<float> angles{0.0f, M_PI/2, -M_PI/2, M_PI, 3*M_PI/4, -2.5f,
+                              1000.0f, -7000.5f, 1e6f};
+    for ( float angle = -10.0f; angle < 10.0f; angle += 0.01f )
+    {
+        angles.push_back(angle);
+    }
+    std::vector<float> sin_values, cos_values;
+    Utils::calcSinCos(angles, sin_values, cos_values);
+    ASSERT_EQ(sin_values.size(), angles.size());
+    ASSERT_EQ(cos_values.size(), angles.size());
+    for ( size_t i = 0; i < angles.size(); i++ )
+    {
+        EXPECT_NEAR(sin_values[i], std::sin(angles[i]), 1e-6f);
+        EXPECT_NEAR(cos_values[i], std::cos(angles[i]), 1e-6f);
+    }
+}
+
+TEST(UtilsTest, calcTrajectory)
+{
+    std::vector<Velocity2D> vels{Velocity2D(1.0f, 0.0f, 0.0f),
+                                 Velocity2D(0.5f, 0.2f, 1.0f),
+                                 Velocity2D(0.3f, 0.0f, -2.5f),
+                                 Velocity2D(0.0f, 0.0f, 1e-8f),
+                                 Velocity2D(0.0f, 0.0f, 0.0f)};
+    const size_t num_of_poses = 50;
+    const float future_time = 3.0f;
+    std::vector<float> xs, ys, thetas;
+    Utils::calcTrajectories(vels, num_of_poses, future_time, xs, ys, thetas);
+    ASSERT_EQ(xs.size(), vels.size() * (num_of_poses + 1));
+    ASSERT_EQ(ys.size(), xs.size());
+    ASSERT_EQ(thetas.size(), xs.size());
+
+    for ( size_t i = 0; i < vels.size(); i++ )
+    {
+        std::vector<Pose2D> traj = Utils::calcTrajectory(vels[i], num_of_poses, future_time);
+        ASSERT_EQ(traj.size(), num_of_poses + 1);
+
+        /* reference: repeated multiplication of per step transformation */
+        TransformMatrix2D vel_tf_mat(vels[i] * (future_time/num_of_poses));
+        TransformMatrix2D pos_mat;
+        for ( size_t k = 0; k <= num_of_poses; k++ )
+        {
+            const Pose2D expected_pose = pos_mat.asPose2D();
+            EXPECT_NEAR(traj[k].x, expected_pose.x, 1e-4f);
+            EXPECT_NEAR(traj[k].y, expected_pose.y, 1e-4f);
+            EXPECT_NEAR(std::fabs(Utils::calcShortestAngle(traj[k].theta,
+                        expected_pose.theta)), 0.0f, 1e-4f);
+
+            const size_t index = (i * (num_of_poses + 1)) + k;
+            EXPECT_FLOAT_EQ(xs[index], traj[k].x);
+            EXPECT_FLOAT_EQ(ys[index], traj[k].y);
+            EXPECT_FLOAT_EQ(thetas[index], traj[k].theta);
+            pos_mat *= vel_tf_mat;
+        }
+    }
+
+    /* full circle ends at the start */
+    std::vector<Pose2D> circle = Utils::calcTrajectory(
+            Velocity2D(1.0f, 0.0f, 2*M_PI), 100, 1.0f);
+    EXPECT_NEAR(circle.back().x, 0.0f, 1e-5f);
+    EXPECT_NEAR(circle.back().y, 0.0f, 1e-5f);
+    EXPECT_EQ(Utils::calcTrajectory(Velocity2D(1.0f, 0.0f, 0.0f), 0, 1.0f).size(), 1u);
+}
+
+TEST(UtilsTest, simplifyDouglasPeucker)
+{
+    /* noisy L shape with long collinear legs */
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+    PointVec2D points;
+    for ( size_t i = 0; i <= 1000; i++ )
+    {
+        points.push_back(Point2D(i * 0.01f, noise(gen)));
+    }
+    for ( size_t i = 1; i <= 1000; i++ )
+    {
+        points.push_back(Point2D(10.0f + noise(gen), i * 0.01f));
+    }
+
+    PointVec2D simplified_points = Utils::simplifyDouglasPeucker(points, 0.05f);
+    EXPECT_LT(simplified_points.size(), 10u);
+    EXPECT_EQ(simplified_points.front(), points.front());
+    EXPECT_EQ(simplified_points.back(), points.back());
+    for ( const Point2D& point : points )
+    {
+        float min_dist = std::numeric_limits<float>::max();
+        for ( size_t i = 0; i+1 < simplified_points.size(); i++ )
+        {
+            min_dist = std::min(min_dist, LineSegment2D(
+                        simplified_points[i], simplified_points[i+1]).minDistTo(point));
+        }
+        EXPECT_LE(min_dist, 0.05f + 1e-5f);
+    }
+
+    EXPECT_EQ(Utils::simplifyDouglasPeucker(points, 0.0f).size(), points.size());
+    std::vector<Pose2D> path{Pose2D(0.0f, 0.0f, 0.0f), Pose2D(1.0f, 0.0f, 0.0f),
+                             Pose2D(2.0f, 0.0f, 1.0f), Pose2D(2.0f, 1.0f, 1.0f)};
+    std::vector<Pose2D> simplified_path = Utils::simplifyDouglasPeucker(path, 0.01f);
+    ASSERT_EQ(simplified_path.size(), 3u);
+    EXPECT_EQ(simplified_path[1], path[2]);
+}
+
+TEST(UtilsTest, simplifyVisvalingamWhyatt)
+{
+    PointVec2D points{Point2D(0.0f, 0.0f), Point2D(1.0f, 0.01f),
+                      Point2D(2.0f, 0.0f), Point2D(3.0f, 1.0f),
+                      Point2D(4.0f, 0.5f), Point2D(5.0f, 0.0f)};
+    PointVec2D simplified_points = Utils::simplifyVisvalingamWhyatt(points, 0.1f);
+    ASSERT_EQ(simplified_points.size(), 4u);
+    EXPECT_EQ(simplified_points[0], points[0]);
+    EXPECT_EQ(simplified_points[1], points[2]);
+    EXPECT_EQ(simplified_points[2], points[3]);
+    EXPECT_EQ(simplified_points[3], points[5]);
+    EXPECT_EQ(Utils::simplifyVisvalingamWhyatt(points, 100.0f).size(), 2u);
+
+    /* closed chains keep at least a triangle */
+    PointVec2D square{Point2D(0.0f, 0.0f), Point2D(0.5f, 0.0f), Point2D(1.0f, 0.0f),
+                      Point2D(1.0f, 1.0f), Point2D(0.0f, 1.0f)};
+    simplified_points = Utils::simplifyVisvalingamWhyatt(square, 0.01f, true);
+    EXPECT_EQ(simplified_points.size(), 4u);
+    EXPECT_EQ(Utils::simplifyVisvalingamWhyatt(square, 100.0f, true).size(), 3u);
+}
+
+TEST(UtilsTest, convertToPointCloud3D)
+{
+    /* organised 7x5 cloud with x, y, z and padding */
+    sensor_msgs::PointCloud2 cloud_msg;
+    cloud_msg.height = 5;
+    cloud_msg.width = 7;
+    cloud_msg.point_step = 16;
+    cloud_msg.row_step = cloud_msg.width * cloud_msg.point_step;
+    const std::string names[3] = {"x", "y", "z"};
+    for ( size_t i = 0; i < 3; i++ )
+    {
+        sensor_msgs::PointField field;
+        field.name = names[i];
+        field.offset = i * sizeof(float);
+        field.datatype = sensor_msgs::PointField::FLOAT32;
+        field.count = 1;
+        cloud_msg.fields.push_back(field);
+    }
+    cloud_msg.data.resize(cloud_msg.height * cloud_msg.row_step);
+    for ( size_t i = 0; i < cloud_msg.height * cloud_msg.width; i++ )
+    {
+        float xyz[3] = {static_cast<float>(i), -static_cast<float>(i), 0.5f};
+        if ( i % 4 == 1 )
+        {
+            xyz[i % 3] = std::numeric_limits<float>::quiet_NaN();
+        }
+        std::memcpy(&cloud_msg.data[i * cloud_msg.point_step], xyz, sizeof(xyz));
+    }
+
+    /* same data but not decodable by the fast path */
+    sensor_msgs::PointCloud2 generic_cloud_msg = cloud_msg;
+    generic_cloud_msg.fields[0].datatype = sensor_msgs::PointField::FLOAT64;
+
+    for ( size_t row_factor = 1; row_factor <= 3; row_factor++ )
+    {
+        for ( size_t col_factor = 1; col_factor <= 3; col_factor++ )
+        {
+            PointCloud3D points;
+            std::vector<size_t> indices;
+            Utils::convertToPointCloud3D(cloud_msg, points, indices,
+                                         row_factor, col_factor);
+            PointCloud3D generic_points;
+            std::vector<size_t> generic_indices;
+            Utils::convertToPointCloud3D(generic_cloud_msg, generic_points,
+                                         generic_indices, row_factor, col_factor);
+
+            std::vector<size_t> expected_indices;
+            for ( size_t row = 0; row < cloud_msg.height; row += row_factor )
+            {
+                for ( size_t col = 0; col < cloud_msg.width; col += col_factor )
+                {
+                    const size_t index = (row * cloud_msg.width) + col;
+                    if ( index % 4 != 1 )
+                    {
+                        expected_indices.push_back(index);
+                    }
+                }
+            }
+            EXPECT_EQ(indices, expected_indices);
+            EXPECT_EQ(generic_indices, expected_indices);
+            ASSERT_EQ(points.size(), expected_indices.size());
+            ASSERT_EQ(generic_points.size(), expected_indices.size());
+            for ( size_t i = 0; i < points.size(); i++ )
+            {
+                const float value = expected_indices[i];
+                EXPECT_EQ(points[i], Point3D(value, -value, 0.5f));
+                EXPECT_EQ(generic_points[i], points[i]);
+            }
+            EXPECT_EQ(Utils::convertToPointCloud3D(cloud_msg, row_factor, col_factor).size(),
+                      points.size());
+        }
+    }
+}
+
+TEST(UtilsTest, convertToROSPointCloud2)
+{
+    PointCloud3D points;
+    std::vector<float> intensities;
+    for ( size_t i = 0; i < 10; i++ )
+    {
+        points.push_back(Point3D(0.1f * i, -0.2f * i, 0.3f * i));
+        intensities.push_back(10.0f * i);
+    }
+
+    sensor_msgs::PointCloud2 cloud_msg;
+    EXPECT_FALSE(Utils::convertToROSPointCloud2(points, cloud_msg, "map",
+                 {"intensity"}, {std::vector<float>(3)}));
+    EXPECT_EQ(cloud_msg.width, 0u);
+
+    EXPECT_TRUE(Utils::convertToROSPointCloud2(points, cloud_msg, "map",
+                {"intensity"}, {intensities}));
+    EXPECT_EQ(cloud_msg.header.frame_id, "map");
+    EXPECT_EQ(cloud_msg.height, 1u);
+    EXPECT_EQ(cloud_msg.width, points.size());
+    ASSERT_EQ(cloud_msg.fields.size(), 4u);
+    EXPECT_EQ(cloud_msg.fields[3].name, "intensity");
+    EXPECT_EQ(cloud_msg.point_step, 16u);
+    EXPECT_TRUE(cloud_msg.is_dense);
+    EXPECT_EQ(Utils::convertToPointCloud3D(cloud_msg), points);
+    sensor_msgs::PointCloud2ConstIterator<float> iter_i(cloud_msg, "intensity");
+    for ( size_t i = 0; i < intensities.size(); i++, ++iter_i )
+    {
+        EXPECT_FLOAT_EQ(*iter_i, intensities[i]);
+    }
+
+    /* reuse message for a smaller 2D cloud without channels */
+    PointCloud2D points_2d = {Point2D(1.0f, 2.0f), Point2D(3.0f, 4.0f)};
+    EXPECT_TRUE(Utils::convertToROSPointCloud2(points_2d, cloud_msg));
+    EXPECT_EQ(cloud_msg.fields.size(), 3u);
+    EXPECT_EQ(cloud_msg.data.size(), 2 * 12u);
+    const PointCloud3D points_3d = Utils::convertToPointCloud3D(cloud_msg);
+    ASSERT_EQ(points_3d.size(), 2u);
+    EXPECT_EQ(points_3d[1], Point3D(3.0f, 4.0f, 0.0f));
+}
+
+TEST(UtilsTest, convertToROSPath)
+{
+    std::vector<Pose2D> trajectory;
+    for ( size_t i = 0; i < 20; i++ )
+    {
+        trajectory.push_back(Pose2D(0.1f * i, -0.2f * i, 0.3f * i - 3.0f));
+    }
+
+    nav_msgs::Path path_msg;
+    Utils::convertToROSPath(trajectory, path_msg, "odom");
+    EXPECT_EQ(path_msg.header.frame_id, "odom");
+    ASSERT_EQ(path_msg.poses.size(), trajectory.size());
+    for ( size_t i = 0; i < trajectory.size(); i++ )
+    {
+        EXPECT_EQ(path_msg.poses[i].header.frame_id, "odom");
+        EXPECT_EQ(Pose2D(path_msg.poses[i]), trajectory[i]);
+    }
+
+    /* reuse message for a shorter trajectory */
+    trajectory.resize(5);
+    Utils::convertToROSPath(trajectory, path_msg, "map");
+    EXPECT_EQ(path_msg.poses.size(), 5u);
+    EXPECT_EQ(path_msg.poses[4].header.frame_id, "map");
+    EXPECT_EQ(Utils::convertToROSPath(trajectory, "map").poses.size(), 5u);
+}
+
+TEST(UtilsTest, convertPolylinesToMarker)
+{
+    std::vector<PointVec2D> polylines(3);
+    polylines[0] = {Point2D(0.0f, 0.0f), Point2D(1.0f, 0.0f), Point2D(1.0f, 1.0f)};
+    polylines[1] = {Point2D(5.0f, 5.0f)};
+    polylines[2] = {Point2D(2.0f, 0.0f), Point2D(3.0f, 0.0f)};
+
+    visualization_msgs::Marker marker;
+    Utils::convertPolylinesToMarker(polylines, marker, "map", 0.0f, 1.0f);
+    EXPECT_EQ(marker.type, visualization_msgs::Marker::LINE_LIST);
+    EXPECT_EQ(marker.header.frame_id, "map");
+    EXPECT_FLOAT_EQ(marker.color.g, 1.0f);
+    ASSERT_EQ(marker.points.size(), 6u);
+    EXPECT_EQ(Point2D(marker.points[1]), Point2D(1.0f, 0.0f));
+    EXPECT_EQ(Point2D(marker.points[2]), Point2D(1.0f, 0.0f));
+    EXPECT_EQ(Point2D(marker.points[3]), Point2D(1.0f, 1.0f));
+    EXPECT_EQ(Point2D(marker.points[5]), Point2D(3.0f, 0.0f));
+
+    PointCloud3D cloud{Point3D(1.0f, 2.0f, 3.0f), Point3D(4.0f, 5.0f, 6.0f)};
+    Utils::convertPointCloudToMarker(cloud, marker, "base_link", 0.1f);
+    EXPECT_EQ(marker.type, visualization_msgs::Marker::POINTS);
+    EXPECT_FLOAT_EQ(marker.scale.y, 0.1f);
+    ASSERT_EQ(marker.points.size(), 2u);
+    EXPECT_FLOAT_EQ(marker.points[1].z, 6.0f);
+    EXPECT_EQ(Utils::convertPointCloudToMarker(cloud).points.size(), 2u);
+}
+
 TEST(UtilsTest, calcAngleBetweenPoints)
 {
     Point2D a(0.0f, 0.0f);
@@ -167,6 +472,12 @@ TEST(UtilsTest, pascalTriangleCoeff)
               std::vector<unsigned int>({1, 2, 1}));
     EXPECT_EQ(Utils::calcPascalTriangleRowCoefficients(3),
               std::vector<unsigned int>({1, 3, 3, 1}));
+    std::vector<unsigned int> coefficients = Utils::calcPascalTriangleRowCoefficients(33);
+    EXPECT_EQ(coefficients[16], 1166803110u);
+    EXPECT_EQ(coefficients[32], 33u);
+    coefficients = Utils::calcPascalTriangleRowCoefficients(34);
+    EXPECT_EQ(coefficients[17], 2333606220u);
+    EXPECT_EQ(coefficients[34], 1u);
 }
 
 TEST(UtilsTest, splineCurvePoint)
@@ -230,3 +541,113 @@ TEST(UtilsTest, regression)
     EXPECT_EQ(l.start, Point2D(0.5f, 0.0f));
     EXPECT_EQ(l.end, Point2D(0.5f, 5.0f));
 }
+
+bool doPolylinesIntersectBF(const PointVec2D& a, const PointVec2D& b,
+                            bool is_a_closed, bool is_b_closed)
+{
+    size_t num_of_segments_a = ( is_a_closed ) ? a.size() : a.size() - 1;
+    size_t num_of_segments_b = ( is_b_closed ) ? b.size() : b.size() - 1;
+    for ( size_t i = 0; i < num_of_segments_a; i++ )
+    {
+        LineSegment2D segment_a(a[i], a[(i + 1) % a.size()]);
+        for ( size_t j = 0; j < num_of_segments_b; j++ )
+        {
+            if ( segment_a.intersects(LineSegment2D(b[j], b[(j + 1) % b.size()])) )
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+PointVec2D createRandomWalk(std::mt19937& generator, const Point2D& start,
+                            size_t num_of_points, float step)
+{
+    std::uniform_real_distribution<float> offset(-step, step);
+    std::uniform_int_distribution<int> snap(0, 9);
+    PointVec2D vertices{start};
+    for ( size_t i = 1; i < num_of_points; i++ )
+    {
+        Point2D next = vertices.back() + Point2D(offset(generator), offset(generator));
+        if ( snap(generator) == 0 )
+        {
+            next.x = vertices.back().x; // axis aligned segments
+        }
+        if ( snap(generator) == 0 )
+        {
+            next = vertices.back(); // repeated points
+        }
+        vertices.push_back(next);
+    }
+    return vertices;
+}
+
+TEST(UtilsTest, doPolylinesIntersect)
+{
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    for ( size_t i = 0; i < 200; i++ )
+    {
+        PointVec2D a = createRandomWalk(generator,
+                Point2D(position(generator), position(generator)), 60, 2.0f);
+        PointVec2D b = createRandomWalk(generator,
+                Point2D(position(generator), position(generator)), 40, 2.0f);
+        for ( size_t closed = 0; closed < 4; closed++ )
+        {
+            bool is_a_closed = ( closed & 1 );
+            bool is_b_closed = ( closed & 2 );
+            EXPECT_EQ(Utils::doPolylinesIntersect(a, b, is_a_closed, is_b_closed),
+                      doPolylinesIntersectBF(a, b, is_a_closed, is_b_closed));
+        }
+    }
+
+    /* touching at a shared vertex */
+    PointVec2D zigzag, line;
+    for ( size_t i = 0; i < 50; i++ )
+    {
+        zigzag.push_back(Point2D(i, i % 2));
+        line.push_back(Point2D(i, -1.0f));
+    }
+    EXPECT_FALSE(Utils::doPolylinesIntersect(zigzag, line));
+    line[24].y = 0.0f;
+    EXPECT_TRUE(Utils::doPolylinesIntersect(zigzag, line));
+}
+
+TEST(UtilsTest, calcPolylineIntersections)
+{
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> position(-20.0f, 20.0f);
+    std::vector<std::pair<size_t, size_t>> segment_ids;
+    PointVec2D intersection_pts;
+    for ( size_t i = 0; i < 50; i++ )
+    {
+        PointVec2D a = createRandomWalk(generator,
+                Point2D(position(generator), position(generator)), 80, 3.0f);
+        PointVec2D b = createRandomWalk(generator,
+                Point2D(position(generator), position(generator)), 20, 3.0f);
+        Utils::calcPolylineIntersections(a, b, segment_ids, intersection_pts, true, false);
+
+        std::vector<std::pair<size_t, size_t>> expected_segment_ids;
+        for ( size_t j = 0; j < a.size(); j++ )
+        {
+            LineSegment2D segment_a(a[j], a[(j + 1) % a.size()]);
+            for ( size_t k = 0; k + 1 < b.size(); k++ )
+            {
+                Point2D pt;
+                if ( segment_a.calcIntersectionPointWith(LineSegment2D(b[k], b[k+1]), pt) )
+                {
+                    expected_segment_ids.push_back(std::make_pair(j, k));
+                }
+            }
+        }
+        ASSERT_EQ(segment_ids, expected_segment_ids);
+        ASSERT_EQ(intersection_pts.size(), segment_ids.size());
+        for ( size_t j = 0; j < segment_ids.size(); j++ )
+        {
+            LineSegment2D segment_a(a[segment_ids[j].first],
+                                    a[(segment_ids[j].first + 1) % a.size()]);
+            EXPECT_TRUE(segment_a.containsPoint(intersection_pts[j], 1e-2f));
+        }
+    }
+}